@@ -0,0 +1,443 @@
+#ifndef ESPEASY_CACHE_READER_H
+#define ESPEASY_CACHE_READER_H
+
+/*********************************************************************************************\
+* Host side reader for the binary files written by the Cache Controller (C016)
+*
+* Header only, no dependencies besides the C++11 standard library.
+* Supports:
+*   - Uncompressed cache_N.bin files (array of C016_binary_element)
+*   - Compressed cache files (FEATURE_RTC_CACHE_COMPRESSION)
+*   - .tar files as created by TarStream (e.g. a backup downloaded from the file browser)
+*
+* The layout and compressed format must match:
+*   src/src/ControllerQueue/C016_queue_element.h
+*   src/src/DataStructs/ESPEasyControllerCache_Compression.h
+\*********************************************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace ESPEasyCache {
+
+#define ESPEASY_CACHE_VARS_PER_TASK             4
+#define ESPEASY_CACHE_COMPRESSED_HEADER_SIZE    8
+#define ESPEASY_CACHE_BLOCK_HEADER_SIZE         3
+#define ESPEASY_CACHE_FLAG_META                 0x01
+#define ESPEASY_CACHE_TAR_BLOCK_SIZE            512
+
+// Same layout as C016_binary_element on the ESP (unsigned long is 32 bit there)
+struct C016_binary_element {
+  uint8_t  values[ESPEASY_CACHE_VARS_PER_TASK * sizeof(float)];
+  uint32_t unixTime;
+  uint8_t  TaskIndex;
+  uint8_t  pluginID;
+  uint8_t  sensorType;
+  uint8_t  valueCount;
+};
+
+static_assert(sizeof(C016_binary_element) == 24u, "Layout must match C016_binary_element");
+
+// Values of Sensor_VType, see src/src/DataTypes/SensorVType.h
+enum class Sensor_VType : uint8_t {
+  SENSOR_TYPE_NONE          = 0,
+  SENSOR_TYPE_ULONG         = 20,
+  SENSOR_TYPE_STRING        = 22,
+  SENSOR_TYPE_UINT32_DUAL   = 31,
+  SENSOR_TYPE_UINT32_TRIPLE = 32,
+  SENSOR_TYPE_UINT32_QUAD   = 33,
+  SENSOR_TYPE_INT32_SINGLE  = 40,
+  SENSOR_TYPE_INT32_QUAD    = 43,
+  SENSOR_TYPE_UINT64_SINGLE = 50,
+  SENSOR_TYPE_UINT64_DUAL   = 51,
+  SENSOR_TYPE_INT64_SINGLE  = 60,
+  SENSOR_TYPE_INT64_DUAL    = 61,
+  SENSOR_TYPE_DOUBLE_SINGLE = 70,
+  SENSOR_TYPE_DOUBLE_DUAL   = 71
+};
+
+struct CacheFile {
+  std::string          name;
+  int                  fileNr = -1;
+  std::vector<uint8_t> data;
+};
+
+
+// Return the number N of a file named cache_N.bin, or -1 when it is no cache file.
+inline int getCacheFileNr(const std::string& name)
+{
+  const size_t slash = name.find_last_of('/');
+  const std::string basename = (slash == std::string::npos) ? name : name.substr(slash + 1);
+
+  int  fileNr = -1;
+  char tail[8]{};
+
+  if ((std::sscanf(basename.c_str(), "cache_%d.%7s", &fileNr, tail) != 2) ||
+      (std::strcmp(tail, "bin") != 0)) {
+    return -1;
+  }
+  return fileNr;
+}
+
+inline bool readFile(const std::string& fileName, std::vector<uint8_t>& data)
+{
+  FILE *f = std::fopen(fileName.c_str(), "rb");
+
+  if (f == nullptr) {
+    return false;
+  }
+  data.clear();
+  uint8_t buffer[65536];
+  size_t  bytesRead = 0;
+
+  while ((bytesRead = std::fread(buffer, 1, sizeof(buffer), f)) > 0) {
+    data.insert(data.end(), buffer, buffer + bytesRead);
+  }
+  const bool success = !std::ferror(f);
+  std::fclose(f);
+  return success;
+}
+
+// Extract all cache files from a (ustar) tar archive.
+inline bool readCacheFilesFromTar(const std::vector<uint8_t>& tar, std::vector<CacheFile>& files)
+{
+  size_t pos = 0;
+
+  while ((pos + ESPEASY_CACHE_TAR_BLOCK_SIZE) <= tar.size()) {
+    const uint8_t *header = &tar[pos];
+
+    if (header[0] == 0) {
+      // End of archive
+      return true;
+    }
+    std::string name(reinterpret_cast<const char *>(header), strnlen(reinterpret_cast<const char *>(header), 100));
+    const std::string prefix(reinterpret_cast<const char *>(header + 345), strnlen(reinterpret_cast<const char *>(header + 345), 155));
+
+    if (!prefix.empty()) {
+      name = prefix + '/' + name;
+    }
+    const std::string sizeField(reinterpret_cast<const char *>(header + 124), 12);
+    const size_t      size     = std::strtoul(sizeField.c_str(), nullptr, 8);
+    const char        typeflag = static_cast<char>(header[156]);
+
+    pos += ESPEASY_CACHE_TAR_BLOCK_SIZE;
+
+    if ((pos + size) > tar.size()) {
+      return false;
+    }
+
+    if (((typeflag == '0') || (typeflag == '\0')) && (getCacheFileNr(name) >= 0)) {
+      CacheFile file;
+      file.name   = name;
+      file.fileNr = getCacheFileNr(name);
+      file.data.assign(tar.begin() + pos, tar.begin() + pos + size);
+      files.push_back(std::move(file));
+    }
+    pos += ((size + ESPEASY_CACHE_TAR_BLOCK_SIZE - 1) / ESPEASY_CACHE_TAR_BLOCK_SIZE) * ESPEASY_CACHE_TAR_BLOCK_SIZE;
+  }
+  return true;
+}
+
+// Cache files must be processed in order of their file number to keep the samples in chronological order.
+inline void sortCacheFiles(std::vector<CacheFile>& files)
+{
+  std::stable_sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) {
+    return a.fileNr < b.fileNr;
+  });
+}
+
+inline bool isCompressed(const std::vector<uint8_t>& data)
+{
+  static const uint8_t header[ESPEASY_CACHE_COMPRESSED_HEADER_SIZE] = { 'C', '0', '1', '6', 'Z', 1, 0, 0 };
+
+  return data.size() >= sizeof(header) && std::memcmp(&data[0], header, sizeof(header)) == 0;
+}
+
+
+/*********************************************************************************************\
+* Decoder for compressed cache files, see ESPEasyControllerCache_Compression.h for the format.
+\*********************************************************************************************/
+class CompressedDecoder {
+public:
+
+  explicit CompressedDecoder(const std::vector<uint8_t>& data) : _data(data) {}
+
+  bool read(C016_binary_element& element) {
+    while (_samplesLeft == 0) {
+      if (!loadBlock()) {
+        return false;
+      }
+    }
+
+    if (!decodeSample(element)) {
+      // Corrupt block, continue with the next one.
+      _samplesLeft = 0;
+      _pos         = _blockEnd;
+      return false;
+    }
+    --_samplesLeft;
+    return true;
+  }
+
+private:
+
+  struct TaskState {
+    uint8_t  TaskIndex;
+    uint8_t  pluginID;
+    uint8_t  sensorType;
+    uint8_t  valueCount;
+    uint32_t values[ESPEASY_CACHE_VARS_PER_TASK];
+  };
+
+  bool loadBlock() {
+    _pos = _blockEnd;
+
+    if ((_pos + ESPEASY_CACHE_BLOCK_HEADER_SIZE) > _data.size()) {
+      return false;
+    }
+    const size_t payloadSize = _data[_pos] | (_data[_pos + 1] << 8);
+    _samplesLeft = _data[_pos + 2];
+    _pos        += ESPEASY_CACHE_BLOCK_HEADER_SIZE;
+    _blockEnd    = _pos + payloadSize;
+
+    if (_blockEnd > _data.size()) {
+      // Incomplete block
+      _samplesLeft = 0;
+      _blockEnd    = _data.size();
+      return false;
+    }
+    _unixTime = 0;
+    _taskStates.clear();
+    return true;
+  }
+
+  bool getByte(uint8_t& value) {
+    if (_pos >= _blockEnd) {
+      return false;
+    }
+    value = _data[_pos++];
+    return true;
+  }
+
+  bool decodeSample(C016_binary_element& element) {
+    uint8_t TaskIndex = 0;
+    uint8_t flags     = 0;
+
+    if (!getByte(TaskIndex) || !getByte(flags)) {
+      return false;
+    }
+    TaskState *state = nullptr;
+
+    for (size_t i = 0; i < _taskStates.size(); ++i) {
+      if (_taskStates[i].TaskIndex == TaskIndex) {
+        state = &_taskStates[i];
+      }
+    }
+
+    if (state == nullptr) {
+      if (!(flags & ESPEASY_CACHE_FLAG_META)) {
+        return false;
+      }
+      TaskState newState{};
+      newState.TaskIndex = TaskIndex;
+      _taskStates.push_back(newState);
+      state = &_taskStates.back();
+    }
+
+    uint32_t zigzag = 0;
+    uint8_t  b      = 0;
+
+    for (uint8_t shift = 0; ; shift += 7) {
+      if ((shift > 28) || !getByte(b)) {
+        return false;
+      }
+      zigzag |= static_cast<uint32_t>(b & 0x7F) << shift;
+
+      if ((b & 0x80) == 0) {
+        break;
+      }
+    }
+    _unixTime += static_cast<uint32_t>(static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1));
+
+    if (flags & ESPEASY_CACHE_FLAG_META) {
+      if (!getByte(state->pluginID) || !getByte(state->sensorType) || !getByte(state->valueCount)) {
+        return false;
+      }
+    }
+
+    for (uint8_t v = 0; v < ESPEASY_CACHE_VARS_PER_TASK; ++v) {
+      if (flags & (0x10 << v)) {
+        uint8_t control = 0;
+
+        if (!getByte(control)) {
+          return false;
+        }
+        const uint8_t leading  = control >> 4;
+        const uint8_t trailing = control & 0x0F;
+
+        if ((leading + trailing) > 3) {
+          return false;
+        }
+        uint32_t value = 0;
+
+        for (uint8_t i = trailing; i < (4 - leading); ++i) {
+          if (!getByte(b)) {
+            return false;
+          }
+          value |= static_cast<uint32_t>(b) << (8 * i);
+        }
+        state->values[v] ^= value;
+      }
+    }
+
+    element.unixTime   = _unixTime;
+    element.TaskIndex  = TaskIndex;
+    element.pluginID   = state->pluginID;
+    element.sensorType = state->sensorType;
+    element.valueCount = state->valueCount;
+    std::memcpy(element.values, state->values, sizeof(element.values));
+    return true;
+  }
+
+  const std::vector<uint8_t>& _data;
+  size_t                      _pos         = ESPEASY_CACHE_COMPRESSED_HEADER_SIZE;
+  size_t                      _blockEnd    = ESPEASY_CACHE_COMPRESSED_HEADER_SIZE;
+  uint8_t                     _samplesLeft = 0;
+  uint32_t                    _unixTime    = 0;
+  std::vector<TaskState>      _taskStates;
+};
+
+
+// Call callback(const C016_binary_element&) for every sample in the file.
+// Return the number of samples read.
+template<typename Callback>
+size_t forEachSample(const std::vector<uint8_t>& data, Callback callback)
+{
+  size_t count = 0;
+  C016_binary_element element;
+
+  if (isCompressed(data)) {
+    CompressedDecoder decoder(data);
+
+    while (decoder.read(element)) {
+      callback(element);
+      ++count;
+    }
+    return count;
+  }
+
+  for (size_t pos = 0; (pos + sizeof(element)) <= data.size(); pos += sizeof(element)) {
+    std::memcpy(&element, &data[pos], sizeof(element));
+    callback(element);
+    ++count;
+  }
+  return count;
+}
+
+
+/*********************************************************************************************\
+* Formatting of task values, following TaskValues_Data_t::getAsString()
+\*********************************************************************************************/
+inline bool isUInt32Type(uint8_t sensorType)
+{
+  return sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_ULONG) ||
+         (sensorType >= static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_UINT32_DUAL) &&
+          sensorType <= static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_UINT32_QUAD));
+}
+
+inline bool isInt32Type(uint8_t sensorType)
+{
+  return sensorType >= static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_INT32_SINGLE) &&
+         sensorType <= static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_INT32_QUAD);
+}
+
+inline bool isUInt64Type(uint8_t sensorType)
+{
+  return sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_UINT64_SINGLE) ||
+         sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_UINT64_DUAL);
+}
+
+inline bool isInt64Type(uint8_t sensorType)
+{
+  return sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_INT64_SINGLE) ||
+         sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_INT64_DUAL);
+}
+
+inline bool isDoubleType(uint8_t sensorType)
+{
+  return sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_DOUBLE_SINGLE) ||
+         sensorType == static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_DOUBLE_DUAL);
+}
+
+inline bool isFloatType(uint8_t sensorType)
+{
+  return sensorType != static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_NONE) &&
+         sensorType != static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_ULONG) &&
+         sensorType < static_cast<uint8_t>(Sensor_VType::SENSOR_TYPE_STRING);
+}
+
+// Number of values stored in a sample of the given sensor type.
+inline uint8_t getNrValues(const C016_binary_element& element)
+{
+  const bool is64bit = isUInt64Type(element.sensorType) ||
+                       isInt64Type(element.sensorType) ||
+                       isDoubleType(element.sensorType);
+  const uint8_t maxValues = is64bit ? ESPEASY_CACHE_VARS_PER_TASK / 2 : ESPEASY_CACHE_VARS_PER_TASK;
+
+  return (element.valueCount == 0 || element.valueCount > maxValues) ? maxValues : element.valueCount;
+}
+
+inline std::string formatValue(const C016_binary_element& element, uint8_t varNr)
+{
+  char buffer[32]{};
+
+  if (isUInt32Type(element.sensorType) || isInt32Type(element.sensorType)) {
+    uint32_t value{};
+    std::memcpy(&value, element.values + (varNr * sizeof(value)), sizeof(value));
+
+    if (isInt32Type(element.sensorType)) {
+      std::snprintf(buffer, sizeof(buffer), "%ld", static_cast<long>(static_cast<int32_t>(value)));
+    } else {
+      std::snprintf(buffer, sizeof(buffer), "%lu", static_cast<unsigned long>(value));
+    }
+  } else if (isUInt64Type(element.sensorType) || isInt64Type(element.sensorType)) {
+    uint64_t value{};
+    std::memcpy(&value, element.values + (varNr * sizeof(value)), sizeof(value));
+
+    if (isInt64Type(element.sensorType)) {
+      std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(static_cast<int64_t>(value)));
+    } else {
+      std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+    }
+  } else if (isDoubleType(element.sensorType)) {
+    double value{};
+    std::memcpy(&value, element.values + (varNr * sizeof(value)), sizeof(value));
+    std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+  } else if (isFloatType(element.sensorType)) {
+    float value{};
+    std::memcpy(&value, element.values + (varNr * sizeof(value)), sizeof(value));
+    std::snprintf(buffer, sizeof(buffer), "%.7g", static_cast<double>(value));
+  }
+  return buffer;
+}
+
+inline std::string formatUTC(uint32_t unixTime)
+{
+  const time_t t = static_cast<time_t>(unixTime);
+  struct tm    ts {};
+  char         buffer[24]{};
+
+  if (gmtime_r(&t, &ts) != nullptr) {
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &ts);
+  }
+  return buffer;
+}
+
+} // namespace ESPEasyCache
+
+#endif // ifndef ESPEASY_CACHE_READER_H
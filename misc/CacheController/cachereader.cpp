@@ -0,0 +1,296 @@
+/*********************************************************************************************\
+* cachereader
+* Convert Cache Controller (C016) bin files to CSV on a PC.
+*
+* Build:  g++ -std=c++11 -O2 -o cachereader cachereader.cpp
+*
+* Usage:  cachereader [options] <cache_N.bin | backup.tar> ...
+*
+* Options:
+*   -o <file>       Write output to file instead of stdout
+*   -s <separator>  Column separator: ';' (default), ',' or 'tab'
+*   --from <unix>   Only samples with a timestamp >= this UNIX timestamp
+*   --to <unix>     Only samples with a timestamp <= this UNIX timestamp
+*   --task <nr>     Only samples of this task nr (1 ... max. nr of tasks)
+*                   Task nrs in the output are also 1-based, like on the Devices page.
+*   --wide          One row per timestamp, with a column per task value.
+*                   Values of other tasks are repeated from their last sample.
+*   --no-header     Do not write the column names
+\*********************************************************************************************/
+
+#include "ESPEasyCacheReader.h"
+
+#include <cstdlib>
+#include <map>
+
+using namespace ESPEasyCache;
+
+struct Options {
+  std::string outputFile;
+  char        separator = ';';
+  uint32_t    from      = 0;
+  uint32_t    to        = 0xFFFFFFFF;
+  int         taskIndex = -1;
+  bool        wide      = false;
+  bool        header    = true;
+};
+
+class OutputBuffer {
+public:
+
+  explicit OutputBuffer(FILE *f) : _f(f) {
+    _buffer.reserve(BufferSize + 256);
+  }
+
+  ~OutputBuffer() {
+    flush();
+  }
+
+  void add(const std::string& str) {
+    _buffer += str;
+    checkFlush();
+  }
+
+  void add(char c) {
+    _buffer += c;
+    checkFlush();
+  }
+
+  void flush() {
+    if (!_buffer.empty()) {
+      std::fwrite(_buffer.data(), 1, _buffer.size(), _f);
+      _buffer.clear();
+    }
+  }
+
+private:
+
+  void checkFlush() {
+    if (_buffer.size() >= BufferSize) {
+      flush();
+    }
+  }
+
+  static const size_t BufferSize = 65536;
+  FILE               *_f;
+  std::string         _buffer;
+};
+
+static void usage()
+{
+  std::fprintf(stderr,
+               "Usage: cachereader [-o file] [-s ;|,|tab] [--from unix] [--to unix] [--task nr] [--wide] [--no-header]\n"
+               "                   <cache_N.bin | backup.tar> ...\n");
+}
+
+static bool matches(const C016_binary_element& element, const Options& options)
+{
+  return element.unixTime >= options.from &&
+         element.unixTime <= options.to &&
+         (options.taskIndex < 0 || element.TaskIndex == options.taskIndex);
+}
+
+static void writeTimestamp(OutputBuffer& out, uint32_t unixTime, char separator)
+{
+  out.add(std::to_string(unixTime));
+  out.add(separator);
+  out.add(formatUTC(unixTime));
+}
+
+// One row per sample
+static void writeSamples(const std::vector<CacheFile>& files, const Options& options, OutputBuffer& out)
+{
+  const char sep = options.separator;
+
+  if (options.header) {
+    out.add(std::string("UNIX timestamp") + sep + "UTC timestamp" + sep + "task nr" + sep + "plugin ID");
+
+    for (int v = 1; v <= ESPEASY_CACHE_VARS_PER_TASK; ++v) {
+      out.add(sep);
+      out.add("value" + std::to_string(v));
+    }
+    out.add('\n');
+  }
+
+  for (size_t f = 0; f < files.size(); ++f) {
+    forEachSample(files[f].data, [&](const C016_binary_element& element) {
+      if (!matches(element, options)) {
+        return;
+      }
+      writeTimestamp(out, element.unixTime, sep);
+      out.add(sep);
+      out.add(std::to_string(element.TaskIndex + 1));
+      out.add(sep);
+      out.add(std::to_string(element.pluginID));
+
+      const uint8_t nrValues = getNrValues(element);
+
+      for (uint8_t v = 0; v < ESPEASY_CACHE_VARS_PER_TASK; ++v) {
+        out.add(sep);
+
+        if (v < nrValues) {
+          out.add(formatValue(element, v));
+        }
+      }
+      out.add('\n');
+    });
+  }
+}
+
+// One row per timestamp, with a column per task value
+static void writeWide(const std::vector<CacheFile>& files, const Options& options, OutputBuffer& out)
+{
+  const char sep = options.separator;
+
+  // First pass to collect the tasks present, to know the columns.
+  std::map<uint8_t, std::vector<std::string> > taskValues;
+
+  for (size_t f = 0; f < files.size(); ++f) {
+    forEachSample(files[f].data, [&](const C016_binary_element& element) {
+      if (matches(element, options)) {
+        taskValues[element.TaskIndex].resize(ESPEASY_CACHE_VARS_PER_TASK);
+      }
+    });
+  }
+
+  if (options.header) {
+    out.add(std::string("UNIX timestamp") + sep + "UTC timestamp");
+
+    for (auto it = taskValues.begin(); it != taskValues.end(); ++it) {
+      for (int v = 1; v <= ESPEASY_CACHE_VARS_PER_TASK; ++v) {
+        out.add(sep);
+        out.add("task" + std::to_string(it->first + 1) + '#' + std::to_string(v));
+      }
+    }
+    out.add('\n');
+  }
+
+  bool     rowPending = false;
+  uint32_t rowTime    = 0;
+
+  auto writeRow = [&]() {
+                    writeTimestamp(out, rowTime, sep);
+
+                    for (auto it = taskValues.begin(); it != taskValues.end(); ++it) {
+                      for (size_t v = 0; v < it->second.size(); ++v) {
+                        out.add(sep);
+                        out.add(it->second[v]);
+                      }
+                    }
+                    out.add('\n');
+                  };
+
+  for (size_t f = 0; f < files.size(); ++f) {
+    forEachSample(files[f].data, [&](const C016_binary_element& element) {
+      if (!matches(element, options)) {
+        return;
+      }
+
+      if (rowPending && (element.unixTime != rowTime)) {
+        writeRow();
+      }
+      rowPending = true;
+      rowTime    = element.unixTime;
+
+      std::vector<std::string>& values = taskValues[element.TaskIndex];
+      const uint8_t nrValues           = getNrValues(element);
+
+      for (uint8_t v = 0; v < ESPEASY_CACHE_VARS_PER_TASK; ++v) {
+        values[v] = (v < nrValues) ? formatValue(element, v) : std::string();
+      }
+    });
+  }
+
+  if (rowPending) {
+    writeRow();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  Options options;
+  std::vector<std::string> inputFiles;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    const bool hasValue = (i + 1) < argc;
+
+    if ((arg == "-o") && hasValue) {
+      options.outputFile = argv[++i];
+    } else if ((arg == "-s") && hasValue) {
+      const std::string sep(argv[++i]);
+      options.separator = (sep == "tab") ? '\t' : sep[0];
+    } else if ((arg == "--from") && hasValue) {
+      options.from = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "--to") && hasValue) {
+      options.to = std::strtoul(argv[++i], nullptr, 10);
+    } else if ((arg == "--task") && hasValue) {
+      options.taskIndex = std::atoi(argv[++i]) - 1;
+    } else if (arg == "--wide") {
+      options.wide = true;
+    } else if (arg == "--no-header") {
+      options.header = false;
+    } else if ((arg.size() > 1) && (arg[0] == '-')) {
+      usage();
+      return 1;
+    } else {
+      inputFiles.push_back(arg);
+    }
+  }
+
+  if (inputFiles.empty()) {
+    usage();
+    return 1;
+  }
+
+  std::vector<CacheFile> files;
+
+  for (size_t i = 0; i < inputFiles.size(); ++i) {
+    std::vector<uint8_t> data;
+
+    if (!readFile(inputFiles[i], data)) {
+      std::fprintf(stderr, "Cannot read %s\n", inputFiles[i].c_str());
+      return 1;
+    }
+    const std::string& name = inputFiles[i];
+
+    if ((name.size() > 4) && (name.compare(name.size() - 4, 4, ".tar") == 0)) {
+      if (!readCacheFilesFromTar(data, files)) {
+        std::fprintf(stderr, "Invalid tar file %s\n", name.c_str());
+        return 1;
+      }
+    } else {
+      CacheFile file;
+      file.name   = name;
+      file.fileNr = getCacheFileNr(name);
+      file.data.swap(data);
+      files.push_back(std::move(file));
+    }
+  }
+  sortCacheFiles(files);
+
+  FILE *f = stdout;
+
+  if (!options.outputFile.empty()) {
+    f = std::fopen(options.outputFile.c_str(), "wb");
+
+    if (f == nullptr) {
+      std::fprintf(stderr, "Cannot write %s\n", options.outputFile.c_str());
+      return 1;
+    }
+  }
+  {
+    OutputBuffer out(f);
+
+    if (options.wide) {
+      writeWide(files, options, out);
+    } else {
+      writeSamples(files, options, out);
+    }
+  }
+
+  if (f != stdout) {
+    std::fclose(f);
+  }
+  return 0;
+}
@@ -0,0 +1,70 @@
+#!/bin/sh
+# Golden file tests for cachereader / ESPEasyCacheReader.h
+#
+# Builds cachereader and compares its output on the files in fixtures/
+# with the expected CSV files in expected/.
+#
+# Usage:  ./run_tests.sh [--update]
+#   --update  Overwrite the expected CSV files with the current output
+#
+# Fixtures:
+#   cache_1.bin  Uncompressed cache file
+#   cache_2.bin  Compressed cache file (2 blocks), written by the firmware encoder
+#                in src/src/DataStructs/ESPEasyControllerCache_Compression.cpp
+#   backup.tar   cache_2.bin, config.json and cache_1.bin, as downloaded from the file browser
+
+cd "$(dirname "$0")" || exit 1
+
+CXX=${CXX:-g++}
+BUILD_DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+READER="$BUILD_DIR/cachereader"
+
+if ! "$CXX" -std=c++11 -O2 -Wall -Wextra -o "$READER" ../cachereader.cpp; then
+  echo "FAIL: build cachereader"
+  exit 1
+fi
+
+UPDATE=0
+[ "$1" = "--update" ] && UPDATE=1
+
+FAILED=0
+
+# run_test <name> <cachereader arguments>
+run_test() {
+  name=$1
+  shift
+  expected="expected/$name.csv"
+  actual="$BUILD_DIR/$name.csv"
+
+  if ! "$READER" "$@" > "$actual"; then
+    echo "FAIL: $name (cachereader returned an error)"
+    FAILED=$((FAILED + 1))
+    return
+  fi
+
+  if [ $UPDATE -eq 1 ]; then
+    cp "$actual" "$expected"
+    echo "UPDATED: $name"
+  elif diff -u "$expected" "$actual"; then
+    echo "OK: $name"
+  else
+    echo "FAIL: $name"
+    FAILED=$((FAILED + 1))
+  fi
+}
+
+run_test raw          fixtures/cache_1.bin
+run_test compressed   fixtures/cache_2.bin
+run_test sorted       fixtures/cache_2.bin fixtures/cache_1.bin
+run_test tar          fixtures/backup.tar
+run_test wide         --wide -s , fixtures/backup.tar
+run_test task_filter  --task 2 -s tab --no-header fixtures/backup.tar
+run_test time_filter  --from 1700000060 --to 1700000180 fixtures/backup.tar
+
+if [ $FAILED -ne 0 ]; then
+  echo "$FAILED test(s) failed"
+  exit 1
+fi
+exit 0
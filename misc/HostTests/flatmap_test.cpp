@@ -0,0 +1,305 @@
+// Test FlatMap and FlatStringMap (src/src/DataStructs/FlatMap.h) against std::map.
+//
+// Random inserts, lookups and erases are done on both, after which the contents
+// and iteration order must be the same.
+// With --bench, the lookup time is compared with the std::map based caches they replace.
+
+#include "src/src/DataStructs/FlatMap.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+
+namespace {
+int nrFailed = 0;
+int nrTested = 0;
+
+void check(bool ok, const char *what)
+{
+  ++nrTested;
+
+  if (!ok) {
+    std::cout << "FAIL: " << what << std::endl;
+    ++nrFailed;
+  }
+}
+
+String lowerCase(const String& str)
+{
+  String res(str);
+
+  res.toLowerCase();
+  return res;
+}
+
+// Task and value names as used in the caches, in random case.
+String randomName(std::mt19937& rng)
+{
+  const char *names[] = {
+    "Temperature", "Humidity", "Pressure", "bme280", "Dallas", "Switch", "Relay",
+    "Analog", "Counter", "Total", "Time", "Energy", "Power", "Voltage", "Current", "PF"
+  };
+  String name(names[rng() % NR_ELEMENTS(names)]);
+
+  name += String(static_cast<int>(rng() % 4));
+
+  for (unsigned int i = 0; i < name.length(); ++i) {
+    if ((rng() % 2) == 0) {
+      name[i] = static_cast<char>(toupper(name[i]));
+    } else {
+      name[i] = static_cast<char>(tolower(name[i]));
+    }
+  }
+  return name;
+}
+
+void test_FlatMap()
+{
+  std::mt19937 rng(1);
+  FlatMap<uint8_t, int> flat;
+  std::map<uint8_t, int> ref;
+
+  for (int i = 0; i < 2000; ++i) {
+    const uint8_t key   = rng() % 64;
+    const int     value = static_cast<int>(rng());
+
+    switch (rng() % 3) {
+      case 0:
+      case 1:
+      {
+        const bool inserted    = flat.emplace(std::make_pair(key, value)).second;
+        const bool refInserted = ref.emplace(key, value).second;
+        check(inserted == refInserted, "FlatMap emplace: inserted");
+        break;
+      }
+      case 2:
+      {
+        auto it    = flat.find(key);
+        auto refIt = ref.find(key);
+        check((it == flat.end()) == (refIt == ref.end()), "FlatMap find: found");
+
+        if ((it != flat.end()) && (refIt != ref.end())) {
+          check(it->second == refIt->second, "FlatMap find: value");
+          flat.erase(it);
+          ref.erase(refIt);
+        }
+        break;
+      }
+    }
+  }
+
+  check(flat.size() == ref.size(), "FlatMap size");
+  auto refIt = ref.begin();
+
+  for (auto it = flat.begin(); it != flat.end() && refIt != ref.end(); ++it, ++refIt) {
+    check(it->first == refIt->first && it->second == refIt->second, "FlatMap iteration order");
+  }
+
+  for (int key = 0; key < 256; ++key) {
+    const FlatMap<uint8_t, int>& constFlat = flat;
+    check((constFlat.find(key) == constFlat.end()) == (ref.find(key) == ref.end()), "FlatMap const find");
+  }
+
+  flat.clear();
+  check(flat.empty() && flat.begin() == flat.end(), "FlatMap clear");
+}
+
+void test_FlatStringMap()
+{
+  std::mt19937 rng(2);
+  FlatStringMap<int, true> flat;
+  std::map<std::pair<uint8_t, String>, int> ref; // (group, lower case name)
+
+  for (int i = 0; i < 2000; ++i) {
+    const String  name  = randomName(rng);
+    const uint8_t group = rng() % 8;
+    const int     value = static_cast<int>(rng());
+    const auto    key   = std::make_pair(group, lowerCase(name));
+
+    switch (rng() % 4) {
+      case 0:
+      case 1:
+        // An existing entry is not replaced, like std::map::emplace
+        flat.emplace(name, value, group);
+        ref.emplace(key, value);
+        break;
+      default:
+      {
+        auto it    = flat.find(name, group);
+        auto refIt = ref.find(key);
+        check((it == flat.end()) == (refIt == ref.end()), "FlatStringMap find: found");
+
+        if ((it != flat.end()) && (refIt != ref.end())) {
+          check(it->second == refIt->second, "FlatStringMap find: value");
+          check(it->first.equalsIgnoreCase(name), "FlatStringMap find: key");
+        }
+        break;
+      }
+    }
+  }
+
+  check(flat.size() == ref.size(), "FlatStringMap size");
+
+  // Every entry can be found, in any case and only in its own group.
+  for (auto it = flat.begin(); it != flat.end(); ++it) {
+    String upper(it->first);
+    upper.toUpperCase();
+
+    auto found = flat.find(upper, it->_group);
+    check(found != flat.end() && found->second == it->second, "FlatStringMap case insensitive find");
+
+    auto refIt = ref.find(std::make_pair(it->_group, lowerCase(it->first)));
+    check(refIt != ref.end() && refIt->second == it->second, "FlatStringMap contents");
+  }
+
+  // Entries are kept sorted on hash, as needed for the binary search.
+  uint32_t prevHash = 0;
+
+  for (auto it = flat.begin(); it != flat.end(); ++it) {
+    check(it->_hash >= prevHash, "FlatStringMap ordering");
+    check(it->_hash == FlatStringMap<int, true>::computeHash(it->first, it->_group), "FlatStringMap hash");
+    prevHash = it->_hash;
+  }
+
+  // Case sensitive map
+  FlatStringMap<int> caseSensitive;
+
+  caseSensitive.emplace(String("Name"), 1);
+  caseSensitive.emplace(String("name"), 2);
+  check(caseSensitive.size() == 2, "FlatStringMap case sensitive size");
+  check(caseSensitive.find("Name")->second == 1 && caseSensitive.find("name")->second == 2, "FlatStringMap case sensitive find");
+  check(caseSensitive.find("NAME") == caseSensitive.end(), "FlatStringMap case sensitive miss");
+
+  flat.clear();
+  check(flat.empty(), "FlatStringMap clear");
+}
+
+template<typename Fn>
+double nsPerCall(Fn fn, unsigned long iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    fn(i);
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+
+void printBench(const char *what, double flatNs, double mapNs)
+{
+  char line[128];
+
+  snprintf(line, sizeof(line), "%-40s %10.1f %10.1f %7.1fx", what, flatNs, mapNs, mapNs / flatNs);
+  std::cout << line << std::endl;
+}
+
+void bench(unsigned long iterations)
+{
+  std::cout << "lookup                                   flat [ns] std::map [ns] speedup" << std::endl;
+  volatile int sink = 0;
+
+  // Cached ExtraTaskSettings per task index
+  {
+    FlatMap<uint8_t, int> flat;
+    std::map<uint8_t, int> ref;
+
+    for (uint8_t i = 0; i < 32; ++i) {
+      flat.emplace(std::make_pair(i, static_cast<int>(i)));
+      ref.emplace(i, i);
+    }
+    const double flatNs = nsPerCall([&](unsigned long i) { sink = sink + flat.find(i % 32)->second; }, iterations);
+    const double mapNs  = nsPerCall([&](unsigned long i) { sink = sink + ref.find(i % 32)->second; }, iterations);
+    printBench("task index (32 tasks)", flatNs, mapNs);
+  }
+
+  // Value names per task: FlatStringMap with task index as group,
+  // versus the former std::map with "name#task" lower case key.
+  {
+    const char *valueNames[] = { "Temperature", "Humidity", "Pressure", "Dewpoint" };
+    const size_t nrNames     = NR_ELEMENTS(valueNames);
+    FlatStringMap<uint8_t, true> flat;
+    std::map<String, uint8_t> ref;
+
+    for (uint8_t task = 0; task < 32; ++task) {
+      for (uint8_t i = 0; i < nrNames; ++i) {
+        flat.emplace(String(valueNames[i]), i, task);
+
+        String key(valueNames[i]);
+        key += '#';
+        key += static_cast<int>(task);
+        key.toLowerCase();
+        ref.emplace(key, i);
+      }
+    }
+    const String lookup[] = { "temperature", "Humidity", "PRESSURE", "DewPoint" };
+
+    const double flatNs = nsPerCall([&](unsigned long i) {
+      sink = sink + flat.find(lookup[i % nrNames], i % 32)->second;
+    }, iterations);
+    const double mapNs = nsPerCall([&](unsigned long i) {
+      String key(lookup[i % nrNames]);
+      key += '#';
+      key += static_cast<int>(i % 32);
+      key.toLowerCase();
+      sink = sink + ref.find(key)->second;
+    }, iterations);
+    printBench("value name (32 tasks x 4 values)", flatNs, mapNs);
+  }
+
+  // Task names, case insensitive, versus the former std::map with lower case key.
+  {
+    FlatStringMap<uint8_t, true> flat;
+    std::map<String, uint8_t> ref;
+    String names[32];
+
+    for (uint8_t task = 0; task < 32; ++task) {
+      names[task] = String("Sensor_");
+      names[task] += static_cast<int>(task);
+      flat.emplace(names[task], task);
+      ref.emplace(lowerCase(names[task]), task);
+    }
+
+    const double flatNs = nsPerCall([&](unsigned long i) {
+      sink = sink + flat.find(names[i % 32])->second;
+    }, iterations);
+    const double mapNs = nsPerCall([&](unsigned long i) {
+      String key(names[i % 32]);
+      key.toLowerCase();
+      sink = sink + ref.find(key)->second;
+    }, iterations);
+    printBench("task name (32 tasks)", flatNs, mapNs);
+  }
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  bool runBench            = false;
+  unsigned long iterations = 1000000;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      runBench = true;
+
+      if (((i + 1) < argc) && (atol(argv[i + 1]) > 0)) {
+        iterations = atol(argv[++i]);
+      }
+    }
+  }
+
+  test_FlatMap();
+  test_FlatStringMap();
+
+  std::cout << (nrFailed == 0 ? "OK" : "FAIL") << ": flatmap "
+            << nrTested - nrFailed << "/" << nrTested << " checks passed" << std::endl;
+
+  if (runBench) {
+    bench(iterations);
+  }
+  return nrFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,192 @@
+// Compare the text based rules calculation (RulesCalculate_t::doCalculate) with
+// the compiled RPN program used for task value formulas (RulesCalculate_t::execute).
+//
+// Both must give exactly the same result for typical formulas and sample values.
+// With --bench, the time per evaluation of both paths is measured as well.
+//
+// The text path is done the same way as in UserVarStruct::applyFormula():
+// replace %value% and %pvalue% in the preprocessed formula, then call doCalculate().
+// The compiled path as in UserVarStruct::getCompiledFormula() and applyFormula().
+
+#include "src/src/Helpers/Rules_calculate.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+const char *formulas[] = {
+  "%value%/10",
+  "%value%*1.8+32",
+  "(%value%-%pvalue%)*60",
+  "round(%value%*100)/100",
+  "sqrt(%value%)",
+  "%value%^2+3*%value%-1",
+  "map(%value%:0:1023:0:100)",
+  "mapc(%value%:100:1000:0:100)",
+  "abs(%value%-50)",
+  "sin_d(%value%)*10",
+  "log(%value%+1)",
+  "!%value%",
+  "(%value%+%pvalue%)/2",
+  "-%value%+100",
+  "%value%/(%pvalue%-%pvalue%)"
+};
+
+const char *values[] = {
+  "0",
+  "1",
+  "21.5",
+  "1023",
+  "3.14159",
+  "100.25",
+  "999999",
+  "0.001"
+};
+
+const char *prevValue = "20.25";
+
+RulesCalculate_t calc;
+
+String replaceSlots(const String& preprocessed, const String& value, const String& pvalue)
+{
+  String formula(preprocessed);
+
+  formula.replace(F("%value%"),  value);
+  formula.replace(F("%pvalue%"), pvalue);
+  return formula;
+}
+
+bool sameResult(ESPEASY_RULES_FLOAT_TYPE a, ESPEASY_RULES_FLOAT_TYPE b)
+{
+  if (std::isnan(a) || std::isnan(b)) {
+    return std::isnan(a) && std::isnan(b);
+  }
+  return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+template<typename Fn>
+double nsPerCall(Fn fn, unsigned long iterations)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  for (unsigned long i = 0; i < iterations; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+}
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  bool bench                = false;
+  unsigned long iterations  = 200000;
+
+  for (int i = 1; i < argc; ++i) {
+    if (strcmp(argv[i], "--bench") == 0) {
+      bench = true;
+
+      if (((i + 1) < argc) && (atol(argv[i + 1]) > 0)) {
+        iterations = atol(argv[++i]);
+      }
+    }
+  }
+
+  int nrFailed = 0;
+  int nrTested = 0;
+
+  for (const char *formula : formulas) {
+    const String preprocessed = RulesCalculate_t::preProces(formula);
+
+    RulesCalculate_program program;
+    calc.compile(replaceSlots(preprocessed, String(RULES_CALCULATE_SLOT_VALUE), String(RULES_CALCULATE_SLOT_PVALUE)), program);
+
+    if (!program.isCompiled) {
+      std::cout << "FAIL: formula not compiled: " << formula << std::endl;
+      ++nrFailed;
+      continue;
+    }
+
+    for (const char *value : values) {
+      ESPEASY_RULES_FLOAT_TYPE slots[RULES_CALCULATE_NR_SLOTS]{};
+
+      if (!RulesCalculate_t::bindSlotValue(value, slots[0]) ||
+          !RulesCalculate_t::bindSlotValue(prevValue, slots[1])) {
+        std::cout << "FAIL: cannot bind value " << value << std::endl;
+        ++nrFailed;
+        continue;
+      }
+      const String text = replaceSlots(preprocessed, value, prevValue);
+
+      ESPEASY_RULES_FLOAT_TYPE textResult{};
+      ESPEASY_RULES_FLOAT_TYPE compiledResult{};
+      const CalculateReturnCode textCode     = calc.doCalculate(text.c_str(), &textResult);
+      const CalculateReturnCode compiledCode = calc.execute(program, slots, &compiledResult);
+
+      ++nrTested;
+
+      if ((textCode != compiledCode) ||
+          (!isError(textCode) && !sameResult(textResult, compiledResult))) {
+        std::cout << "FAIL: " << formula << " value " << value
+                  << ": text " << textResult << " (" << static_cast<int>(textCode) << ")"
+                  << ", compiled " << compiledResult << " (" << static_cast<int>(compiledCode) << ")"
+                  << std::endl;
+        ++nrFailed;
+      }
+    }
+  }
+
+  // Values which are not plain non-negative decimals must use the text path.
+  {
+    const char *textOnly[] = { "-5", "1e3", "0x10", "", "abc", "1.2.3" };
+
+    for (const char *value : textOnly) {
+      ESPEASY_RULES_FLOAT_TYPE slot{};
+      ++nrTested;
+
+      if (RulesCalculate_t::bindSlotValue(value, slot)) {
+        std::cout << "FAIL: value should not be bound: \"" << value << "\"" << std::endl;
+        ++nrFailed;
+      }
+    }
+  }
+
+  std::cout << (nrFailed == 0 ? "OK" : "FAIL") << ": rules_calculate "
+            << nrTested - nrFailed << "/" << nrTested << " compiled results equal to text results" << std::endl;
+
+  if (bench) {
+    std::cout << "formula                         text [ns]  compiled [ns]  speedup" << std::endl;
+
+    for (const char *formula : formulas) {
+      const String preprocessed = RulesCalculate_t::preProces(formula);
+      RulesCalculate_program program;
+      calc.compile(replaceSlots(preprocessed, String(RULES_CALCULATE_SLOT_VALUE), String(RULES_CALCULATE_SLOT_PVALUE)), program);
+
+      const String value(values[2]);
+      const String pvalue(prevValue);
+      ESPEASY_RULES_FLOAT_TYPE result{};
+      volatile ESPEASY_RULES_FLOAT_TYPE sink{};
+
+      const double textNs = nsPerCall([&]() {
+        const String text = replaceSlots(preprocessed, value, pvalue);
+        calc.doCalculate(text.c_str(), &result);
+        sink = result;
+      }, iterations);
+
+      const double compiledNs = nsPerCall([&]() {
+        ESPEASY_RULES_FLOAT_TYPE slots[RULES_CALCULATE_NR_SLOTS]{};
+        RulesCalculate_t::bindSlotValue(value, slots[0]);
+        RulesCalculate_t::bindSlotValue(pvalue, slots[1]);
+        calc.execute(program, slots, &result);
+        sink = result;
+      }, iterations);
+
+      char line[128];
+      snprintf(line, sizeof(line), "%-30s %10.1f %14.1f %7.1fx", formula, textNs, compiledNs, textNs / compiledNs);
+      std::cout << line << std::endl;
+    }
+  }
+  return nrFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,69 @@
+#!/bin/sh
+# Host tests for ESPEasy sources which do not depend on the hardware.
+#
+# The sources under test are copied from src/ into a build directory,
+# next to minimal replacements (shim/) for ESPEasy_common.h, Arduino.h
+# and the parts of the firmware they depend on, and built with the host compiler.
+#
+# Usage:  ./run_tests.sh [--bench [iterations]]
+#   --bench  Also run the benchmarks
+
+cd "$(dirname "$0")" || exit 1
+
+CXX=${CXX:-g++}
+BUILD_DIR=$(mktemp -d) || exit 1
+trap 'rm -rf "$BUILD_DIR"' EXIT
+
+FIRMWARE_DIR=../../src
+# Like the Arduino build, ESPEasy_common.h (shim) is included first in every file
+CXXFLAGS="-std=c++11 -O2 -Wall -Wextra -I$BUILD_DIR/include -include $BUILD_DIR/src/ESPEasy_common.h"
+
+cp -R shim/. "$BUILD_DIR/" || exit 1
+
+BENCH_ARGS=""
+[ "$1" = "--bench" ] && BENCH_ARGS="$*"
+
+FAILED=0
+
+# run_test <name> <firmware sources, relative to src/>
+run_test() {
+  name=$1
+  shift
+  sources=""
+
+  for file in "$@"; do
+    mkdir -p "$BUILD_DIR/src/$(dirname "$file")"
+    cp "$FIRMWARE_DIR/$file" "$BUILD_DIR/src/$file" || exit 1
+
+    case "$file" in
+      *.cpp) sources="$sources $BUILD_DIR/src/$file" ;;
+    esac
+  done
+  cp "$name.cpp" "$BUILD_DIR/" || exit 1
+
+  # shellcheck disable=SC2086
+  if ! "$CXX" $CXXFLAGS -o "$BUILD_DIR/$name" "$BUILD_DIR/$name.cpp" $sources; then
+    echo "FAIL: build $name"
+    FAILED=$((FAILED + 1))
+    return
+  fi
+
+  # shellcheck disable=SC2086
+  if ! "$BUILD_DIR/$name" $BENCH_ARGS; then
+    FAILED=$((FAILED + 1))
+  fi
+}
+
+run_test rules_calculate_test \
+  src/Helpers/Rules_calculate.h src/Helpers/Rules_calculate.cpp \
+  src/Helpers/Numerical.h src/Helpers/Numerical.cpp \
+  src/Helpers/ESPEasy_math.h src/Helpers/ESPEasy_math.cpp
+
+run_test flatmap_test \
+  src/DataStructs/FlatMap.h
+
+if [ $FAILED -ne 0 ]; then
+  echo "$FAILED test(s) failed"
+  exit 1
+fi
+exit 0
@@ -0,0 +1,182 @@
+#ifndef HOSTTESTS_SHIM_ARDUINO_H
+#define HOSTTESTS_SHIM_ARDUINO_H
+
+// Minimal Arduino environment to build ESPEasy sources on a PC.
+// Only what is needed by the sources under test is implemented.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+class __FlashStringHelper;
+
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define PROGMEM
+#define PGM_P                const char *
+#define pgm_read_byte(addr)  (*reinterpret_cast<const uint8_t *>(addr))
+#define strlen_P             strlen
+#define memcpy_P             memcpy
+#define strcmp_P             strcmp
+
+#define _min(a, b) ((a) < (b) ? (a) : (b))
+#define _max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define radians(deg) ((deg) * DEG_TO_RAD)
+#define degrees(rad) ((rad) * RAD_TO_DEG)
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+using std::isinf;
+using std::isnan;
+using std::max;
+using std::min;
+
+inline unsigned long millis() {
+  using namespace std::chrono;
+  return static_cast<unsigned long>(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline void delay(unsigned long) {}
+
+inline bool isDigit(int c) { return isdigit(c) != 0; }
+
+class String {
+public:
+
+  String() = default;
+  String(const char *str) : _str(str == nullptr ? "" : str) {}
+  String(const __FlashStringHelper *str) : String(reinterpret_cast<const char *>(str)) {}
+  String(const std::string& str) : _str(str) {}
+  explicit String(char c) : _str(1, c) {}
+  explicit String(int value) : _str(std::to_string(value)) {}
+  explicit String(unsigned int value) : _str(std::to_string(value)) {}
+  explicit String(long value) : _str(std::to_string(value)) {}
+  explicit String(unsigned long value) : _str(std::to_string(value)) {}
+  explicit String(double value, unsigned int decimalPlaces = 2) {
+    char buf[64];
+
+    snprintf(buf, sizeof(buf), "%.*f", static_cast<int>(decimalPlaces), value);
+    _str = buf;
+  }
+
+  const char* c_str() const              { return _str.c_str(); }
+  unsigned int length() const            { return _str.length(); }
+  bool isEmpty() const                   { return _str.empty(); }
+  bool reserve(unsigned int size)        { _str.reserve(size); return true; }
+
+  char charAt(unsigned int index) const  { return index < _str.size() ? _str[index] : '\0'; }
+  char operator[](unsigned int index) const { return charAt(index); }
+  char& operator[](unsigned int index)   { return _str[index]; }
+
+  bool concat(const char *str, unsigned int length) { _str.append(str, length); return true; }
+  bool concat(const String& str)         { _str += str._str; return true; }
+  bool concat(const char *str)           { _str += str; return true; }
+  bool concat(char c)                    { _str += c; return true; }
+
+  String& operator+=(const String& str)  { _str += str._str; return *this; }
+  String& operator+=(const char *str)    { _str += str; return *this; }
+  String& operator+=(const __FlashStringHelper *str) { return operator+=(reinterpret_cast<const char *>(str)); }
+  String& operator+=(char c)             { _str += c; return *this; }
+  String& operator+=(int value)          { _str += std::to_string(value); return *this; }
+
+  bool operator==(const String& other) const { return _str == other._str; }
+  bool operator!=(const String& other) const { return _str != other._str; }
+  bool operator<(const String& other) const  { return _str < other._str; }
+  bool operator==(const char *other) const   { return _str == other; }
+
+  bool equals(const String& other) const     { return _str == other._str; }
+  bool equalsIgnoreCase(const String& other) const {
+    if (_str.size() != other._str.size()) { return false; }
+
+    for (size_t i = 0; i < _str.size(); ++i) {
+      if (tolower(_str[i]) != tolower(other._str[i])) { return false; }
+    }
+    return true;
+  }
+
+  int compareTo(const String& other) const   { return _str.compare(other._str); }
+  bool startsWith(const String& prefix) const { return _str.compare(0, prefix._str.size(), prefix._str) == 0; }
+  bool endsWith(const String& suffix) const {
+    return _str.size() >= suffix._str.size() &&
+           _str.compare(_str.size() - suffix._str.size(), suffix._str.size(), suffix._str) == 0;
+  }
+
+  int indexOf(char c, unsigned int from = 0) const {
+    const size_t pos = _str.find(c, from);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+  }
+
+  int indexOf(const String& str, unsigned int from = 0) const {
+    const size_t pos = _str.find(str._str, from);
+    return pos == std::string::npos ? -1 : static_cast<int>(pos);
+  }
+
+  String substring(unsigned int begin) const {
+    return begin < _str.size() ? String(_str.substr(begin)) : String();
+  }
+
+  String substring(unsigned int begin, unsigned int end) const {
+    if (begin > end) { std::swap(begin, end); }
+
+    if (begin >= _str.size()) { return String(); }
+    return String(_str.substr(begin, end - begin));
+  }
+
+  void replace(const String& find, const String& replace) {
+    if (find._str.empty()) { return; }
+    size_t pos = 0;
+
+    while ((pos = _str.find(find._str, pos)) != std::string::npos) {
+      _str.replace(pos, find._str.size(), replace._str);
+      pos += replace._str.size();
+    }
+  }
+
+  void replace(char find, char replace) { std::replace(_str.begin(), _str.end(), find, replace); }
+
+  void remove(unsigned int index, unsigned int count = static_cast<unsigned int>(-1)) {
+    if (index < _str.size()) { _str.erase(index, count); }
+  }
+
+  void trim() {
+    const size_t first = _str.find_first_not_of(" \t\r\n");
+
+    if (first == std::string::npos) {
+      _str.clear();
+      return;
+    }
+    _str = _str.substr(first, _str.find_last_not_of(" \t\r\n") - first + 1);
+  }
+
+  void toLowerCase() { for (char& c : _str) { c = static_cast<char>(tolower(c)); } }
+  void toUpperCase() { for (char& c : _str) { c = static_cast<char>(toupper(c)); } }
+
+  long toInt() const     { return atol(_str.c_str()); }
+  float toFloat() const  { return static_cast<float>(atof(_str.c_str())); }
+  double toDouble() const { return atof(_str.c_str()); }
+
+private:
+
+  std::string _str;
+};
+
+inline String operator+(const String& lhs, const String& rhs) { String res(lhs); res += rhs; return res; }
+inline String operator+(const String& lhs, const char *rhs)   { String res(lhs); res += rhs; return res; }
+inline String operator+(const String& lhs, char rhs)          { String res(lhs); res += rhs; return res; }
+
+static const String emptyString;
+
+#endif // HOSTTESTS_SHIM_ARDUINO_H
@@ -0,0 +1,29 @@
+#ifndef HOSTTESTS_SHIM_ESPEASY_COMMON_H
+#define HOSTTESTS_SHIM_ESPEASY_COMMON_H
+
+// Replaces ESPEasy_common.h when building ESPEasy sources on a PC.
+// Build flags are set to a typical ESP32 build.
+
+#include <Arduino.h>
+
+#define CORE_POST_2_5_0
+#define BUILD_NO_DEBUG
+#define BUILD_NO_RAM_TRACKER
+
+#ifndef FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE 1
+#endif // ifndef FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+#ifndef FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES
+# define FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES 1
+#endif // ifndef FEATURE_TRIGONOMETRIC_FUNCTIONS_RULES
+
+#if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define ESPEASY_RULES_FLOAT_TYPE double
+#else // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+# define ESPEASY_RULES_FLOAT_TYPE float
+#endif // if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+
+#define NR_ELEMENTS(ARRAY) (sizeof(ARRAY) / sizeof((ARRAY)[0]))
+
+#endif // HOSTTESTS_SHIM_ESPEASY_COMMON_H
@@ -0,0 +1,14 @@
+#ifndef HOSTTESTS_SHIM_ESPEASY_LOG_H
+#define HOSTTESTS_SHIM_ESPEASY_LOG_H
+
+#include "../../ESPEasy_common.h"
+
+#define LOG_LEVEL_NONE   0
+#define LOG_LEVEL_ERROR  1
+#define LOG_LEVEL_INFO   2
+
+inline bool loglevelActiveFor(uint8_t) { return false; }
+inline void addLog(uint8_t, const __FlashStringHelper *) {}
+inline void addLog(uint8_t, const String&) {}
+
+#endif // HOSTTESTS_SHIM_ESPEASY_LOG_H
@@ -0,0 +1,4 @@
+#ifndef HOSTTESTS_SHIM_RAMTRACKER_H
+#define HOSTTESTS_SHIM_RAMTRACKER_H
+
+#endif // HOSTTESTS_SHIM_RAMTRACKER_H
@@ -0,0 +1,10 @@
+#ifndef HOSTTESTS_SHIM_SETTINGS_H
+#define HOSTTESTS_SHIM_SETTINGS_H
+
+struct SettingsStruct_shim {
+  bool JSONBoolWithoutQuotes() const { return false; }
+};
+
+static SettingsStruct_shim Settings;
+
+#endif // HOSTTESTS_SHIM_SETTINGS_H
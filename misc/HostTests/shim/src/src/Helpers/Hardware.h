@@ -0,0 +1,4 @@
+#ifndef HOSTTESTS_SHIM_HARDWARE_H
+#define HOSTTESTS_SHIM_HARDWARE_H
+
+#endif // HOSTTESTS_SHIM_HARDWARE_H
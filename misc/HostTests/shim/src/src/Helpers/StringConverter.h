@@ -0,0 +1,11 @@
+#ifndef HOSTTESTS_SHIM_STRINGCONVERTER_H
+#define HOSTTESTS_SHIM_STRINGCONVERTER_H
+
+#include "../../ESPEasy_common.h"
+
+inline bool equals(const String& str, const __FlashStringHelper *f_str) { return str.equals(String(f_str)); }
+inline bool equals(const String& str, const char& c) { return str.length() == 1 && str[0] == c; }
+
+inline bool reserve_special(String& str, size_t size) { return str.reserve(size); }
+
+#endif // HOSTTESTS_SHIM_STRINGCONVERTER_H
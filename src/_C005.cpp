@@ -49,6 +49,7 @@ bool CPlugin_005(CPlugin::Function function, struct EventStruct *event, String&
       #if FEATURE_MQTT_TLS
       proto.usesTLS      = true;
       #endif
+      proto.allowsBatchJSON = true;
       break;
     }
 
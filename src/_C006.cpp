@@ -46,6 +46,7 @@ bool CPlugin_006(CPlugin::Function function, struct EventStruct *event, String&
       #if FEATURE_MQTT_TLS
       proto.usesTLS      = true;
       #endif
+      proto.allowsBatchJSON = true;
       break;
     }
 
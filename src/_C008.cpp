@@ -80,14 +80,11 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
 
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
       std::unique_ptr<C008_queue_element> element(new (std::nothrow) C008_queue_element(event, valueCount));
-      success = C008_DelayHandler->addToQueue(std::move(element));
-
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C008_queue_element& element = static_cast<C008_queue_element&>(*(C008_DelayHandler->sendQueue.back()));
 
+      if (element) {
+        // Fill the element before adding it to the queue,
+        // so its full size is checked against the queue memory limit.
+        // Strings are moved into the element, so no long string needs to be copied.
         // Collect the values at the same run, to make sure all are from the same sample
         //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
@@ -116,15 +113,16 @@ bool CPlugin_008(CPlugin::Function function, struct EventStruct *event, String&
             }
 #endif
             txt.replace(F("%value%"), formattedValue);
-            move_special(element.txt[x], std::move(txt));
+            move_special(element->txt[x], std::move(txt));
 # ifndef BUILD_NO_DEBUG
             if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-              addLog(LOG_LEVEL_DEBUG_MORE, concat(F("C008 : "), element.txt[x]));
+              addLog(LOG_LEVEL_DEBUG_MORE, concat(F("C008 : "), element->txt[x]));
             }
 # endif // ifndef BUILD_NO_DEBUG
           }
         }
       }
+      success = C008_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C008_DELAY_QUEUE, C008_DelayHandler->getNextScheduleTime());
       break;
     }
@@ -249,39 +249,38 @@ boolean Create_schedule_HTTP_C011(struct EventStruct *event)
   }
   //LoadTaskSettings(event->TaskIndex); // FIXME TD-er: This can probably be removed
 
-  // Add a new element to the queue with the minimal payload
+  // Fill the element before adding it to the queue,
+  // so its full size is checked against the queue memory limit.
   std::unique_ptr<C011_queue_element> element(new (std::nothrow) C011_queue_element(event));
-  bool success = C011_DelayHandler->addToQueue(std::move(element));
-
-  if (success) {
-    // Element was added.
-    // Now we try to append to the existing element
-    // and thus preventing the need to create a long string only to copy it to a queue element.
-    C011_queue_element& element = static_cast<C011_queue_element&>(*(C011_DelayHandler->sendQueue.back()));
 
+  if (!element) {
+    return false;
+  }
 
-    if (!load_C011_ConfigStruct(event->ControllerIndex, element.HttpMethod, element.uri, element.header, element.postStr))
-    {
-      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-        addLogMove(LOG_LEVEL_ERROR, strformat(
-          F("C011   : %s %s %s %s"),
-          element.HttpMethod.c_str(),
-          element.uri.c_str(),
-          element.header.c_str(),
-          element.postStr.c_str()));
-      }
-      C011_DelayHandler->sendQueue.pop_back();
-      return false;
+  if (!load_C011_ConfigStruct(event->ControllerIndex, element->HttpMethod, element->uri, element->header, element->postStr))
+  {
+    if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+      addLogMove(LOG_LEVEL_ERROR, strformat(
+        F("C011   : %s %s %s %s"),
+        element->HttpMethod.c_str(),
+        element->uri.c_str(),
+        element->header.c_str(),
+        element->postStr.c_str()));
     }
+    return false;
+  }
 
-    ReplaceTokenByValue(element.uri,    event, false);
-    ReplaceTokenByValue(element.header, event, false);
+  ReplaceTokenByValue(element->uri,    event, false);
+  ReplaceTokenByValue(element->header, event, false);
 
-    if (element.postStr.length() > 0)
-    {
-      ReplaceTokenByValue(element.postStr, event, C011_sendBinary);
-    }
-  } else {
+  if (element->postStr.length() > 0)
+  {
+    ReplaceTokenByValue(element->postStr, event, C011_sendBinary);
+  }
+
+  const bool success = C011_DelayHandler->addToQueue(std::move(element));
+
+  if (!success) {
     addLog(LOG_LEVEL_ERROR, F("C011  : Could not add to delay handler"));
   }
 
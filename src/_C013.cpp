@@ -7,9 +7,11 @@
 
 
 # include "src/Globals/Nodes.h"
+# include "src/DataStructs/C013_p2p_SensorDataBatchStruct.h"
 # include "src/DataStructs/C013_p2p_SensorDataStruct.h"
 # include "src/DataStructs/C013_p2p_SensorInfoStruct.h"
 # include "src/ESPEasyCore/ESPEasyRules.h"
+# include "src/Helpers/_CPlugin_C013_helper.h"
 # include "src/Helpers/Misc.h"
 # include "src/Helpers/Network.h"
 
@@ -29,10 +31,8 @@ void C013_SendUDPTaskInfo(uint8_t destUnit,
 void C013_SendUDPTaskData(struct EventStruct *event,
                           uint8_t             destUnit,
                           uint8_t             destTaskIndex);
-void C013_sendUDP(uint8_t        unit,
-                  const uint8_t *data,
-                  size_t         size);
 void C013_Receive(struct EventStruct *event);
+void C013_ProcessSensorData(const struct C013_SensorDataStruct& dataReply);
 
 
 bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String& string)
@@ -86,14 +86,18 @@ bool CPlugin_013(CPlugin::Function function, struct EventStruct *event, String&
       break;
     }
 
-    /*
-        case CPlugin::Function::CPLUGIN_FLUSH:
-          {
-            process_c013_delay_queue(event->ControllerIndex);
-            delay(0);
-            break;
-          }
-     */
+    case CPlugin::Function::CPLUGIN_FLUSH:
+    {
+      C013_flushSensorData();
+      delay(0);
+      break;
+    }
+
+    case CPlugin::Function::CPLUGIN_EXIT:
+    {
+      C013_closeUDP();
+      break;
+    }
 
     default:
       break;
@@ -169,54 +173,7 @@ void C013_SendUDPTaskData(struct EventStruct *event, uint8_t destUnit, uint8_t d
     dataReply.destUnit = 255;
   }
   dataReply.prepareForSend();
-  C013_sendUDP(dataReply.destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
-}
-
-/*********************************************************************************************\
-   Send UDP message (unit 255=broadcast)
-\*********************************************************************************************/
-void C013_sendUDP(uint8_t unit, const uint8_t *data, size_t size)
-{
-  START_TIMER
-
-  if (!NetworkConnected(10)) {
-    return;
-  }
-
-  const IPAddress remoteNodeIP = getIPAddressForUnit(unit);
-
-
-# ifndef BUILD_NO_DEBUG
-
-  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
-    addLogMove(LOG_LEVEL_DEBUG_MORE, strformat(
-                 F("C013 : Send UDP message to %d (%s)"),
-                 unit,
-                 remoteNodeIP.toString().c_str()));
-  }
-# endif // ifndef BUILD_NO_DEBUG
-
-  statusLED(true);
-
-  WiFiUDP C013_portUDP;
-
-  if (!beginWiFiUDP_randomPort(C013_portUDP)) {
-    STOP_TIMER(C013_SEND_UDP_FAIL);
-    return;
-  }
-
-  FeedSW_watchdog();
-
-  if (C013_portUDP.beginPacket(remoteNodeIP, Settings.UDPPort) == 0) {
-    STOP_TIMER(C013_SEND_UDP_FAIL);
-    return;
-  }
-  C013_portUDP.write(data, size);
-  C013_portUDP.endPacket();
-  C013_portUDP.stop();
-  FeedSW_watchdog();
-  delay(0);
-  STOP_TIMER(C013_SEND_UDP);
+  C013_queueSensorData(dataReply);
 }
 
 void C013_Receive(struct EventStruct *event) {
@@ -225,7 +182,7 @@ void C013_Receive(struct EventStruct *event) {
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
     if ((event->Data != nullptr) &&
-        (event->Data[1] > 1) && (event->Data[1] < 6))
+        (event->Data[1] > 1) && (event->Data[1] < 8))
     {
       String log = (F("C013 : msg "));
 
@@ -239,8 +196,6 @@ void C013_Receive(struct EventStruct *event) {
   }
 # endif // ifndef BUILD_NO_DEBUG
 
-  START_TIMER
-
   switch (event->Data[1]) {
     case 2: // sensor info pull request
     {
@@ -258,6 +213,8 @@ void C013_Receive(struct EventStruct *event) {
         struct C013_SensorInfoStruct infoReply;
 
         if (infoReply.setData(event->Data, event->Par2)) {
+          Nodes.markP2P_received(infoReply.sourceUnit, 1);
+
           // to prevent flash wear out (bugs in communication?) we can only write to an empty task
           // so it will write only once and has to be cleared manually through webgui
           // Also check the receiving end does support the plugin ID.
@@ -348,72 +305,97 @@ void C013_Receive(struct EventStruct *event) {
     {
       struct C013_SensorDataStruct dataReply;
 
-      // FIXME TD-er: We should check for sensorType and pluginID on both sides.
-      // For example sending different sensor type data from one dummy to another is probably not going to work well
-
       if (dataReply.setData(event->Data, event->Par2)) {
-        // only if this task has a remote feed, update values
-        const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
-
-        if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
-        {
-          // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
-          // See:
-          // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
-          // Thus should not be checked
-          //
-          // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
-          // missed)
-          // Then we cannot be sure about its build.
-          const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
-
-          if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
-            // Mismatch in plugin ID from sending node
-            if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-              String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
-              log += concat(F(" from unit "), dataReply.sourceUnit);
-              log += concat(F(" remote: "), dataReply.deviceNumber.value);
-              log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
-              addLogMove(LOG_LEVEL_ERROR, log);
-            }
-          } else {
-            struct EventStruct TempEvent(dataReply.destTaskIndex);
-            TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+        Nodes.markP2P_received(dataReply.sourceUnit, 1);
+        C013_ProcessSensorData(dataReply);
+      }
+      break;
+    }
 
-            const Sensor_VType sensorType = TempEvent.getSensorType();
+    case 7: // batch of sensor data
+    {
+      struct C013_SensorDataBatchStruct batch;
+      const uint8_t nrRecords = batch.getNrRecords(event->Data, event->Par2);
 
-            if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
-              TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+      if (nrRecords != 0) {
+        Nodes.markP2P_received(batch.sourceUnit, nrRecords);
 
-              if (taskValues != nullptr) {
-                memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
-              }
-              STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
-
-              if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
-                // Only use timestamp of remote unit when we got a system time ourselves
-                // If not, then the order of samples can get messed up.
-                // timestamp_fraq is 16 bit, so need to scale it to 32 bit
-                TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
-                SensorSendTask(&TempEvent, dataReply.timestamp_sec);
-              } else {
-                SensorSendTask(&TempEvent);
-              }
-            } else {
-              // Mismatch in sensor types
-              if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
-                String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
-                log += concat(F(" from unit "), dataReply.sourceUnit);
-                addLogMove(LOG_LEVEL_ERROR, log);
-              }
-            }
+        for (uint8_t i = 0; i < nrRecords; ++i) {
+          struct C013_SensorDataStruct dataReply;
+
+          if (dataReply.setData(C013_SensorDataBatchStruct::getRecord(event->Data, i, batch.recordSize), batch.recordSize)) {
+            C013_ProcessSensorData(dataReply);
           }
         }
       }
-
       break;
     }
   }
 }
 
+void C013_ProcessSensorData(const struct C013_SensorDataStruct& dataReply) {
+  START_TIMER
+
+  // FIXME TD-er: We should check for sensorType and pluginID on both sides.
+  // For example sending different sensor type data from one dummy to another is probably not going to work well
+
+  // only if this task has a remote feed, update values
+  const uint8_t remoteFeed = Settings.TaskDeviceDataFeed[dataReply.destTaskIndex];
+
+  if ((remoteFeed != 0) && (remoteFeed == dataReply.sourceUnit))
+  {
+    // deviceNumber and sensorType were not present before build 2023-05-05. (build NR 20460)
+    // See:
+    // https://github.com/letscontrolit/ESPEasy/commit/cf791527eeaf31ca98b07c45c1b64e2561a7b041#diff-86b42dd78398b103e272503f05f55ee0870ae5fb907d713c2505d63279bb0321
+    // Thus should not be checked
+    //
+    // If the node is not present in the nodes list (e.g. it had not announced itself in the last 10 minutes or announcement was
+    // missed)
+    // Then we cannot be sure about its build.
+    const bool mustMatch = dataReply.sourceNodeBuild >= 20460;
+
+    if (mustMatch && !dataReply.matchesPluginID(Settings.getPluginID_for_task(dataReply.destTaskIndex))) {
+      // Mismatch in plugin ID from sending node
+      if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+        String log = concat(F("P2P data : PluginID mismatch for task "), dataReply.destTaskIndex + 1);
+        log += concat(F(" from unit "), dataReply.sourceUnit);
+        log += concat(F(" remote: "), dataReply.deviceNumber.value);
+        log += concat(F(" local: "), Settings.getPluginID_for_task(dataReply.destTaskIndex).value);
+        addLogMove(LOG_LEVEL_ERROR, log);
+      }
+    } else {
+      struct EventStruct TempEvent(dataReply.destTaskIndex);
+      TempEvent.Source = EventValueSource::Enum::VALUE_SOURCE_UDP;
+
+      const Sensor_VType sensorType = TempEvent.getSensorType();
+
+      if (!mustMatch || dataReply.matchesSensorType(sensorType)) {
+        TaskValues_Data_t *taskValues = UserVar.getRawTaskValues_Data(dataReply.destTaskIndex);
+
+        if (taskValues != nullptr) {
+          memcpy(taskValues->binary, dataReply.taskValues_Data, sizeof(dataReply.taskValues_Data));
+        }
+        STOP_TIMER(C013_RECEIVE_SENSOR_DATA);
+
+        if (node_time.systemTimePresent() && (dataReply.timestamp_sec != 0)) {
+          // Only use timestamp of remote unit when we got a system time ourselves
+          // If not, then the order of samples can get messed up.
+          // timestamp_fraq is 16 bit, so need to scale it to 32 bit
+          TempEvent.timestamp_frac = static_cast<uint32_t>(dataReply.timestamp_frac) << 16;
+          SensorSendTask(&TempEvent, dataReply.timestamp_sec);
+        } else {
+          SensorSendTask(&TempEvent);
+        }
+      } else {
+        // Mismatch in sensor types
+        if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+          String log = concat(F("P2P data : SensorType mismatch for task "), dataReply.destTaskIndex + 1);
+          log += concat(F(" from unit "), dataReply.sourceUnit);
+          addLogMove(LOG_LEVEL_ERROR, log);
+        }
+      }
+    }
+  }
+}
+
 #endif // ifdef USES_C013
@@ -181,6 +181,7 @@ bool CPlugin_014(CPlugin::Function function, struct EventStruct *event, String&
       #if FEATURE_MQTT_TLS
       proto.usesTLS      = true;
       #endif
+      proto.allowsBatchJSON = true;
       break;
     }
 
@@ -185,14 +185,10 @@ bool CPlugin_015(CPlugin::Function function, struct EventStruct *event, String&
       uint8_t valueCount = getValueCountForTask(event->TaskIndex);
 
       std::unique_ptr<C015_queue_element> element(new (std::nothrow) C015_queue_element(event, valueCount));
-      success = C015_DelayHandler->addToQueue(std::move(element));
-
-      if (success) {
-        // Element was added.
-        // Now we try to append to the existing element
-        // and thus preventing the need to create a long string only to copy it to a queue element.
-        C015_queue_element& element = static_cast<C015_queue_element&>(*(C015_DelayHandler->sendQueue.back()));
 
+      if (element) {
+        // Fill the element before adding it to the queue,
+        // so its full size is checked against the queue memory limit.
         const String taskDeviceName = getTaskDeviceName(event->TaskIndex);
 
         for (uint8_t x = 0; x < valueCount; x++)
@@ -234,10 +230,11 @@ bool CPlugin_015(CPlugin::Function function, struct EventStruct *event, String&
             }
             addLogMove(LOG_LEVEL_INFO, log);
           }
-          element.vPin[x] = vPinNumber;
-          move_special(element.txt[x], std::move(formattedValue));
+          element->vPin[x] = vPinNumber;
+          move_special(element->txt[x], std::move(formattedValue));
         }
       }
+      success = C015_DelayHandler->addToQueue(std::move(element));
       Scheduler.scheduleNextDelayQueue(SchedulerIntervalTimer_e::TIMER_C015_DELAY_QUEUE, C015_DelayHandler->getNextScheduleTime());
       break;
     }
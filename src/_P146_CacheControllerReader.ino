@@ -12,7 +12,7 @@
 //
 // Typical use cases:
 // - Dumping data to a MQTT broker
-// - Upload binary data to a web server (not yet implemented)
+// - Upload samples in bulk to a web server via a HTTP controller
 //
 // Receive "instructions" from MQTT controller or web command to initiate a dump.
 //
@@ -77,10 +77,13 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
 
       P146_MINIMAL_SEND_INTERVAL = 100;
       P146_MQTT_MESSAGE_LENGTH   = 800;
+      P146_HTTP_MAX_SAMPLES      = P146_HTTP_DEFAULT_MAX_SAMPLES;
+      P146_HTTP_FORMAT           = P146_HTTP_FORMAT_JSON;
 
       String strings[P146_Nlines];
       strings[P146_TaskInfoTopicIndex] = F("%sysname%_%unit%/%tskname%/upload_meta");
       strings[P146_PublishTopicIndex]  = F("%sysname%_%unit%/%tskname%/upload");
+      strings[P146_HttpUriIndex]       = F("/upload?unit=%unit%");
 
       SaveCustomTaskSettings(event->TaskIndex, strings, P146_Nlines, 0);
 
@@ -109,7 +112,20 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
       if (ControllerCache.peekDataAvailable()) {
         Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + P146_MINIMAL_SEND_INTERVAL);
 
-        if (P146_GET_SEND_BULK) {
+        if (P146_GET_SEND_HTTP) {
+          # if FEATURE_HTTP_CLIENT
+          P146_data_struct *P146_data = static_cast<P146_data_struct *>(getPluginTaskData(event->TaskIndex));
+
+          if (nullptr != P146_data) {
+            if (0 != P146_data->sendHttpInBulk(event->TaskIndex, P146_HTTP_MAX_SAMPLES, P146_HTTP_FORMAT)) {
+              P146_data_struct::storeReadPosition(event);
+            } else {
+              // Read position has been restored, retry later.
+              Scheduler.schedule_task_device_timer(event->TaskIndex, millis() + P146_HTTP_RETRY_INTERVAL);
+            }
+          }
+          # endif // if FEATURE_HTTP_CLIENT
+        } else if (P146_GET_SEND_BULK) {
           if (P146_GET_SEND_BINARY) {
             P146_data_struct::prepare_BulkMQTT_message(event->TaskIndex);
           } else {
@@ -124,18 +140,7 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
           // Do not set the "success" or else the task values of this Cache reader task will be sent to the same controller too.
 
           if (P146_data_struct::sendViaOriginalTask(event->TaskIndex, P146_GET_SEND_TIMESTAMP)) {
-            int readFileNr    = 0;
-            const int readPos = ControllerCache.getPeekFilePos(readFileNr);
-
-            if (P146_GET_ERASE_BINFILES) {
-              // Check whether we must delete the oldest file
-              if ((P146_TASKVALUE_FILENR != 0) && (P146_TASKVALUE_FILENR  < readFileNr)) {
-                ControllerCache.deleteCacheBlock(P146_TASKVALUE_FILENR);
-              }
-            }
-
-            P146_SET_TASKVALUE_FILENR(readFileNr);
-            P146_SET_TASKVALUE_FILEPOS(readPos);
+            P146_data_struct::storeReadPosition(event);
           }
         }
       } else {
@@ -161,20 +166,7 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
           }
 
           if (data_sent) {
-            int readFileNr    = 0;
-            const int readPos = ControllerCache.getPeekFilePos(readFileNr);
-
-            if (P146_GET_ERASE_BINFILES) {
-              // Check whether we must delete the oldest file
-              const int filenr = P146_TASKVALUE_FILENR;
-
-              if ((filenr != 0) && (filenr  < readFileNr)) {
-                ControllerCache.deleteCacheBlock(filenr);
-              }
-            }
-
-            P146_SET_TASKVALUE_FILENR(readFileNr);
-            P146_SET_TASKVALUE_FILEPOS(readPos);
+            P146_data_struct::storeReadPosition(event);
           }
           success = true;
         }
@@ -203,6 +195,27 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
       addFormTextBox(F("TaskInfo Topic"), getPluginCustomArgName(P146_TaskInfoTopicIndex), strings[P146_TaskInfoTopicIndex], P146_Nchars);
       addFormTextBox(F("Publish Topic"),  getPluginCustomArgName(P146_PublishTopicIndex),  strings[P146_PublishTopicIndex],  P146_Nchars);
 
+      # if FEATURE_HTTP_CLIENT
+      addFormSubHeader(F("HTTP Output Options"));
+      addFormCheckBox(F("Send Bulk via HTTP"), F("sendhttp"), P146_GET_SEND_HTTP);
+      addFormNote(F("POST to the first enabled HTTP controller selected below"));
+      {
+        const __FlashStringHelper *formatLabels[] = {
+          F("JSON"),
+          F("Line Protocol")
+        };
+        const int formatOptions[] = {
+          P146_HTTP_FORMAT_JSON,
+          P146_HTTP_FORMAT_LINE_PROTOCOL
+        };
+        constexpr size_t optionCount = NR_ELEMENTS(formatOptions);
+        const FormSelectorOptions selector(optionCount, formatLabels, formatOptions);
+        selector.addFormSelector(F("Body Format"), F("httpformat"), P146_HTTP_FORMAT);
+      }
+      addFormNumericBox(F("Max Samples per Request"), F("httpmaxsamples"), P146_HTTP_MAX_SAMPLES, 1, 5000);
+      addFormTextBox(F("Upload URI"), getPluginCustomArgName(P146_HttpUriIndex), strings[P146_HttpUriIndex], P146_Nchars);
+      # endif // if FEATURE_HTTP_CLIENT
+
 
       //      addFormSubHeader(F("Non MQTT Output Options"));
       //      addFormCheckBox(F("Send Timestamp"), F("sendtimestamp"), P146_GET_SEND_TIMESTAMP);
@@ -265,6 +278,12 @@ boolean Plugin_146(uint8_t function, struct EventStruct *event, String& string)
       P146_MINIMAL_SEND_INTERVAL = getFormItemInt(F("minsendinterval"));
       P146_MQTT_MESSAGE_LENGTH   = getFormItemInt(F("maxmsgsize"));
 
+      # if FEATURE_HTTP_CLIENT
+      P146_SET_SEND_HTTP(isFormItemChecked(F("sendhttp")));
+      P146_HTTP_FORMAT      = getFormItemInt(F("httpformat"));
+      P146_HTTP_MAX_SAMPLES = getFormItemInt(F("httpmaxsamples"));
+      # endif // if FEATURE_HTTP_CLIENT
+
       P146_SET_JOIN_TIMESTAMP(isFormItemChecked(F("jointimestamp")));
       P146_SET_ONLY_SET_TASKS(isFormItemChecked(F("onlysettasks")));
       P146_SEPARATOR_CHARACTER = getFormItemInt(F("separator"));
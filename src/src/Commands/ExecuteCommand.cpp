@@ -205,13 +205,13 @@ bool ExecuteCommand(ExecuteCommandArgs&& args, bool addToQueue)
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    addLogMove(LOG_LEVEL_DEBUG, strformat(
+    addLogFormat(LOG_LEVEL_DEBUG,
                  F("Par1: %d Par2: %d Par3: %d Par4: %d Par5: %d"),
                  TempEvent.Par1,
                  TempEvent.Par2,
                  TempEvent.Par3,
                  TempEvent.Par4,
-                 TempEvent.Par5));
+                 TempEvent.Par5);
   }
 #endif // ifndef BUILD_NO_DEBUG
 
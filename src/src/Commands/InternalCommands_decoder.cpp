@@ -14,7 +14,7 @@
 // when adding new commands
 
 
-const char Internal_commands_ab[] PROGMEM =
+constexpr char Internal_commands_ab[] PROGMEM =
   "accessinfo|"
   "asyncevent|"
   "build|"
@@ -30,7 +30,7 @@ const char Internal_commands_ab[] PROGMEM =
 ;
 
 #define Int_cmd_c_offset ESPEasy_cmd_e::clearaccessblock
-const char Internal_commands_c[] PROGMEM =
+constexpr char Internal_commands_c[] PROGMEM =
   "clearaccessblock|"
   "clearpassword|"
   "clearrtcram|"
@@ -44,7 +44,7 @@ const char Internal_commands_c[] PROGMEM =
 ;
 
 #define Int_cmd_d_offset ESPEasy_cmd_e::datetime
-const char Internal_commands_d[] PROGMEM =
+constexpr char Internal_commands_d[] PROGMEM =
   "datetime|"
   "debug|"
   "dec|"
@@ -58,7 +58,7 @@ const char Internal_commands_d[] PROGMEM =
 ;
 
 #define Int_cmd_e_offset ESPEasy_cmd_e::erasesdkwifi
-const char Internal_commands_e[] PROGMEM =
+constexpr char Internal_commands_e[] PROGMEM =
   "erasesdkwifi|"
   "event|"
   "executerules|"
@@ -79,7 +79,7 @@ const char Internal_commands_e[] PROGMEM =
 ;
 
 #define Int_cmd_fghij_offset ESPEasy_cmd_e::factoryreset
-const char Internal_commands_fghij[] PROGMEM =
+constexpr char Internal_commands_fghij[] PROGMEM =
   "factoryreset|"
   "gateway|"
   "gpio|"
@@ -97,7 +97,7 @@ const char Internal_commands_fghij[] PROGMEM =
 ;
 
 #define Int_cmd_l_offset ESPEasy_cmd_e::let
-const char Internal_commands_l[] PROGMEM =
+constexpr char Internal_commands_l[] PROGMEM =
   "let|"
   "load|"
   "logentry|"
@@ -114,7 +114,7 @@ const char Internal_commands_l[] PROGMEM =
 ;
 
 #define Int_cmd_m_offset ESPEasy_cmd_e::monitor
-const char Internal_commands_m[] PROGMEM =
+constexpr char Internal_commands_m[] PROGMEM =
   "monitor|"
   "monitorrange|"
 #ifdef USES_P009
@@ -136,7 +136,7 @@ const char Internal_commands_m[] PROGMEM =
 ;
 
 #define Int_cmd_no_offset ESPEasy_cmd_e::name
-const char Internal_commands_no[] PROGMEM =
+constexpr char Internal_commands_no[] PROGMEM =
   "name|"
   "nosleep|"
 #if FEATURE_NOTIFIER
@@ -149,7 +149,7 @@ const char Internal_commands_no[] PROGMEM =
 ;
 
 #define Int_cmd_p_offset ESPEasy_cmd_e::password
-const char Internal_commands_p[] PROGMEM =
+constexpr char Internal_commands_p[] PROGMEM =
   "password|"
 #ifdef USES_P019
   "pcfgpio|"
@@ -190,7 +190,7 @@ const char Internal_commands_p[] PROGMEM =
 ;
 
 #define Int_cmd_r_offset ESPEasy_cmd_e::reboot
-const char Internal_commands_r[] PROGMEM =
+constexpr char Internal_commands_r[] PROGMEM =
   "reboot|"
   "resetflashwritecounter|"
   "restart|"
@@ -199,7 +199,7 @@ const char Internal_commands_r[] PROGMEM =
 ;
 
 #define Int_cmd_s_offset ESPEasy_cmd_e::save
-const char Internal_commands_s[] PROGMEM =
+constexpr char Internal_commands_s[] PROGMEM =
   "save|"
   "scheduletaskrun|"
 #if FEATURE_SD
@@ -231,7 +231,7 @@ const char Internal_commands_s[] PROGMEM =
 ;
 
 #define Int_cmd_t_offset ESPEasy_cmd_e::taskclear
-const char Internal_commands_t[] PROGMEM =
+constexpr char Internal_commands_t[] PROGMEM =
   "taskclear|"
   "taskclearall|"
   "taskdisable|"
@@ -250,7 +250,7 @@ const char Internal_commands_t[] PROGMEM =
 ;
 
 #define Int_cmd_u_offset ESPEasy_cmd_e::udpport
-const char Internal_commands_u[] PROGMEM =
+constexpr char Internal_commands_u[] PROGMEM =
   "udpport|"
 #if FEATURE_ESPEASY_P2P
   "udptest|"
@@ -262,7 +262,7 @@ const char Internal_commands_u[] PROGMEM =
 ;
 
 #define Int_cmd_w_offset ESPEasy_cmd_e::wifiallowap
-const char Internal_commands_w[] PROGMEM =
+constexpr char Internal_commands_w[] PROGMEM =
   "wifiallowap|"
   "wifiapmode|"
   "wificonnect|"
@@ -358,46 +358,173 @@ const char* getInternalCommand_Haystack_Offset(const char firstLetter, int& offs
   return haystack;
 }
 
-ESPEasy_cmd_e match_ESPEasy_internal_command(const String& cmd)
+#ifdef ESP32
+
+/********************************************************************************************\
+   Hash table to look up internal commands, computed at compile time
+ \*********************************************************************************************/
+
+// Must be a power of 2 and well over the number of commands to keep the probe sequences short
+# define INTERNAL_COMMAND_HASH_SIZE   512
+# define INTERNAL_COMMAND_HASH_EMPTY  0xFF
+
+static_assert(static_cast<int>(ESPEasy_cmd_e::NotMatched) < INTERNAL_COMMAND_HASH_EMPTY,
+              "ESPEasy_cmd_e does not fit in the internal command hash table");
+static_assert((2 * static_cast<int>(ESPEasy_cmd_e::NotMatched)) < INTERNAL_COMMAND_HASH_SIZE,
+              "Increase INTERNAL_COMMAND_HASH_SIZE");
+
+struct InternalCommand_haystack_t {
+  const char   *haystack;
+  ESPEasy_cmd_e offset;
+};
+
+// Same haystacks and offsets as used in getInternalCommand_Haystack_Offset()
+constexpr InternalCommand_haystack_t Internal_commands_haystacks[] = {
+  { Internal_commands_ab,    ESPEasy_cmd_e::accessinfo },
+  { Internal_commands_c,     Int_cmd_c_offset          },
+  { Internal_commands_d,     Int_cmd_d_offset          },
+  { Internal_commands_e,     Int_cmd_e_offset          },
+  { Internal_commands_fghij, Int_cmd_fghij_offset      },
+  { Internal_commands_l,     Int_cmd_l_offset          },
+  { Internal_commands_m,     Int_cmd_m_offset          },
+  { Internal_commands_no,    Int_cmd_no_offset         },
+  { Internal_commands_p,     Int_cmd_p_offset          },
+  { Internal_commands_r,     Int_cmd_r_offset          },
+  { Internal_commands_s,     Int_cmd_s_offset          },
+  { Internal_commands_t,     Int_cmd_t_offset          },
+  { Internal_commands_u,     Int_cmd_u_offset          },
+  { Internal_commands_w,     Int_cmd_w_offset          }
+};
+
+struct InternalCommand_hashTable_t {
+  // Start of the command name in its haystack, per ESPEasy_cmd_e
+  const char *names[static_cast<int>(ESPEasy_cmd_e::NotMatched)];
+
+  // ESPEasy_cmd_e per slot, linear probing
+  uint8_t slots[INTERNAL_COMMAND_HASH_SIZE];
+};
+
+constexpr char internalCommand_toLower(char c)
 {
-  START_TIMER;
-  ESPEasy_cmd_e res = ESPEasy_cmd_e::NotMatched;
+  return ((c >= 'A') && (c <= 'Z')) ? (c - 'A' + 'a') : c;
+}
 
-  if (cmd.length() < 2) {
-    // No commands less than 2 characters
-    return res;
+// FNV-1a hash of a command name, which ends at '\0' or '|'
+constexpr uint32_t internalCommand_hash(const char *str)
+{
+  uint32_t hash = 2166136261u;
+
+  for (; (*str != '\0') && (*str != '|'); ++str) {
+    hash ^= static_cast<uint8_t>(internalCommand_toLower(*str));
+    hash *= 16777619u;
   }
+  return hash;
+}
 
-  int offset           = 0;
-  const char *haystack = getInternalCommand_Haystack_Offset(cmd[0], offset);
+constexpr InternalCommand_hashTable_t make_internalCommand_hashTable()
+{
+  InternalCommand_hashTable_t table{};
 
-  if (haystack == nullptr) {
-/*
-    addLog(LOG_LEVEL_ERROR, strformat(
-             F("Internal command: No Haystack/offset '%s', offset: %d"),
-             cmd.c_str(),
-             offset));
-*/
-    return res;
+  for (size_t i = 0; i < INTERNAL_COMMAND_HASH_SIZE; ++i) {
+    table.slots[i] = INTERNAL_COMMAND_HASH_EMPTY;
   }
 
+  for (const InternalCommand_haystack_t& entry : Internal_commands_haystacks) {
+    int cmd          = static_cast<int>(entry.offset);
+    const char *name = entry.haystack;
 
-  if (haystack != nullptr) {
-    const int command_i = GetCommandCode(cmd.c_str(), haystack);
+    while (*name != '\0') {
+      uint32_t slot = internalCommand_hash(name) & (INTERNAL_COMMAND_HASH_SIZE - 1);
 
-    if (command_i != -1) {
-      res = static_cast<ESPEasy_cmd_e>(command_i + offset);
+      while (table.slots[slot] != INTERNAL_COMMAND_HASH_EMPTY) {
+        slot = (slot + 1) & (INTERNAL_COMMAND_HASH_SIZE - 1);
+      }
+      table.slots[slot] = cmd;
+      table.names[cmd]  = name;
+      ++cmd;
+
+      // Skip to the next command in the haystack
+      while ((*name != '\0') && (*name != '|')) {
+        ++name;
+      }
+
+      if (*name == '|') {
+        ++name;
+      }
     }
-/*
-    else {
-      addLog(LOG_LEVEL_ERROR, strformat(
-               F("Internal command: Not found '%s', haystack: %s"),
-               cmd.c_str(),
-               String(haystack).c_str()));
+  }
+  return table;
+}
+
+constexpr InternalCommand_hashTable_t internalCommand_hashTable = make_internalCommand_hashTable();
+
+// Check whether each ESPEasy_cmd_e has a name in the haystacks
+constexpr bool internalCommand_hashTable_complete()
+{
+  for (const char *name : internalCommand_hashTable.names) {
+    if (name == nullptr) {
+      return false;
     }
-*/
   }
-  STOP_TIMER(COMMAND_DECODE_INTERNAL);
+  return true;
+}
+
+static_assert(internalCommand_hashTable_complete(),
+              "Internal_commands haystacks do not match ESPEasy_cmd_e");
+
+static bool internalCommand_equals(const String& cmd, const char *name)
+{
+  const size_t len = cmd.length();
+
+  for (size_t i = 0; i < len; ++i) {
+    if ((name[i] == '|') || (name[i] == '\0') ||
+        (internalCommand_toLower(cmd[i]) != internalCommand_toLower(name[i]))) {
+      return false;
+    }
+  }
+  return (name[len] == '|') || (name[len] == '\0');
+}
+
+#endif // ifdef ESP32
+
+ESPEasy_cmd_e match_ESPEasy_internal_command(const String& cmd)
+{
+  START_TIMER;
+  ESPEasy_cmd_e res = ESPEasy_cmd_e::NotMatched;
+
+  // No commands less than 2 characters
+  if (cmd.length() >= 2) {
+    #ifdef ESP32
+    uint32_t slot = internalCommand_hash(cmd.c_str()) & (INTERNAL_COMMAND_HASH_SIZE - 1);
+
+    while (internalCommand_hashTable.slots[slot] != INTERNAL_COMMAND_HASH_EMPTY) {
+      const uint8_t cmd_i = internalCommand_hashTable.slots[slot];
+
+      if (internalCommand_equals(cmd, internalCommand_hashTable.names[cmd_i])) {
+        res = static_cast<ESPEasy_cmd_e>(cmd_i);
+        break;
+      }
+      slot = (slot + 1) & (INTERNAL_COMMAND_HASH_SIZE - 1);
+    }
+    #else // ifdef ESP32
+    int offset           = 0;
+    const char *haystack = getInternalCommand_Haystack_Offset(cmd[0], offset);
+
+    if (haystack != nullptr) {
+      const int command_i = GetCommandCode(cmd.c_str(), haystack);
+
+      if (command_i != -1) {
+        res = static_cast<ESPEasy_cmd_e>(command_i + offset);
+      }
+    }
+    #endif // ifdef ESP32
+  }
+
+  if (res == ESPEasy_cmd_e::NotMatched) {
+    STOP_TIMER(COMMAND_DECODE_INTERNAL_NOT_MATCHED);
+  } else {
+    STOP_TIMER(COMMAND_DECODE_INTERNAL);
+  }
   return res;
 }
 
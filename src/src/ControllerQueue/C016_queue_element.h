@@ -18,6 +18,7 @@ struct EventStruct;
 
 // The binary format to store the samples using the Cache Controller
 // Do NOT change order of members!
+// When changing this layout, also update the host side reader misc/CacheController/ESPEasyCacheReader.h
 struct C016_binary_element {
   TaskValues_Data_t values{};
   unsigned long unixTime{};
@@ -28,6 +28,16 @@
   # define CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME 10000
 #endif // ifndef CONTROLLER_QUEUE_MINIMAL_EXPIRE_TIME
 
+// Max. memory in bytes used by the queued elements of a single controller,
+// as reported by Queue_element_base::getSize()
+#ifndef CONTROLLER_QUEUE_MEMORY_MAX
+# ifdef ESP32
+#  define CONTROLLER_QUEUE_MEMORY_MAX 32768
+# else // ifdef ESP32
+#  define CONTROLLER_QUEUE_MEMORY_MAX 6144
+# endif // ifdef ESP32
+#endif // ifndef CONTROLLER_QUEUE_MEMORY_MAX
+
 typedef bool (*do_process_function)(cpluginID_t,
                                     const Queue_element_base&,
                                     ControllerSettingsStruct&);
@@ -43,13 +53,16 @@ struct ControllerDelayHandlerStruct {
 
   bool readyToProcess(const Queue_element_base& element) const;
 
-  bool queueFull(controllerIndex_t controller_idx) const;
+  // Return true when no element of newElementSize bytes can be added.
+  bool queueFull(controllerIndex_t controller_idx,
+                 size_t            newElementSize = 0) const;
 
   // Return true if message is already present in the queue
   bool isDuplicate(const Queue_element_base& element) const;
 
   // Try to add to the queue, if permitted by "delete_oldest"
   // Return true when item was added, or skipped as it was considered a duplicate
+  // The element must be complete when added, as its size is checked against CONTROLLER_QUEUE_MEMORY_MAX.
   bool addToQueue(std::unique_ptr<Queue_element_base>element);
 
   // Get the next element.
@@ -68,7 +81,11 @@ struct ControllerDelayHandlerStruct {
   // msecFromNow + minTimeBetweenMessages
   void   setAdditionalDelay(unsigned long msecFromNow);
 
-  size_t getQueueMemorySize() const;
+  size_t getQueueMemorySize() const {
+    return queueMemorySize;
+  }
+
+  void   popFront();
 
   void   process(
     cpluginID_t                        cpluginID,
@@ -78,6 +95,7 @@ struct ControllerDelayHandlerStruct {
 
   std::list<std::unique_ptr<Queue_element_base> >sendQueue;
   mutable UnitLastMessageCount_map               unitLastMessageCount;
+  size_t                                         queueMemorySize        = 0;
   unsigned long                                  lastSend               = 0;
   unsigned int                                   minTimeBetweenMessages = CONTROLLER_DELAY_QUEUE_DELAY_DFLT;
   unsigned long                                  expire_timeout         = 0;
@@ -3,6 +3,9 @@
 #include "../DataStructs/ControllerSettingsStruct.h"
 #include "../DataStructs/TimingStats.h"
 #include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/MQTT.h"
+#include "../Globals/Settings.h"
+#include "../Helpers/_CPlugin_init.h"
 #include "../Helpers/PeriodicalActions.h"
 
 #if FEATURE_MQTT
@@ -33,6 +36,7 @@ bool init_mqtt_delay_queue(controllerIndex_t ControllerIndex, String& pubname, b
   MQTTDelayHandler->cacheControllerSettings(*ControllerSettings);
   pubname    = ControllerSettings->Publish;
   retainFlag = ControllerSettings->mqtt_retainFlag();
+  mqtt_batchJSON = ControllerSettings->mqtt_batchJSON();
   Scheduler.setIntervalTimerOverride(SchedulerIntervalTimer_e::TIMER_MQTT, 10); // Make sure the MQTT is being processed as soon
                                                                                           // as possible.
   scheduleNextMQTTdelayQueue();
@@ -188,3 +192,64 @@ DEFINE_Cxxx_DELAY_QUEUE_MACRO_CPP(0, 18) // -V522
 
 // When extending this, search for EXTEND_CONTROLLER_IDS
 // in the code to find all places that need to be updated too.
+const ControllerDelayHandlerStruct* getControllerDelayHandler(controllerIndex_t ControllerIndex)
+{
+  if (!validControllerIndex(ControllerIndex) || !Settings.ControllerEnabled[ControllerIndex]) {
+    return nullptr;
+  }
+  const protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ControllerIndex);
+
+  if (!validProtocolIndex(ProtocolIndex)) {
+    return nullptr;
+  }
+#if FEATURE_MQTT
+
+  if (getProtocolStruct(ProtocolIndex).usesMQTT) {
+    return MQTTDelayHandler;
+  }
+#endif // if FEATURE_MQTT
+
+  switch (getCPluginID_from_ProtocolIndex(ProtocolIndex)) {
+#ifdef USES_C001
+    case 1: return C001_DelayHandler;
+#endif // ifdef USES_C001
+#ifdef USES_C003
+    case 3: return C003_DelayHandler;
+#endif // ifdef USES_C003
+#ifdef USES_C004
+    case 4: return C004_DelayHandler;
+#endif // ifdef USES_C004
+#ifdef USES_C007
+    case 7: return C007_DelayHandler;
+#endif // ifdef USES_C007
+#ifdef USES_C008
+    case 8: return C008_DelayHandler;
+#endif // ifdef USES_C008
+#ifdef USES_C009
+    case 9: return C009_DelayHandler;
+#endif // ifdef USES_C009
+#ifdef USES_C010
+    case 10: return C010_DelayHandler;
+#endif // ifdef USES_C010
+#ifdef USES_C011
+    case 11: return C011_DelayHandler;
+#endif // ifdef USES_C011
+#ifdef USES_C012
+    case 12: return C012_DelayHandler;
+#endif // ifdef USES_C012
+#ifdef USES_C015
+    case 15: return C015_DelayHandler;
+#endif // ifdef USES_C015
+#ifdef USES_C016
+    case 16: return C016_DelayHandler;
+#endif // ifdef USES_C016
+#ifdef USES_C017
+    case 17: return C017_DelayHandler;
+#endif // ifdef USES_C017
+#ifdef USES_C018
+    case 18: return C018_DelayHandler;
+#endif // ifdef USES_C018
+    default: break;
+  }
+  return nullptr;
+}
@@ -291,4 +291,9 @@ DEFINE_Cxxx_DELAY_QUEUE_MACRO(0, 18)
 // in the code to find all places that need to be updated too.
 
 
+// Return the delay queue of an enabled controller.
+// Return nullptr when the controller does not use a delay queue, or the queue is not initialized.
+const ControllerDelayHandlerStruct* getControllerDelayHandler(controllerIndex_t ControllerIndex);
+
+
 #endif // ifndef DELAY_QUEUE_ELEMENTS_H
@@ -1,5 +1,32 @@
 #include "../ControllerQueue/Queue_element_base.h"
 
+#include <stdlib.h>
+
+// Allocated sizes are rounded up to a multiple of this
+#define CONTROLLER_QUEUE_POOL_GRANULARITY  16
+
+// Larger elements are not kept for reuse
+#define CONTROLLER_QUEUE_POOL_NR_SIZES     12
+
+namespace {
+struct Queue_element_free_block {
+  Queue_element_free_block *next;
+};
+
+Queue_element_free_block *queue_element_pool[CONTROLLER_QUEUE_POOL_NR_SIZES]{};
+uint8_t queue_element_pool_count[CONTROLLER_QUEUE_POOL_NR_SIZES]{};
+
+// Return -1 when the size is not kept in the pool
+int queue_element_pool_index(size_t size) {
+  const size_t index = (size + CONTROLLER_QUEUE_POOL_GRANULARITY - 1) / CONTROLLER_QUEUE_POOL_GRANULARITY;
+
+  if ((index == 0) || (index > CONTROLLER_QUEUE_POOL_NR_SIZES)) {
+    return -1;
+  }
+  return index - 1;
+}
+}
+
 Queue_element_base::Queue_element_base() :
   _controller_idx(INVALID_CONTROLLER_INDEX),
   _taskIndex(INVALID_TASK_INDEX),
@@ -10,3 +37,43 @@ Queue_element_base::Queue_element_base() :
 }
 
 Queue_element_base::~Queue_element_base() {}
+
+void * Queue_element_base::operator new(size_t size, const std::nothrow_t&) noexcept
+{
+  const int index = queue_element_pool_index(size);
+
+  if (index < 0) {
+    return malloc(size);
+  }
+
+  Queue_element_free_block *block = queue_element_pool[index];
+
+  if (block != nullptr) {
+    queue_element_pool[index] = block->next;
+    --queue_element_pool_count[index];
+    return block;
+  }
+  return malloc((index + 1) * CONTROLLER_QUEUE_POOL_GRANULARITY);
+}
+
+void Queue_element_base::operator delete(void *ptr, size_t size)
+{
+  if (ptr == nullptr) { return; }
+
+  const int index = queue_element_pool_index(size);
+
+  if ((index >= 0) && (queue_element_pool_count[index] < CONTROLLER_QUEUE_POOL_BLOCKS_PER_SIZE)) {
+    Queue_element_free_block *block = static_cast<Queue_element_free_block *>(ptr);
+    block->next               = queue_element_pool[index];
+    queue_element_pool[index] = block;
+    ++queue_element_pool_count[index];
+    return;
+  }
+  free(ptr);
+}
+
+void Queue_element_base::operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+  // Blocks in the pool are allocated using malloc() too.
+  free(ptr);
+}
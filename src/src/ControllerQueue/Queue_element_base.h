@@ -7,6 +7,18 @@
 #include "../DataStructs/UnitMessageCount.h"
 #include "../Globals/CPlugins.h"
 
+#include <new> // for std::nothrow
+
+// Freed queue elements are kept for reuse, grouped per allocated size.
+// This prevents heap fragmentation when messages are continuously queued and sent.
+#ifndef CONTROLLER_QUEUE_POOL_BLOCKS_PER_SIZE
+# ifdef ESP32
+#  define CONTROLLER_QUEUE_POOL_BLOCKS_PER_SIZE  8
+# else // ifdef ESP32
+#  define CONTROLLER_QUEUE_POOL_BLOCKS_PER_SIZE  4
+# endif // ifdef ESP32
+#endif // ifndef CONTROLLER_QUEUE_POOL_BLOCKS_PER_SIZE
+
 /*********************************************************************************************\
 * Base class for all controller queue elements
 \*********************************************************************************************/
@@ -16,6 +28,16 @@ public:
 
   virtual ~Queue_element_base();
 
+  // Queue elements must be allocated using new (std::nothrow)
+  static void* operator new(size_t                size,
+                            const std::nothrow_t& tag) noexcept;
+
+  static void  operator delete(void  *ptr,
+                               size_t size);
+
+  static void  operator delete(void                 *ptr,
+                               const std::nothrow_t& tag) noexcept;
+
   virtual size_t                    getSize() const = 0;
 
   virtual bool                      isDuplicate(const Queue_element_base& other) const = 0;
@@ -34,6 +56,9 @@ public:
   // Some formatting of values can be done when actually sending it.
   // This may require less RAM than keeping formatted strings in memory
   bool _processByController;
+
+  // Size as accounted for in ControllerDelayHandlerStruct
+  size_t _accountedSize = 0;
 };
 
 #endif // ifndef CONTROLLERQUEUE_QUEUE_ELEMENT_BASE_H
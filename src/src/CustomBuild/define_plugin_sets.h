@@ -105,6 +105,9 @@ To create/register a plugin, you have to :
     #ifndef WEBSERVER_METRICS
         #define WEBSERVER_METRICS
     #endif
+    #ifndef WEBSERVER_EVENTS
+        #define WEBSERVER_EVENTS
+    #endif
     #ifndef WEBSERVER_TOOLS
         #define WEBSERVER_TOOLS
     #endif
@@ -3147,6 +3150,12 @@ To create/register a plugin, you have to :
 #define FEATURE_RTC_CACHE_STORAGE             0
 #endif
 
+// Store new cache controller files in a compressed format.
+// Reading compressed files is always supported when FEATURE_RTC_CACHE_STORAGE is set.
+#ifndef FEATURE_RTC_CACHE_COMPRESSION
+#define FEATURE_RTC_CACHE_COMPRESSION         0
+#endif
+
 #ifndef FEATURE_DNS_SERVER                    
 #define FEATURE_DNS_SERVER                    0
 #endif
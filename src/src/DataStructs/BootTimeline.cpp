@@ -0,0 +1,37 @@
+#include "../DataStructs/BootTimeline.h"
+
+#if FEATURE_TIMING_STATS
+
+# include "../Globals/Plugins.h"
+# include "../Helpers/ESPEasy_time_calc.h"
+
+BootTimeline bootTimeline;
+
+void BootTimeline::markPhase(const __FlashStringHelper *name)
+{
+  const uint64_t now = getMicros64();
+
+  if (_nrPhases < BOOT_TIMELINE_MAX_PHASES) {
+    Phase& phase = _phases[_nrPhases];
+    phase._name          = name;
+    phase._duration_usec = now - _lastMark;
+    phase._end_msec      = millis();
+    ++_nrPhases;
+  }
+  _lastMark = now;
+}
+
+void BootTimeline::setTaskInit(taskIndex_t taskIndex, uint64_t duration_usec, bool deferred)
+{
+  if (!validTaskIndex(taskIndex)) {
+    return;
+  }
+  TaskInit& taskInit = _taskInit[taskIndex];
+
+  taskInit._duration_usec = duration_usec;
+  taskInit._end_msec      = millis();
+  taskInit._deferred      = deferred;
+  taskInit._set           = true;
+}
+
+#endif // if FEATURE_TIMING_STATS
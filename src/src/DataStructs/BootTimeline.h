@@ -0,0 +1,78 @@
+#ifndef DATASTRUCTS_BOOTTIMELINE_H
+#define DATASTRUCTS_BOOTTIMELINE_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_TIMING_STATS
+
+# include "../CustomBuild/ESPEasyLimits.h"
+# include "../DataTypes/TaskIndex.h"
+
+// Max. number of boot phases recorded during setup()
+# ifndef BOOT_TIMELINE_MAX_PHASES
+#  define BOOT_TIMELINE_MAX_PHASES  24
+# endif // ifndef BOOT_TIMELINE_MAX_PHASES
+
+
+/*********************************************************************************************\
+* BootTimeline
+* Records the duration of each phase in ESPEasy_setup() and the PLUGIN_INIT duration per task.
+* Unlike the timing statistics, these are recorded once per boot and never cleared.
+\*********************************************************************************************/
+class BootTimeline {
+public:
+
+  struct Phase {
+    const __FlashStringHelper *_name = nullptr;
+    uint32_t                   _duration_usec{};
+    uint32_t                   _end_msec{};
+  };
+
+  struct TaskInit {
+    uint32_t _duration_usec{};
+    uint32_t _end_msec{};
+
+    // PLUGIN_INIT was deferred until after boot
+    bool _deferred = false;
+    bool _set      = false;
+  };
+
+  // Mark the end of a boot phase.
+  // A phase starts at the end of the previous phase, or at boot for the first phase.
+  void            markPhase(const __FlashStringHelper *name);
+
+  void            setTaskInit(taskIndex_t taskIndex,
+                              uint64_t    duration_usec,
+                              bool        deferred);
+
+  uint8_t         getNrPhases() const {
+    return _nrPhases;
+  }
+
+  const Phase   & getPhase(uint8_t index) const {
+    return _phases[index];
+  }
+
+  const TaskInit& getTaskInit(taskIndex_t taskIndex) const {
+    return _taskInit[taskIndex];
+  }
+
+private:
+
+  Phase    _phases[BOOT_TIMELINE_MAX_PHASES];
+  TaskInit _taskInit[TASKS_MAX];
+  uint64_t _lastMark = 0;
+  uint8_t  _nrPhases = 0;
+};
+
+extern BootTimeline bootTimeline;
+
+# define MARK_BOOT_PHASE(N) bootTimeline.markPhase(F(N))
+
+#else // if FEATURE_TIMING_STATS
+
+# define MARK_BOOT_PHASE(N) do {} while (0)
+
+#endif // if FEATURE_TIMING_STATS
+
+#endif // ifndef DATASTRUCTS_BOOTTIMELINE_H
@@ -0,0 +1,38 @@
+#include "../DataStructs/C013_p2p_SensorDataBatchStruct.h"
+
+#ifdef USES_C013
+
+uint8_t C013_SensorDataBatchStruct::getNrRecords(const uint8_t *data, size_t size)
+{
+  // First clear entire struct
+  memset(this, 0, sizeof(C013_SensorDataBatchStruct));
+
+  if (size < sizeof(C013_SensorDataBatchStruct)) {
+    return 0;
+  }
+
+  if ((data[0] != 255) || // header
+      (data[1] != 7)) {   // ID
+    return 0;
+  }
+  memcpy(this, data, sizeof(C013_SensorDataBatchStruct));
+
+  // Records may grow in future builds, so use the record size of the sender.
+  // Smaller records are handled by C013_SensorDataStruct::setData()
+  if (recordSize < 6) {
+    return 0;
+  }
+  const size_t available = (size - sizeof(C013_SensorDataBatchStruct)) / recordSize;
+
+  if (available < nrRecords) {
+    nrRecords = available;
+  }
+  return nrRecords;
+}
+
+const uint8_t * C013_SensorDataBatchStruct::getRecord(const uint8_t *data, uint8_t index, uint8_t recordSize)
+{
+  return data + sizeof(C013_SensorDataBatchStruct) + (static_cast<size_t>(index) * recordSize);
+}
+
+#endif // ifdef USES_C013
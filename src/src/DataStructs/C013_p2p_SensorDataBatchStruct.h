@@ -0,0 +1,48 @@
+#ifndef DATASTRUCTS_C013_P2P_SENSORDATABATCHSTRUCT_H
+#define DATASTRUCTS_C013_P2P_SENSORDATABATCHSTRUCT_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USES_C013
+
+
+# include "../CustomBuild/ESPEasyLimits.h"
+# include "../DataStructs/C013_p2p_SensorDataStruct.h"
+
+// Batched sensor data was added on 20261017 (build ID 21721)
+// Older nodes ignore messages with this ID, so only send batches to nodes running this build or newer.
+# define C013_SENSOR_DATA_BATCH_MIN_BUILD  21721
+
+
+// Header of a message holding multiple C013_SensorDataStruct records.
+// ID 6 is reserved for "Data Format Version 1" as described in the documentation.
+// Each record is a complete C013_SensorDataStruct, including its own header and checksum.
+// These structs are sent to other nodes, so make sure not to change order or offset in struct.
+struct __attribute__((__packed__)) C013_SensorDataBatchStruct
+{
+  C013_SensorDataBatchStruct() = default;
+
+  // Check the header and return the number of records which can be read from data
+  uint8_t               getNrRecords(const uint8_t *data,
+                                     size_t         size);
+
+  // Return pointer to the record with given index in data.
+  static const uint8_t* getRecord(const uint8_t *data,
+                                  uint8_t        index,
+                                  uint8_t        recordSize);
+
+  uint8_t header     = 255;
+  uint8_t ID         = 7;
+  uint8_t sourceUnit = 0;
+  uint8_t destUnit   = 0;
+  uint8_t nrRecords  = 0;
+  uint8_t recordSize = sizeof(C013_SensorDataStruct);
+};
+
+// Receiving nodes do not accept UDP packets of UDP_PACKETSIZE_MAX bytes or larger
+constexpr uint8_t C013_SENSOR_DATA_BATCH_MAX_RECORDS =
+  (UDP_PACKETSIZE_MAX - 1 - sizeof(C013_SensorDataBatchStruct)) / sizeof(C013_SensorDataStruct);
+
+#endif // ifdef USES_C013
+
+#endif // ifndef DATASTRUCTS_C013_P2P_SENSORDATABATCHSTRUCT_H
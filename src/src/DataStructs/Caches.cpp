@@ -16,18 +16,25 @@ void Caches::clearAllCaches()
 {
   clearAllButTaskCaches();
   clearAllTaskCaches();
+  #ifndef LIMIT_BUILD_SIZE
+  settingsFilePages.clear();
+  #endif // ifndef LIMIT_BUILD_SIZE
 }
 
 void Caches::clearAllButTaskCaches() {
   clearFileCaches();
   WiFi_AP_Candidates.clearCache();
   rulesHelper.closeAllFiles();
+  #ifndef LIMIT_BUILD_SIZE
+  parsedTemplates.clear();
+  #endif // ifndef LIMIT_BUILD_SIZE
 }
 
 void Caches::clearAllTaskCaches() {
   taskIndexName.clear();
   taskIndexValueName.clear();
   extraTaskSettings_cache.clear();
+  ++taskCacheVersion;
   updateActiveTaskUseSerial0();
 }
 
@@ -39,6 +46,7 @@ void Caches::clearTaskCache(taskIndex_t TaskIndex) {
   if (it != extraTaskSettings_cache.end()) {
     extraTaskSettings_cache.erase(it);
   }
+  ++taskCacheVersion;
   updateActiveTaskUseSerial0();
 }
 
@@ -151,6 +159,26 @@ String Caches::getTaskDeviceValueName(taskIndex_t TaskIndex, uint8_t rel_index)
   return EMPTY_STRING;
 }
 
+const char * Caches::getTaskDeviceValueName_cstr(taskIndex_t TaskIndex, uint8_t rel_index)
+{
+  if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
+  #ifdef ESP8266
+    LoadTaskSettings(TaskIndex);
+    return ExtraTaskSettings.TaskDeviceValueNames[rel_index];
+  #endif // ifdef ESP8266
+  #ifdef ESP32
+
+    auto it = getExtraTaskSettings(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      return it->second.TaskDeviceValueNames[rel_index].c_str();
+    }
+    #endif // ifdef ESP32
+  }
+
+  return "";
+}
+
 bool Caches::hasFormula(taskIndex_t TaskIndex, uint8_t rel_index)
 {
   if (validTaskIndex(TaskIndex) && (rel_index < VARS_PER_TASK)) {
@@ -302,6 +330,8 @@ void Caches::updateExtraTaskSettingsCache()
   if (validTaskIndex(TaskIndex)) {
     ExtraTaskSettings_cache_t tmp;
 
+    ++taskCacheVersion;
+
     auto it = extraTaskSettings_cache.find(TaskIndex);
 
     if (it != extraTaskSettings_cache.end()) {
@@ -309,8 +339,7 @@ void Caches::updateExtraTaskSettingsCache()
       tmp.md5checksum                = it->second.md5checksum;
       tmp.defaultTaskDeviceValueName = it->second.defaultTaskDeviceValueName;
 
-      // Now clear it so we can create a fresh copy.
-      extraTaskSettings_cache.erase(it);
+      // The cached entry will be replaced by a fresh copy.
       clearTaskIndexFromMaps(TaskIndex);
     }
     move_special(tmp.TaskDeviceName, String(ExtraTaskSettings.TaskDeviceName));
@@ -357,7 +386,14 @@ void Caches::updateExtraTaskSettingsCache()
     }
     #endif // ifdef ESP32
 
-    extraTaskSettings_cache.emplace(std::make_pair(TaskIndex, std::move(tmp)));
+    // Replace in place, to avoid moving all following elements of the flat map
+    it = extraTaskSettings_cache.find(TaskIndex);
+
+    if (it != extraTaskSettings_cache.end()) {
+      it->second = std::move(tmp);
+    } else {
+      extraTaskSettings_cache.emplace(std::make_pair(TaskIndex, std::move(tmp)));
+    }
   }
 }
 
@@ -410,11 +446,10 @@ void Caches::clearTaskIndexFromMaps(taskIndex_t TaskIndex)
     }
   }
   {
-    const String searchstr = String('#') + TaskIndex;
-    auto it                = taskIndexValueName.begin();
+    auto it = taskIndexValueName.begin();
 
     for (; it != taskIndexValueName.end();) {
-      if (it->first.endsWith(searchstr)) {
+      if (it->_group == TaskIndex) {
         it = taskIndexValueName.erase(it);
       } else {
         ++it;
@@ -5,6 +5,9 @@
 #include "../../ESPEasy_common.h"
 #include "../CustomBuild/ESPEasyLimits.h"
 #include "../DataStructs/ChecksumType.h"
+#include "../DataStructs/FlatMap.h"
+#include "../DataStructs/ParsedTemplate.h"
+#include "../DataStructs/SettingsFilePageCache.h"
 #ifdef ESP32
 # include "../DataStructs/ControllerSettingsStruct.h"
 # include "../DataTypes/ControllerIndex.h"
@@ -53,10 +56,12 @@ struct ExtraTaskSettings_cache_t {
   uint8_t hasFormula = 0; // Bitmap which task value has formula and whether a formula needs previous value
 };
 
-typedef std::map<String, taskIndex_t>                    TaskIndexNameMap;
-typedef std::map<String, uint8_t>                        TaskIndexValueNameMap;
-typedef std::map<String, uint8_t>                        FilePresenceMap;
-typedef std::map<taskIndex_t, ExtraTaskSettings_cache_t> ExtraTaskSettingsMap;
+// Task and value names are matched case insensitive.
+// Value names are stored with the task index as group.
+typedef FlatStringMap<taskIndex_t, true>                 TaskIndexNameMap;
+typedef FlatStringMap<uint8_t, true>                     TaskIndexValueNameMap;
+typedef FlatStringMap<uint8_t>                           FilePresenceMap;
+typedef FlatMap<taskIndex_t, ExtraTaskSettings_cache_t>  ExtraTaskSettingsMap;
 
 #ifdef ESP32
 typedef std::map<controllerIndex_t, ControllerSettingsStruct> ControllerSettingsMap;
@@ -84,6 +89,11 @@ struct Caches {
   String  getTaskDeviceValueName(taskIndex_t TaskIndex,
                                  uint8_t     rel_index);
 
+  // Same as getTaskDeviceValueName, without making a copy.
+  // Only valid until the task settings are loaded for another task or the cache is changed.
+  const char* getTaskDeviceValueName_cstr(taskIndex_t TaskIndex,
+                                          uint8_t     rel_index);
+
   // Check to see if at least one of the taskvalues has a non-empty formula field.
   bool hasFormula(taskIndex_t TaskIndex, uint8_t rel_index);
   bool hasFormula(taskIndex_t TaskIndex);
@@ -139,6 +149,10 @@ public:
   TaskIndexValueNameMap taskIndexValueName;
   FilePresenceMap       fileExistsMap;  // Filesize. -1 if not present
   RulesHelperClass      rulesHelper;
+  #ifndef LIMIT_BUILD_SIZE
+  ParsedTemplate_cache  parsedTemplates;
+  SettingsFilePageCache settingsFilePages;
+  #endif // ifndef LIMIT_BUILD_SIZE
 
 private:
 
@@ -155,6 +169,9 @@ public:
   ChecksumType controllerSettings_checksums[CONTROLLER_MAX] = {};
   uint32_t     fileCacheClearMoment                         = 0;
 
+  // Incremented whenever cached task settings (e.g. task or value names) change
+  uint32_t     taskCacheVersion                             = 0;
+
 
   bool activeTaskUseSerial0 = false;
 };
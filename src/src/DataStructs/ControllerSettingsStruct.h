@@ -97,6 +97,7 @@ struct ControllerSettingsStruct
 #if FEATURE_MQTT
     CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT,
     CONTROLLER_RETAINFLAG,
+    CONTROLLER_MQTT_BATCH_JSON,
 #endif
     CONTROLLER_SUBSCRIBE,
     CONTROLLER_PUBLISH,
@@ -164,6 +165,9 @@ struct ControllerSettingsStruct
   bool         mqtt_retainFlag() const { return VariousBits1.mqtt_retainFlag; }
   void         mqtt_retainFlag(bool value) { VariousBits1.mqtt_retainFlag = value; }
 
+  bool         mqtt_batchJSON() const { return VariousBits1.mqtt_batchJSON; }
+  void         mqtt_batchJSON(bool value) { VariousBits1.mqtt_batchJSON = value; }
+
   bool         useExtendedCredentials() const { return VariousBits1.useExtendedCredentials; }
   void         useExtendedCredentials(bool value) { VariousBits1.useExtendedCredentials = value; }
 
@@ -223,7 +227,7 @@ struct ControllerSettingsStruct
     uint32_t deduplicate                      : 1; // Bit 10
     uint32_t useLocalSystemTime               : 1; // Bit 11
     uint32_t TLStype                          : 4; // Bit 12...15: TLS type
-    uint32_t unused_16                        : 1; // Bit 16
+    uint32_t mqtt_batchJSON                   : 1; // Bit 16
     uint32_t unused_17                        : 1; // Bit 17
     uint32_t unused_18                        : 1; // Bit 18
     uint32_t unused_19                        : 1; // Bit 19
@@ -0,0 +1,339 @@
+#include "../DataStructs/DeferredLogLine.h"
+
+#include "../Helpers/StringConverter.h"
+#include "../Helpers/StringConverter_Numerical.h"
+
+// Argument types
+#define DEFERRED_LOG_ARG_INT32   'i'
+#define DEFERRED_LOG_ARG_UINT32  'u'
+#define DEFERRED_LOG_ARG_INT64   'I'
+#define DEFERRED_LOG_ARG_UINT64  'U'
+#define DEFERRED_LOG_ARG_DOUBLE  'd'
+#define DEFERRED_LOG_ARG_STRING  's'
+
+static_assert(DEFERRED_LOG_LINE_MAX_SIZE > sizeof(const char *) + 2, "DEFERRED_LOG_LINE_MAX_SIZE too small");
+
+DeferredLogLine::DeferredLogLine(const __FlashStringHelper *format)
+{
+  const char *fmt = reinterpret_cast<const char *>(format);
+
+  memcpy(_data, &fmt, sizeof(fmt));
+  _size = sizeof(fmt);
+}
+
+void DeferredLogLine::add(const char *str)
+{
+  if (str == nullptr) {
+    addString(str, 0);
+  } else {
+    addString(str, strlen_P(str));
+  }
+}
+
+void DeferredLogLine::add(const String& str)
+{
+  addString(str.c_str(), str.length());
+}
+
+void DeferredLogLine::add(const __FlashStringHelper *str)
+{
+  add(reinterpret_cast<const char *>(str));
+}
+
+void DeferredLogLine::addInt32(int32_t value)
+{
+  addValue(DEFERRED_LOG_ARG_INT32, &value, sizeof(value));
+}
+
+void DeferredLogLine::addUInt32(uint32_t value)
+{
+  addValue(DEFERRED_LOG_ARG_UINT32, &value, sizeof(value));
+}
+
+void DeferredLogLine::addInt64(int64_t value)
+{
+  addValue(DEFERRED_LOG_ARG_INT64, &value, sizeof(value));
+}
+
+void DeferredLogLine::addUInt64(uint64_t value)
+{
+  addValue(DEFERRED_LOG_ARG_UINT64, &value, sizeof(value));
+}
+
+void DeferredLogLine::addDouble(double value)
+{
+  addValue(DEFERRED_LOG_ARG_DOUBLE, &value, sizeof(value));
+}
+
+void DeferredLogLine::addValue(char type, const void *value, size_t size)
+{
+  if ((_size + 1 + size) > sizeof(_data)) {
+    return;
+  }
+  _data[_size++] = type;
+  memcpy(_data + _size, value, size);
+  _size += size;
+}
+
+void DeferredLogLine::addString(const char *str, size_t length)
+{
+  if ((_size + 2) > sizeof(_data)) {
+    return;
+  }
+  const size_t maxLength = _min(sizeof(_data) - _size - 2, static_cast<size_t>(255));
+
+  if (length > maxLength) {
+    length = maxLength;
+  }
+  _data[_size++] = DEFERRED_LOG_ARG_STRING;
+  _data[_size++] = static_cast<uint8_t>(length);
+
+  if (length != 0) {
+    memcpy_P(_data + _size, str, length);
+    _size += length;
+  }
+}
+
+namespace {
+struct DeferredLogArg {
+  char        type     = 0;
+  int64_t     intValue = 0;  // All integer types, except UINT64
+  uint64_t    uintValue = 0; // UINT64
+  double      doubleValue = 0.0;
+  const char *str       = nullptr;
+  size_t      length    = 0;
+
+  bool is64bit() const {
+    return type == DEFERRED_LOG_ARG_INT64 || type == DEFERRED_LOG_ARG_UINT64;
+  }
+
+  int64_t asInt64() const {
+    if (type == DEFERRED_LOG_ARG_UINT64) { return static_cast<int64_t>(uintValue); }
+
+    if (type == DEFERRED_LOG_ARG_DOUBLE) { return static_cast<int64_t>(doubleValue); }
+    return intValue;
+  }
+
+  uint64_t asUInt64() const {
+    if (type == DEFERRED_LOG_ARG_UINT64) { return uintValue; }
+
+    if (type == DEFERRED_LOG_ARG_DOUBLE) { return static_cast<uint64_t>(doubleValue); }
+    return static_cast<uint64_t>(intValue);
+  }
+
+  double asDouble() const {
+    if (type == DEFERRED_LOG_ARG_DOUBLE) { return doubleValue; }
+
+    if (type == DEFERRED_LOG_ARG_UINT64) { return static_cast<double>(uintValue); }
+    return static_cast<double>(intValue);
+  }
+};
+
+template<typename T>
+bool readValue(const uint8_t *data, size_t size, size_t& pos, T& value)
+{
+  if ((pos + sizeof(T)) > size) {
+    return false;
+  }
+  memcpy(&value, data + pos, sizeof(T));
+  pos += sizeof(T);
+  return true;
+}
+
+// Read the next argument, return false when there are no more arguments.
+bool readArg(const uint8_t *data, size_t size, size_t& pos, DeferredLogArg& arg)
+{
+  if (pos >= size) {
+    return false;
+  }
+  arg.type = static_cast<char>(data[pos++]);
+
+  switch (arg.type) {
+    case DEFERRED_LOG_ARG_INT32:
+    {
+      int32_t value{};
+
+      if (!readValue(data, size, pos, value)) { return false; }
+      arg.intValue = value;
+      return true;
+    }
+    case DEFERRED_LOG_ARG_UINT32:
+    {
+      uint32_t value{};
+
+      if (!readValue(data, size, pos, value)) { return false; }
+      arg.intValue = value;
+      return true;
+    }
+    case DEFERRED_LOG_ARG_INT64:
+      return readValue(data, size, pos, arg.intValue);
+    case DEFERRED_LOG_ARG_UINT64:
+      return readValue(data, size, pos, arg.uintValue);
+    case DEFERRED_LOG_ARG_DOUBLE:
+      return readValue(data, size, pos, arg.doubleValue);
+    case DEFERRED_LOG_ARG_STRING:
+
+      if (pos >= size) { return false; }
+      arg.length = data[pos++];
+
+      if ((pos + arg.length) > size) { return false; }
+      arg.str = reinterpret_cast<const char *>(data + pos);
+      pos    += arg.length;
+      return true;
+  }
+  return false;
+}
+
+// Text of a numerical argument used for %s
+String argToString(const DeferredLogArg& arg)
+{
+  switch (arg.type) {
+    case DEFERRED_LOG_ARG_UINT64: return ull2String(arg.uintValue);
+    case DEFERRED_LOG_ARG_DOUBLE: return doubleToString(arg.doubleValue, 6, true);
+  }
+  return ll2String(arg.intValue);
+}
+} // namespace
+
+String DeferredLogLine::format(const uint8_t *data, size_t size)
+{
+  String res;
+  const char *fmt = nullptr;
+
+  if (size < sizeof(fmt)) {
+    return res;
+  }
+  memcpy(&fmt, data, sizeof(fmt));
+
+  if (fmt == nullptr) {
+    return res;
+  }
+  size_t pos = sizeof(fmt);
+
+  if (!reserve_special(res, strlen_P(fmt) + size)) {
+    return res;
+  }
+
+  // Format specification, with the length modifier and conversion set per argument type
+  char spec[16];
+  char out[DEFERRED_LOG_LINE_MAX_SIZE + 32];
+  char c = pgm_read_byte(fmt++);
+
+  while (c != '\0') {
+    if (c != '%') {
+      res += c;
+      c    = pgm_read_byte(fmt++);
+      continue;
+    }
+    size_t specLength = 0;
+    spec[specLength++] = '%';
+    c                  = pgm_read_byte(fmt++);
+
+    // Flags, width and precision
+    while (c != '\0' && strchr("-+ #0123456789.", c) != nullptr) {
+      if (specLength < (sizeof(spec) - 3)) {
+        spec[specLength++] = c;
+      }
+      c = pgm_read_byte(fmt++);
+    }
+
+    // Length modifiers are ignored, the stored argument type is used instead.
+    while (c != '\0' && strchr("hlLqjzt", c) != nullptr) {
+      c = pgm_read_byte(fmt++);
+    }
+
+    if (c == '\0') {
+      break;
+    }
+    const char conversion = c;
+    c = pgm_read_byte(fmt++);
+
+    if (conversion == '%') {
+      res += '%';
+      continue;
+    }
+    DeferredLogArg arg;
+
+    if (!readArg(data, size, pos, arg)) {
+      // Missing argument
+      continue;
+    }
+
+    out[0] = '\0';
+
+    switch (conversion) {
+      case 'd':
+      case 'i':
+
+        if (arg.is64bit()) {
+          res += ll2String(arg.asInt64());
+        } else {
+          spec[specLength++] = 'l';
+          spec[specLength++] = 'd';
+          spec[specLength]   = '\0';
+          snprintf(out, sizeof(out), spec, static_cast<long>(arg.asInt64()));
+        }
+        break;
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'o':
+      case 'p':
+
+        if (arg.is64bit()) {
+          const uint8_t base = (conversion == 'u') ? 10 : ((conversion == 'o') ? 8 : 16);
+          String value       = ull2String(arg.asUInt64(), base);
+
+          if (conversion == 'X') {
+            value.toUpperCase();
+          }
+          res += value;
+        } else {
+          spec[specLength++] = 'l';
+          spec[specLength++] = (conversion == 'p') ? 'x' : conversion;
+          spec[specLength]   = '\0';
+          snprintf(out, sizeof(out), spec, static_cast<unsigned long>(static_cast<uint32_t>(arg.asUInt64())));
+        }
+        break;
+      case 'c':
+        spec[specLength++] = 'c';
+        spec[specLength]   = '\0';
+        snprintf(out, sizeof(out), spec, static_cast<int>(arg.asInt64()));
+        break;
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'E':
+      case 'g':
+      case 'G':
+        spec[specLength++] = conversion;
+        spec[specLength]   = '\0';
+        snprintf(out, sizeof(out), spec, arg.asDouble());
+        break;
+      case 's':
+      {
+        if (arg.type != DEFERRED_LOG_ARG_STRING) {
+          res += argToString(arg);
+        } else if (specLength == 1) {
+          // No width or precision, append as-is
+          res.concat(arg.str, arg.length);
+        } else {
+          char str[DEFERRED_LOG_LINE_MAX_SIZE];
+          const size_t length = _min(arg.length, sizeof(str) - 1);
+
+          memcpy(str, arg.str, length);
+          str[length]        = '\0';
+          spec[specLength++] = 's';
+          spec[specLength]   = '\0';
+          snprintf(out, sizeof(out), spec, str);
+        }
+        break;
+      }
+      default:
+        // Unsupported conversion, argument is skipped
+        break;
+    }
+    res += out;
+  }
+  return res;
+}
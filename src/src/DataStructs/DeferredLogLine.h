@@ -0,0 +1,104 @@
+#ifndef DATASTRUCTS_DEFERREDLOGLINE_H
+#define DATASTRUCTS_DEFERREDLOGLINE_H
+
+
+#include "../../ESPEasy_common.h"
+
+#include <type_traits>
+
+// Max. size of an encoded log line: format string pointer + packed arguments.
+#ifndef DEFERRED_LOG_LINE_MAX_SIZE
+  #define DEFERRED_LOG_LINE_MAX_SIZE 128
+#endif
+
+/*********************************************************************************************\
+ * DeferredLogLine
+ * Compact binary form of a log line, as used by addLogFormat():
+ * a pointer to the printf-style format string in flash, followed by the packed arguments.
+ * Each argument is stored as a type byte followed by its value.
+ * Strings are copied (length byte + text) as they may no longer exist when the line is formatted.
+ * Arguments which do not fit in DEFERRED_LOG_LINE_MAX_SIZE are truncated (strings) or left out.
+ *
+ * The text is only created by format() when a log destination processes the line.
+ * Length modifiers (l, ll, h, z, ...) in the format string are ignored,
+ * the value is formatted according to the stored argument type.
+\*********************************************************************************************/
+class DeferredLogLine {
+public:
+
+  explicit DeferredLogLine(const __FlashStringHelper *format);
+
+  template<typename T>
+  typename std::enable_if<std::is_integral<T>::value>::type
+  add(T value) {
+    if (sizeof(T) > sizeof(int32_t)) {
+      if (std::is_signed<T>::value) {
+        addInt64(static_cast<int64_t>(value));
+      } else {
+        addUInt64(static_cast<uint64_t>(value));
+      }
+    } else if (std::is_signed<T>::value) {
+      addInt32(static_cast<int32_t>(value));
+    } else {
+      addUInt32(static_cast<uint32_t>(value));
+    }
+  }
+
+  template<typename T>
+  typename std::enable_if<std::is_floating_point<T>::value>::type
+  add(T value) {
+    addDouble(static_cast<double>(value));
+  }
+
+  void add(const char *str);
+  void add(const String& str);
+  void add(const __FlashStringHelper *str);
+
+  void addArgs() {}
+
+  template<typename T, typename ... Args>
+  void addArgs(const T& value, const Args&... args) {
+    add(value);
+    addArgs(args ...);
+  }
+
+  const uint8_t* data() const {
+    return _data;
+  }
+
+  size_t size() const {
+    return _size;
+  }
+
+  String toString() const {
+    return format(_data, _size);
+  }
+
+  // Create the text of an encoded log line.
+  static String format(const uint8_t *data,
+                       size_t         size);
+
+private:
+
+  void addInt32(int32_t value);
+  void addUInt32(uint32_t value);
+  void addInt64(int64_t value);
+  void addUInt64(uint64_t value);
+  void addDouble(double value);
+
+  // Store type byte + value, when it fits.
+  void addValue(char        type,
+                const void *value,
+                size_t      size);
+
+  // Store type byte + length byte + text, truncated to fit.
+  // str may be stored in flash.
+  void addString(const char *str,
+                 size_t      length);
+
+  uint8_t _data[DEFERRED_LOG_LINE_MAX_SIZE];
+  size_t  _size = 0;
+};
+
+
+#endif // DATASTRUCTS_DEFERREDLOGLINE_H
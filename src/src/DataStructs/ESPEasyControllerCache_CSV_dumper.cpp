@@ -132,7 +132,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
 
   // Fetch samples from Cache Controller bin files.
   if (_element_processed) {
-    if (!C016_getTaskSample(_element)) {
+    if (!getNextSample()) {
       return !_outputLine.line.isEmpty();
     }
     _outputLine.markEnd();
@@ -204,7 +204,7 @@ bool ESPEasyControllerCache_CSV_dumper::createCSVLine()
       ++csv_values_left;
     }
     _outputLine.markEnd();
-    _element_processed = !C016_getTaskSample(_element);
+    _element_processed = !getNextSample();
   }
 
   if (csv_values_left > 0) {
@@ -217,6 +217,66 @@ void ESPEasyControllerCache_CSV_dumper::setPeekFilePos(int peekFileNr, int peekR
 {
   ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
   _element_processed = true;
+  _filterFileNr      = -1;
+}
+
+void ESPEasyControllerCache_CSV_dumper::setFilter(uint32_t from, uint32_t to, taskIndex_t taskIndex)
+{
+  _filterActive = true;
+  _filterFrom   = from;
+  _filterTo     = to;
+  _filterTask   = validTaskIndex(taskIndex) ? taskIndex : INVALID_TASK_INDEX;
+  _filterFileNr = -1;
+
+  if (validTaskIndex(_filterTask)) {
+    for (size_t task = 0; validTaskIndex(task); ++task) {
+      _includeTask[task] = (task == _filterTask);
+    }
+  }
+}
+
+bool ESPEasyControllerCache_CSV_dumper::getNextSample()
+{
+  if (!_filterActive) {
+    return C016_getTaskSample(_element);
+  }
+
+  while (true) {
+    int peekFileNr = 0;
+    ControllerCache.getPeekFilePos(peekFileNr);
+
+    if (peekFileNr != _filterFileNr) {
+      // Moved to another file, skip files without matching samples.
+      if (!C016_seekCacheSample(peekFileNr, _filterFrom, _filterTo, _filterTask, _filterFileIndex)) {
+        return false;
+      }
+      _filterFileNr = peekFileNr;
+    }
+
+    if (!C016_getTaskSample(_element)) {
+      return false;
+    }
+    const uint32_t unixTime = static_cast<uint32_t>(_element.unixTime);
+
+    if ((unixTime > _filterTo) && _filterFileIndex.sorted) {
+      // No more matching samples in this file
+      int nextFileNr = _filterFileNr + 1;
+
+      if (_filterFileIndex.complete &&
+          C016_seekCacheSample(nextFileNr, _filterFrom, _filterTo, _filterTask, _filterFileIndex)) {
+        _filterFileNr = nextFileNr;
+        continue;
+      }
+      return false;
+    }
+
+    if ((unixTime >= _filterFrom) &&
+        (unixTime <= _filterTo) &&
+        (!validTaskIndex(_filterTask) || (_element.TaskIndex == _filterTask))) {
+      return true;
+    }
+  }
+  return false;
 }
 
 void ESPEasyControllerCache_CSV_dumper::flushValuesLeft(uint32_t csv_values_left)
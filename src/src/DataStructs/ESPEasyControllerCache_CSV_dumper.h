@@ -7,6 +7,7 @@
 #if FEATURE_RTC_CACHE_STORAGE
 
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ESPEasyControllerCache_FileIndex.h"
 
 struct ESPEasyControllerCache_CSV_element {
   void markBegin();
@@ -32,6 +33,13 @@ struct ESPEasyControllerCache_CSV_dumper {
 
   ~ESPEasyControllerCache_CSV_dumper();
 
+  // Only export samples within the time range (inclusive) and optionally only for a single task.
+  // Cache files without matching samples are skipped using the file index.
+  // Must be called before generating the CSV header.
+  void   setFilter(uint32_t    from,
+                   uint32_t    to,
+                   taskIndex_t taskIndex);
+
   size_t generateCSVHeader(bool send) const;
 
   bool   createCSVLine();
@@ -61,6 +69,9 @@ private:
 
   void     flushValuesLeft(uint32_t csv_values_left);
 
+  // Fetch the next sample matching the filter
+  bool     getNextSample();
+
   String  _csv_values[VARS_PER_TASK * TASKS_MAX];
   uint8_t _nrDecimals[VARS_PER_TASK * TASKS_MAX] = { 0 };
   bool    _includeTask[TASKS_MAX]                = { 0 };
@@ -77,6 +88,13 @@ private:
   int _backup_peekFileNr  = 0;
   int _backup_peekFilePos = 0;
 
+  bool                      _filterActive = false;
+  uint32_t                  _filterFrom   = 0;
+  uint32_t                  _filterTo     = 0;
+  taskIndex_t               _filterTask   = INVALID_TASK_INDEX;
+  int                       _filterFileNr = -1;
+  ControllerCache_FileIndex _filterFileIndex;
+
   Target _target = Target::CSV_file;
 };
 #endif // if FEATURE_RTC_CACHE_STORAGE
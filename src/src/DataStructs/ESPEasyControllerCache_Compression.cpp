@@ -0,0 +1,347 @@
+#include "../DataStructs/ESPEasyControllerCache_Compression.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+static_assert(VARS_PER_TASK <= 4, "Only 4 bits available to mark changed values");
+
+# define CONTROLLER_CACHE_FLAG_META  0x01
+
+const uint8_t controllerCacheCompressedHeader[CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE] PROGMEM =
+{ 'C', '0', '1', '6', 'Z', 1, 0, 0 };
+
+
+ControllerCache_TaskState* ControllerCache_findTaskState(std::vector<ControllerCache_TaskState>& states,
+                                                         taskIndex_t                             TaskIndex)
+{
+  for (auto it = states.begin(); it != states.end(); ++it) {
+    if (it->TaskIndex == TaskIndex) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+bool ControllerCache_isCompressedFile(fs::File& file)
+{
+  uint8_t header[CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE]{};
+
+  if (file.seek(0) &&
+      (file.read(header, sizeof(header)) == sizeof(header)) &&
+      (memcmp_P(header, controllerCacheCompressedHeader, sizeof(header)) == 0)) {
+    return true;
+  }
+  file.seek(0);
+  return false;
+}
+
+# if FEATURE_RTC_CACHE_COMPRESSION
+
+bool ControllerCache_writeCompressedHeader(fs::File& file)
+{
+  uint8_t header[CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE];
+
+  memcpy_P(header, controllerCacheCompressedHeader, sizeof(header));
+  return file.write(header, sizeof(header)) == sizeof(header);
+}
+
+void ControllerCache_appendVarint(std::vector<uint8_t>& block, uint32_t value)
+{
+  while (value >= 0x80) {
+    block.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  block.push_back(static_cast<uint8_t>(value));
+}
+
+void ControllerCache_appendXOR(std::vector<uint8_t>& block, uint32_t value)
+{
+  // value is never 0, as only changed values are stored.
+  uint8_t leading = 0;
+
+  while (leading < 3 && ((value >> (24 - 8 * leading)) & 0xFF) == 0) {
+    ++leading;
+  }
+  uint8_t trailing = 0;
+
+  while ((leading + trailing) < 3 && ((value >> (8 * trailing)) & 0xFF) == 0) {
+    ++trailing;
+  }
+  block.push_back((leading << 4) | trailing);
+
+  for (uint8_t i = trailing; i < (4 - leading); ++i) {
+    block.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+bool ControllerCache_encodeBlock(const uint8_t *data, size_t size, std::vector<uint8_t>& block)
+{
+  const size_t nrSamples = size / sizeof(C016_binary_element);
+
+  if ((nrSamples == 0) || (nrSamples > 255) || ((size % sizeof(C016_binary_element)) != 0)) {
+    return false;
+  }
+
+  block.clear();
+  block.reserve(size + CONTROLLER_CACHE_BLOCK_HEADER_SIZE);
+
+  // Block header is filled in when the payload size is known.
+  block.resize(CONTROLLER_CACHE_BLOCK_HEADER_SIZE, 0);
+
+  std::vector<ControllerCache_TaskState> states;
+  uint32_t prevTime = 0;
+
+  for (size_t i = 0; i < nrSamples; ++i) {
+    C016_binary_element element;
+    memcpy(reinterpret_cast<uint8_t *>(&element), data + (i * sizeof(C016_binary_element)), sizeof(C016_binary_element));
+
+    uint8_t flags                    = 0;
+    ControllerCache_TaskState *state = ControllerCache_findTaskState(states, element.TaskIndex);
+
+    if (state == nullptr) {
+      states.emplace_back();
+      state            = &states.back();
+      state->TaskIndex = element.TaskIndex;
+      flags           |= CONTROLLER_CACHE_FLAG_META;
+    } else if ((state->pluginID != element.pluginID.value) ||
+               (state->sensorType != static_cast<uint8_t>(element.sensorType)) ||
+               (state->valueCount != element.valueCount)) {
+      flags |= CONTROLLER_CACHE_FLAG_META;
+    }
+
+    uint32_t values[VARS_PER_TASK];
+    memcpy(values, element.values.binary, sizeof(values));
+
+    for (uint8_t v = 0; v < VARS_PER_TASK; ++v) {
+      if (values[v] != state->values[v]) {
+        flags |= (0x10 << v);
+      }
+    }
+
+    block.push_back(element.TaskIndex);
+    block.push_back(flags);
+
+    // Zigzag encoding, so small negative differences also take few bytes.
+    const uint32_t unixTime = static_cast<uint32_t>(element.unixTime);
+    const int32_t  delta    = static_cast<int32_t>(unixTime - prevTime);
+    ControllerCache_appendVarint(block, (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31));
+    prevTime = unixTime;
+
+    if (flags & CONTROLLER_CACHE_FLAG_META) {
+      state->pluginID   = element.pluginID.value;
+      state->sensorType = static_cast<uint8_t>(element.sensorType);
+      state->valueCount = element.valueCount;
+      block.push_back(state->pluginID);
+      block.push_back(state->sensorType);
+      block.push_back(state->valueCount);
+    }
+
+    for (uint8_t v = 0; v < VARS_PER_TASK; ++v) {
+      if (flags & (0x10 << v)) {
+        ControllerCache_appendXOR(block, values[v] ^ state->values[v]);
+        state->values[v] = values[v];
+      }
+    }
+  }
+
+  const size_t payloadSize = block.size() - CONTROLLER_CACHE_BLOCK_HEADER_SIZE;
+
+  if (payloadSize > 0xFFFF) {
+    return false;
+  }
+  block[0] = static_cast<uint8_t>(payloadSize & 0xFF);
+  block[1] = static_cast<uint8_t>(payloadSize >> 8);
+  block[2] = static_cast<uint8_t>(nrSamples);
+  return true;
+}
+
+# endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+
+void ControllerCache_Decoder::reset()
+{
+  _block.clear();
+  _taskStates.clear();
+  _blockStart  = CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE;
+  _blockPos    = 0;
+  _samplesLeft = 0;
+  _blockLoaded = false;
+  _unixTime    = 0;
+}
+
+bool ControllerCache_Decoder::read(fs::File& file, C016_binary_element& element)
+{
+  while (!_blockLoaded || (_samplesLeft == 0)) {
+    const uint32_t nextBlock = _blockLoaded
+                               ? _blockStart + CONTROLLER_CACHE_BLOCK_HEADER_SIZE + _block.size()
+                               : _blockStart;
+
+    if (!loadBlock(file, nextBlock)) {
+      return false;
+    }
+  }
+
+  if (!decodeSample(element)) {
+    // Corrupt block, skip the rest of it.
+    _samplesLeft = 0;
+    _blockPos    = _block.size();
+    return false;
+  }
+  return true;
+}
+
+bool ControllerCache_Decoder::seek(fs::File& file, uint32_t position)
+{
+  reset();
+
+  // Walk the block headers to find the block containing the position.
+  uint32_t blockStart = CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE;
+
+  while (blockStart < position) {
+    uint8_t header[CONTROLLER_CACHE_BLOCK_HEADER_SIZE];
+
+    if (!file.seek(blockStart) || (file.read(header, sizeof(header)) != sizeof(header))) {
+      break;
+    }
+    const uint32_t blockEnd = blockStart + CONTROLLER_CACHE_BLOCK_HEADER_SIZE + (header[0] | (header[1] << 8));
+
+    if (position < blockEnd) {
+      if (!loadBlock(file, blockStart)) {
+        return false;
+      }
+      C016_binary_element element;
+
+      while (this->position() < position && _samplesLeft > 0) {
+        if (!decodeSample(element)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    blockStart = blockEnd;
+  }
+  _blockStart = blockStart;
+  return true;
+}
+
+uint32_t ControllerCache_Decoder::position() const
+{
+  if (!_blockLoaded) {
+    return _blockStart;
+  }
+  return _blockStart + CONTROLLER_CACHE_BLOCK_HEADER_SIZE + _blockPos;
+}
+
+bool ControllerCache_Decoder::loadBlock(fs::File& file, uint32_t blockStart)
+{
+  uint8_t header[CONTROLLER_CACHE_BLOCK_HEADER_SIZE];
+
+  if (!file.seek(blockStart) || (file.read(header, sizeof(header)) != sizeof(header))) {
+    return false;
+  }
+  const size_t payloadSize = header[0] | (header[1] << 8);
+  std::vector<uint8_t> block;
+
+  block.resize(payloadSize);
+
+  if ((payloadSize != 0) && (file.read(&block[0], payloadSize) != payloadSize)) {
+    // Block is not complete
+    return false;
+  }
+  _block.swap(block);
+  _blockStart  = blockStart;
+  _blockPos    = 0;
+  _samplesLeft = header[2];
+  _blockLoaded = true;
+  _unixTime    = 0;
+  _taskStates.clear();
+  return true;
+}
+
+bool ControllerCache_Decoder::getByte(uint8_t& value)
+{
+  if (_blockPos >= _block.size()) {
+    return false;
+  }
+  value = _block[_blockPos];
+  ++_blockPos;
+  return true;
+}
+
+bool ControllerCache_Decoder::decodeSample(C016_binary_element& element)
+{
+  uint8_t TaskIndex = 0;
+  uint8_t flags     = 0;
+
+  if (!getByte(TaskIndex) || !getByte(flags)) {
+    return false;
+  }
+
+  ControllerCache_TaskState *state = ControllerCache_findTaskState(_taskStates, TaskIndex);
+
+  if (state == nullptr) {
+    if (!(flags & CONTROLLER_CACHE_FLAG_META)) {
+      return false;
+    }
+    _taskStates.emplace_back();
+    state            = &_taskStates.back();
+    state->TaskIndex = TaskIndex;
+  }
+
+  uint32_t zigzag = 0;
+  uint8_t  b      = 0;
+
+  for (uint8_t shift = 0; ; shift += 7) {
+    if ((shift > 28) || !getByte(b)) {
+      return false;
+    }
+    zigzag |= static_cast<uint32_t>(b & 0x7F) << shift;
+
+    if ((b & 0x80) == 0) {
+      break;
+    }
+  }
+  const int32_t delta = static_cast<int32_t>(zigzag >> 1) ^ -static_cast<int32_t>(zigzag & 1);
+  _unixTime += static_cast<uint32_t>(delta);
+
+  if (flags & CONTROLLER_CACHE_FLAG_META) {
+    if (!getByte(state->pluginID) || !getByte(state->sensorType) || !getByte(state->valueCount)) {
+      return false;
+    }
+  }
+
+  for (uint8_t v = 0; v < VARS_PER_TASK; ++v) {
+    if (flags & (0x10 << v)) {
+      uint8_t control = 0;
+
+      if (!getByte(control)) {
+        return false;
+      }
+      const uint8_t leading  = control >> 4;
+      const uint8_t trailing = control & 0x0F;
+
+      if ((leading + trailing) > 3) {
+        return false;
+      }
+      uint32_t value = 0;
+
+      for (uint8_t i = trailing; i < (4 - leading); ++i) {
+        if (!getByte(b)) {
+          return false;
+        }
+        value |= static_cast<uint32_t>(b) << (8 * i);
+      }
+      state->values[v] ^= value;
+    }
+  }
+
+  element.unixTime       = _unixTime;
+  element.TaskIndex      = TaskIndex;
+  element.pluginID.value = state->pluginID;
+  element.sensorType     = static_cast<Sensor_VType>(state->sensorType);
+  element.valueCount     = state->valueCount;
+  memcpy(element.values.binary, state->values, sizeof(state->values));
+  --_samplesLeft;
+  return true;
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
@@ -0,0 +1,103 @@
+#ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_COMPRESSION_H
+#define DATASTRUCTS_ESPEASYCONTROLLERCACHE_COMPRESSION_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../ControllerQueue/C016_queue_element.h"
+
+# include <FS.h>
+# include <vector>
+
+/*********************************************************************************************\
+* Compressed format of the controller cache files
+*
+* A compressed file starts with a header of CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE bytes,
+* followed by blocks. Each flush of the RTC buffer results in a single block:
+*   - uint16_t  payload length (little endian)
+*   - uint8_t   nr of samples
+*   - payload
+*
+* Every block can be decoded on its own. Per sample:
+*   - TaskIndex
+*   - flags: bit 0 set when plugin ID, sensor type and value count follow,
+*            bit 4 ... 7 set for each value which differs from the previous sample of the same task
+*   - varint with the zigzag encoded difference in unixTime with the previous sample
+*   - plugin ID, sensor type, value count (only for the first sample of a task in a block)
+*   - per changed value: XOR with the previous value of the task,
+*     stored as a byte with (nr leading zero bytes << 4 | nr trailing zero bytes), followed by the remaining bytes.
+*
+* Decoding is always included, so cache files written by a build with
+* FEATURE_RTC_CACHE_COMPRESSION can be read by all builds with the cache controller.
+*
+* The host side reader misc/CacheController/ESPEasyCacheReader.h implements the same decoder.
+* When changing this format, also update that reader and its tests in misc/CacheController/test.
+\*********************************************************************************************/
+
+# define CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE  8
+# define CONTROLLER_CACHE_BLOCK_HEADER_SIZE       3
+
+// Last sample of a task in the current block, used as reference for the next sample of that task.
+struct ControllerCache_TaskState {
+  taskIndex_t TaskIndex              = INVALID_TASK_INDEX;
+  uint8_t     pluginID               = 0;
+  uint8_t     sensorType             = 0;
+  uint8_t     valueCount             = 0;
+  uint32_t    values[VARS_PER_TASK]  = { 0 };
+};
+
+// Check whether the file starts with the header of a compressed cache file.
+// The file position is set to the first block when compressed, or to the start of the file when not.
+bool ControllerCache_isCompressedFile(fs::File& file);
+
+# if FEATURE_RTC_CACHE_COMPRESSION
+
+// Write the header for a new compressed cache file.
+bool ControllerCache_writeCompressedHeader(fs::File& file);
+
+// Encode raw C016_binary_element samples into a single block, including the block header.
+bool ControllerCache_encodeBlock(const uint8_t        *data,
+                                 size_t                size,
+                                 std::vector<uint8_t>& block);
+# endif // if FEATURE_RTC_CACHE_COMPRESSION
+
+
+struct ControllerCache_Decoder {
+  // Start decoding at the first block of a compressed file.
+  void     reset();
+
+  // Decode the next sample.
+  bool     read(fs::File           & file,
+                C016_binary_element& element);
+
+  // Continue decoding from a position returned by position()
+  bool     seek(fs::File& file,
+                uint32_t  position);
+
+  // Position in the file right after the last decoded sample.
+  // Positions in compressed files are only valid for seek() on the same file.
+  uint32_t position() const;
+
+private:
+
+  bool loadBlock(fs::File& file,
+                 uint32_t  blockStart);
+
+  std::vector<uint8_t>_block;
+  uint32_t            _blockStart  = CONTROLLER_CACHE_COMPRESSED_HEADER_SIZE;
+  size_t              _blockPos    = 0;
+  uint8_t             _samplesLeft = 0;
+  bool                _blockLoaded = false;
+
+  bool getByte(uint8_t& value);
+
+  bool decodeSample(C016_binary_element& element);
+
+  std::vector<ControllerCache_TaskState>_taskStates;
+  uint32_t                              _unixTime = 0;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_COMPRESSION_H
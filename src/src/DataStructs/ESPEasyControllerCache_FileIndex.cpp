@@ -0,0 +1,143 @@
+#include "../DataStructs/ESPEasyControllerCache_FileIndex.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# define CONTROLLER_CACHE_INDEX_READ_SAMPLES  8
+
+bool ControllerCache_FileIndex::build(fs::File& file)
+{
+  *this = ControllerCache_FileIndex();
+
+  if (!file || !file.seek(0)) {
+    return false;
+  }
+  fileSize   = file.size();
+  compressed = ControllerCache_isCompressedFile(file);
+
+  C016_binary_element elements[CONTROLLER_CACHE_INDEX_READ_SAMPLES];
+  size_t bytesRead = 0;
+  ControllerCache_Decoder decoder;
+
+  do {
+    size_t nrRead = 0;
+
+    if (compressed) {
+      while (nrRead < CONTROLLER_CACHE_INDEX_READ_SAMPLES && decoder.read(file, elements[nrRead])) {
+        ++nrRead;
+      }
+      bytesRead = nrRead * sizeof(C016_binary_element);
+    } else {
+      bytesRead = file.read(reinterpret_cast<uint8_t *>(&elements[0]), sizeof(elements));
+      nrRead    = bytesRead / sizeof(C016_binary_element);
+    }
+
+    for (size_t i = 0; i < nrRead; ++i) {
+      const uint32_t unixTime = static_cast<uint32_t>(elements[i].unixTime);
+
+      if (nrSamples == 0) {
+        firstSampleTime = unixTime;
+        minTime         = unixTime;
+        maxTime         = unixTime;
+      } else {
+        if (unixTime < maxTime) {
+          sorted = false;
+        }
+
+        if (unixTime < minTime) { minTime = unixTime; }
+
+        if (unixTime > maxTime) { maxTime = unixTime; }
+      }
+
+      if (validTaskIndex(elements[i].TaskIndex)) {
+        tasks.set(elements[i].TaskIndex);
+      }
+      ++nrSamples;
+    }
+    delay(0);
+  } while (bytesRead == sizeof(elements));
+
+  return true;
+}
+
+bool ControllerCache_FileIndex::isValidFor(fs::File& file) const
+{
+  if (!file || (file.size() != fileSize)) {
+    return false;
+  }
+
+  if (nrSamples == 0) {
+    return true;
+  }
+  C016_binary_element element;
+
+  return readFirstSample(file, element) &&
+         (static_cast<uint32_t>(element.unixTime) == firstSampleTime);
+}
+
+bool ControllerCache_FileIndex::mayContain(uint32_t from, uint32_t to, taskIndex_t taskIndex) const
+{
+  if ((nrSamples == 0) || (maxTime < from) || (minTime > to)) {
+    return false;
+  }
+  return !validTaskIndex(taskIndex) || tasks.test(taskIndex);
+}
+
+uint32_t ControllerCache_FileIndex::findOffset(fs::File& file, uint32_t from) const
+{
+  if (!sorted || (from <= minTime)) {
+    return 0;
+  }
+
+  if (compressed) {
+    ControllerCache_Decoder decoder;
+    C016_binary_element     element;
+    uint32_t offset = decoder.position();
+
+    while (decoder.read(file, element)) {
+      if (static_cast<uint32_t>(element.unixTime) >= from) {
+        return offset;
+      }
+      offset = decoder.position();
+    }
+    return offset;
+  }
+
+  // Binary search for the first sample with unixTime >= from
+  uint32_t lower = 0;
+  uint32_t upper = nrSamples;
+  C016_binary_element element;
+
+  while (lower < upper) {
+    const uint32_t mid = lower + ((upper - lower) / 2);
+
+    if (!readSample(file, mid, element)) {
+      return 0;
+    }
+
+    if (static_cast<uint32_t>(element.unixTime) < from) {
+      lower = mid + 1;
+    } else {
+      upper = mid;
+    }
+  }
+  return lower * sizeof(C016_binary_element);
+}
+
+bool ControllerCache_FileIndex::readFirstSample(fs::File& file, C016_binary_element& element)
+{
+  if (ControllerCache_isCompressedFile(file)) {
+    ControllerCache_Decoder decoder;
+    return decoder.read(file, element);
+  }
+  return readSample(file, 0, element);
+}
+
+bool ControllerCache_FileIndex::readSample(fs::File& file, uint32_t sampleNr, C016_binary_element& element)
+{
+  if (!file.seek(sampleNr * sizeof(C016_binary_element))) {
+    return false;
+  }
+  return file.read(reinterpret_cast<uint8_t *>(&element), sizeof(element)) == sizeof(element);
+}
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
@@ -0,0 +1,64 @@
+#ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILEINDEX_H
+#define DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILEINDEX_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_RTC_CACHE_STORAGE
+
+# include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/ESPEasyControllerCache_Compression.h"
+
+# include <FS.h>
+# include <bitset>
+
+/*********************************************************************************************\
+* ControllerCache_FileIndex
+* Summary of the samples stored in a single cache file.
+* Used to skip files and seek within a file when only a time range or a single task is needed.
+* The index is kept in RAM, so the format of the cache files does not change.
+\*********************************************************************************************/
+struct ControllerCache_FileIndex {
+  // Read all samples in the file to compute the index.
+  bool     build(fs::File& file);
+
+  // Check whether the file has not been replaced since the index was built.
+  bool     isValidFor(fs::File& file) const;
+
+  // Check whether the file may contain samples for the given time range and task.
+  // Use INVALID_TASK_INDEX to match all tasks.
+  bool     mayContain(uint32_t    from,
+                      uint32_t    to,
+                      taskIndex_t taskIndex) const;
+
+  // Return the offset in the file of the first sample with a timestamp >= from.
+  // When the samples are not in chronological order, the start of the file is returned.
+  // Compressed files are decoded from the start, as the samples differ in size.
+  uint32_t findOffset(fs::File& file,
+                      uint32_t  from) const;
+
+  static bool readSample(fs::File           & file,
+                         uint32_t             sampleNr,
+                         C016_binary_element& element);
+
+  static bool readFirstSample(fs::File           & file,
+                              C016_binary_element& element);
+
+  uint32_t               fileSize        = 0;
+  uint32_t               firstSampleTime = 0;
+  uint32_t               minTime         = 0;
+  uint32_t               maxTime         = 0;
+  uint32_t               nrSamples       = 0;
+  std::bitset<TASKS_MAX> tasks;
+
+  // All samples are stored in chronological order
+  bool sorted = true;
+
+  bool compressed = false;
+
+  // File is no longer being written to, so the index can be kept.
+  bool complete = false;
+};
+
+#endif // if FEATURE_RTC_CACHE_STORAGE
+
+#endif // ifndef DATASTRUCTS_ESPEASYCONTROLLERCACHE_FILEINDEX_H
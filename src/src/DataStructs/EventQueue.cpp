@@ -7,24 +7,27 @@
 #include "../Helpers/StringConverter.h"
 
 
+// Capacity allocated when the first event is queued.
+// When the queue is cleared, larger buffers are released.
+#define EVENT_QUEUE_INITIAL_CAPACITY  8
+
 
 void EventQueueStruct::add(const String& event, bool deduplicate)
 {
-  if (!deduplicate || !isDuplicate(event)) {
+  // Empty strings are used to mark task value events
+  if (!event.length()) { return; }
+
+  const uint32_t hash = computeHash(event);
+
+  if (!deduplicate || !isDuplicate(event, hash)) {
 #if defined(USE_SECOND_HEAP) || defined(ESP32)
     String tmp;
     reserve_special(tmp, event.length());
     tmp = event;
 
-#ifdef USE_SECOND_HEAP
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
-#endif
-
-
-    _eventQueue.emplace_back(std::move(tmp));
+    push(std::move(tmp), hash);
 #else
-    _eventQueue.push_back(event);
+    push(String(event), hash);
 #endif
   }
 }
@@ -40,18 +43,15 @@ void EventQueueStruct::addMove(String&& event, bool deduplicate)
 {
   if (!event.length()) { return; }
 
-  if (!deduplicate || !isDuplicate(event)) {
+  const uint32_t hash = computeHash(event);
+
+  if (!deduplicate || !isDuplicate(event, hash)) {
     #if defined(USE_SECOND_HEAP) || defined(ESP32)
     String tmp;
     move_special(tmp, std::move(event));
-
-    #ifdef USE_SECOND_HEAP
-    // Do not add to the list while on 2nd heap
-    HeapSelectDram ephemeral;
-    #endif
-    _eventQueue.emplace_back(std::move(tmp));
+    push(std::move(tmp), hash);
     #else
-    _eventQueue.emplace_back(std::move(event));
+    push(std::move(event), hash);
     #endif // ifdef USE_SECOND_HEAP
   }
 }
@@ -61,14 +61,14 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const String& varName, const S
   if (Settings.UseRules) {
     if (eventValue.isEmpty()) {
       addMove(strformat(
-        F("%s#%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
+        F("%s#%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
         varName.c_str()));
     } else {
       addMove(strformat(
-        F("%s#%s=%s"), 
-        getTaskDeviceName(TaskIndex).c_str(), 
-        varName.c_str(), 
+        F("%s#%s=%s"),
+        getTaskDeviceName(TaskIndex).c_str(),
+        varName.c_str(),
         eventValue.c_str()));
     }
   }
@@ -95,26 +95,401 @@ void EventQueueStruct::add(taskIndex_t TaskIndex, const __FlashStringHelper *var
   }
 }
 
+void EventQueueStruct::add(const TaskValueEvent& event)
+{
+  if (!Settings.UseRules || !event.isValid()) {
+    return;
+  }
+
+  if (!reserveSlot(String(), 0, &event)) {
+    return;
+  }
+
+  if (!ensureTaskValueCapacity()) {
+    addMove(event.toString());
+    return;
+  }
+  _taskValueEvents[taskValueSlotAt(_taskValueCount)] = event;
+  ++_taskValueCount;
+
+  const uint16_t slot = slotAt(_count);
+
+  free_string(_events[slot]);
+  _hashes[slot] = 0;
+  ++_count;
+
+  if (_count > _peakSize) {
+    _peakSize = _count;
+  }
+}
+
 bool EventQueueStruct::getNext(String& event)
 {
-  if (_eventQueue.empty()) {
+  TaskValueEvent taskValueEvent;
+
+  if (!getNext(event, taskValueEvent)) {
+    return false;
+  }
+
+  if (taskValueEvent.isValid()) {
+    event = taskValueEvent.toString();
+  }
+  return true;
+}
+
+bool EventQueueStruct::getNext(String& event, TaskValueEvent& taskValueEvent)
+{
+  if (_count == 0) {
     return false;
   }
-  event = std::move(_eventQueue.front());
-  _eventQueue.pop_front();
+
+  if (_events[_head].isEmpty()) {
+    taskValueEvent = _taskValueEvents[_taskValueHead];
+    _taskValueHead = taskValueSlotAt(1);
+    --_taskValueCount;
+    free_string(event);
+  } else {
+    taskValueEvent.clear();
+    event = std::move(_events[_head]);
+    indexRemove(_hashes[_head]);
+  }
+  _head = slotAt(1);
+  --_count;
   return true;
 }
 
 void EventQueueStruct::clear()
 {
-  _eventQueue.clear();
+  if (_events.size() > EVENT_QUEUE_INITIAL_CAPACITY) {
+    // Release the memory allocated for a burst of events
+    _events.clear();
+    _events.shrink_to_fit();
+    _hashes.clear();
+    _hashes.shrink_to_fit();
+    _index.clear();
+    _index.shrink_to_fit();
+  } else if (_count != 0) {
+    for (uint16_t pos = 0; pos < _count; ++pos) {
+      free_string(_events[slotAt(pos)]);
+    }
+
+    for (auto it = _index.begin(); it != _index.end(); ++it) {
+      it->_count = 0;
+    }
+  }
+  _head  = 0;
+  _count = 0;
+
+  if (_taskValueEvents.size() > EVENT_QUEUE_INITIAL_CAPACITY) {
+    _taskValueEvents.clear();
+    _taskValueEvents.shrink_to_fit();
+  }
+  _taskValueHead  = 0;
+  _taskValueCount = 0;
 }
 
 bool EventQueueStruct::isEmpty() const
 {
-  return _eventQueue.empty();
+  return _count == 0;
+}
+
+uint32_t EventQueueStruct::computeHash(const String& event)
+{
+  // FNV-1a
+  uint32_t hash       = 2166136261u;
+  const char *str     = event.c_str();
+  const size_t length = event.length();
+
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+bool EventQueueStruct::isDuplicate(const String& event, uint32_t hash) const {
+  if (indexFind(hash) < 0) {
+    return false;
+  }
+
+  for (uint16_t pos = 0; pos < _count; ++pos) {
+    const uint16_t slot = slotAt(pos);
+
+    if ((_hashes[slot] == hash) && (_events[slot] == event)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void EventQueueStruct::push(String&& event, uint32_t hash)
+{
+  // event is only moved when no slot is reserved.
+  if (!reserveSlot(std::move(event), hash, nullptr)) {
+    return;
+  }
+  const uint16_t slot = slotAt(_count);
+
+  _events[slot] = std::move(event);
+  _hashes[slot] = hash;
+  indexAdd(hash);
+  ++_count;
+
+  if (_count > _peakSize) {
+    _peakSize = _count;
+  }
+}
+
+bool EventQueueStruct::reserveSlot(String&& event, uint32_t hash, const TaskValueEvent *taskValueEvent)
+{
+  if (ensureCapacity()) {
+    return true;
+  }
+
+  switch (EVENT_QUEUE_OVERFLOW_POLICY) {
+    case OverflowPolicy::DropOldest:
+    {
+      String oldest;
+      TaskValueEvent oldestTaskValueEvent;
+      getNext(oldest, oldestTaskValueEvent);
+      ++_nrDropped;
+      return true;
+    }
+    case OverflowPolicy::DropNewest:
+      break;
+    case OverflowPolicy::Coalesce:
+    {
+      const bool coalesced = (taskValueEvent == nullptr)
+        ? coalesce(std::move(event), hash)
+        : coalesce(*taskValueEvent);
+
+      if (coalesced) {
+        ++_nrCoalesced;
+        return false;
+      }
+      break;
+    }
+  }
+  ++_nrDropped;
+  return false;
+}
+
+bool EventQueueStruct::coalesce(String&& event, uint32_t hash)
+{
+  const int nameLength = event.indexOf('=');
+
+  // Search from the latest event, as that one will be processed last.
+  for (int pos = static_cast<int>(_count) - 1; pos >= 0; --pos) {
+    const uint16_t slot   = slotAt(pos);
+    const String & queued = _events[slot];
+
+    if (queued.indexOf('=') != nameLength) {
+      continue;
+    }
+    const bool sameName = (nameLength < 0)
+      ? queued.equalsIgnoreCase(event)
+      : (strncasecmp(queued.c_str(), event.c_str(), nameLength) == 0);
+
+    if (sameName) {
+      indexRemove(_hashes[slot]);
+      _events[slot] = std::move(event);
+      _hashes[slot] = hash;
+      indexAdd(hash);
+      return true;
+    }
+  }
+  return false;
 }
 
-bool EventQueueStruct::isDuplicate(const String& event) {
-  return std::find(_eventQueue.begin(), _eventQueue.end(), event) != _eventQueue.end();
+bool EventQueueStruct::coalesce(const TaskValueEvent& event)
+{
+  // Task value events are stored in the same order as their marker in _events
+  uint16_t taskValuePos = _taskValueCount;
+
+  for (int pos = static_cast<int>(_count) - 1; pos >= 0 && taskValuePos > 0; --pos) {
+    if (!_events[slotAt(pos)].isEmpty()) {
+      continue;
+    }
+    --taskValuePos;
+    TaskValueEvent& queued = _taskValueEvents[taskValueSlotAt(taskValuePos)];
+
+    if (queued.sameName(event)) {
+      queued = event;
+      return true;
+    }
+  }
+  return false;
+}
+
+uint16_t EventQueueStruct::slotAt(uint16_t pos) const
+{
+  const uint32_t slot = static_cast<uint32_t>(_head) + pos;
+
+  if (slot >= _events.size()) {
+    return slot - _events.size();
+  }
+  return slot;
+}
+
+bool EventQueueStruct::ensureCapacity()
+{
+  const size_t capacity = _events.size();
+
+  if (_count < capacity) {
+    return true;
+  }
+
+  if (capacity >= EVENT_QUEUE_MAX_DEPTH) {
+    return false;
+  }
+  size_t newCapacity = (capacity == 0) ? EVENT_QUEUE_INITIAL_CAPACITY : 2 * capacity;
+
+  if (newCapacity > EVENT_QUEUE_MAX_DEPTH) {
+    newCapacity = EVENT_QUEUE_MAX_DEPTH;
+  }
+
+  #ifdef USE_SECOND_HEAP
+
+  // Do not allocate the queue itself on 2nd heap
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  std::vector<String>   events(newCapacity);
+  std::vector<uint32_t> hashes(newCapacity);
+
+  for (uint16_t pos = 0; pos < _count; ++pos) {
+    const uint16_t slot = slotAt(pos);
+    events[pos] = std::move(_events[slot]);
+    hashes[pos] = _hashes[slot];
+  }
+  _events.swap(events);
+  _hashes.swap(hashes);
+  _head = 0;
+
+  rebuildIndex();
+  return true;
+}
+
+uint16_t EventQueueStruct::taskValueSlotAt(uint16_t pos) const
+{
+  const uint32_t slot = static_cast<uint32_t>(_taskValueHead) + pos;
+
+  if (slot >= _taskValueEvents.size()) {
+    return slot - _taskValueEvents.size();
+  }
+  return slot;
+}
+
+bool EventQueueStruct::ensureTaskValueCapacity()
+{
+  const size_t capacity = _taskValueEvents.size();
+
+  if (_taskValueCount < capacity) {
+    return true;
+  }
+
+  if (capacity >= EVENT_QUEUE_MAX_DEPTH) {
+    return false;
+  }
+  size_t newCapacity = (capacity == 0) ? EVENT_QUEUE_INITIAL_CAPACITY : 2 * capacity;
+
+  if (newCapacity > EVENT_QUEUE_MAX_DEPTH) {
+    newCapacity = EVENT_QUEUE_MAX_DEPTH;
+  }
+
+  #ifdef USE_SECOND_HEAP
+
+  // Do not allocate the queue itself on 2nd heap
+  HeapSelectDram ephemeral;
+  #endif // ifdef USE_SECOND_HEAP
+
+  std::vector<TaskValueEvent> taskValueEvents(newCapacity);
+
+  for (uint16_t pos = 0; pos < _taskValueCount; ++pos) {
+    taskValueEvents[pos] = _taskValueEvents[taskValueSlotAt(pos)];
+  }
+  _taskValueEvents.swap(taskValueEvents);
+  _taskValueHead = 0;
+  return true;
+}
+
+int32_t EventQueueStruct::indexFind(uint32_t hash) const
+{
+  if (_index.empty()) {
+    return -1;
+  }
+  const uint32_t mask = _index.size() - 1;
+  uint32_t pos        = hash & mask;
+
+  while (_index[pos]._count != 0) {
+    if (_index[pos]._hash == hash) {
+      return pos;
+    }
+    pos = (pos + 1) & mask;
+  }
+  return -1;
+}
+
+void EventQueueStruct::indexAdd(uint32_t hash)
+{
+  const uint32_t mask = _index.size() - 1;
+  uint32_t pos        = hash & mask;
+
+  while (_index[pos]._count != 0) {
+    if (_index[pos]._hash == hash) {
+      ++_index[pos]._count;
+      return;
+    }
+    pos = (pos + 1) & mask;
+  }
+  _index[pos]._hash  = hash;
+  _index[pos]._count = 1;
+}
+
+void EventQueueStruct::indexRemove(uint32_t hash)
+{
+  const int32_t pos = indexFind(hash);
+
+  if (pos < 0) {
+    return;
+  }
+
+  if (--_index[pos]._count != 0) {
+    return;
+  }
+
+  // Backward shift deletion, so no tombstones are needed.
+  const uint32_t mask = _index.size() - 1;
+  uint32_t hole       = pos;
+  uint32_t next       = (hole + 1) & mask;
+
+  while (_index[next]._count != 0) {
+    const uint32_t home = _index[next]._hash & mask;
+
+    // Entry may move into the hole when the hole is within [home, next)
+    if (((next - home) & mask) >= ((next - hole) & mask)) {
+      _index[hole] = _index[next];
+      hole         = next;
+    }
+    next = (next + 1) & mask;
+  }
+  _index[hole]._count = 0;
+}
+
+void EventQueueStruct::rebuildIndex()
+{
+  size_t indexSize = 1;
+
+  while (indexSize < 2 * _events.size()) {
+    indexSize <<= 1;
+  }
+  _index.assign(indexSize, index_entry());
+
+  for (uint16_t pos = 0; pos < _count; ++pos) {
+    const uint16_t slot = slotAt(pos);
+
+    if (!_events[slot].isEmpty()) {
+      indexAdd(_hashes[slot]);
+    }
+  }
 }
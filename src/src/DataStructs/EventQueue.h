@@ -2,13 +2,41 @@
 #define DATASTRUCTS_EVENTQUEUE_H
 
 
-#include <list>
+#include <vector>
 
 
+#include "../DataStructs/TaskValueEvent.h"
 #include "../Globals/Plugins.h"
 
 
+// Max. number of events which can be queued.
+// Memory is allocated on demand, up to this size.
+#ifndef EVENT_QUEUE_MAX_DEPTH
+# ifdef ESP32
+#  define EVENT_QUEUE_MAX_DEPTH  512
+# else // ifdef ESP32
+#  define EVENT_QUEUE_MAX_DEPTH  128
+# endif // ifdef ESP32
+#endif // ifndef EVENT_QUEUE_MAX_DEPTH
+
+// What to do when an event is added to a full queue.
+// See EventQueueStruct::OverflowPolicy
+#ifndef EVENT_QUEUE_OVERFLOW_POLICY
+# define EVENT_QUEUE_OVERFLOW_POLICY  EventQueueStruct::OverflowPolicy::Coalesce
+#endif // ifndef EVENT_QUEUE_OVERFLOW_POLICY
+
+
 struct EventQueueStruct {
+  enum class OverflowPolicy : uint8_t {
+    DropOldest,
+
+    DropNewest,
+
+    // Replace the latest queued event with the same name (part before '=')
+    // by the new event. When not present, drop the new event.
+    Coalesce
+  };
+
   EventQueueStruct() = default;
 
   void        add(const String& event,
@@ -26,21 +54,110 @@ struct EventQueueStruct {
   void        add(taskIndex_t TaskIndex, const __FlashStringHelper * varName, const String& eventValue);
   void        add(taskIndex_t TaskIndex, const __FlashStringHelper * varName, int eventValue);
 
+  // Add task value event, which is only converted into a string when needed.
+  void        add(const TaskValueEvent& event);
+
   bool        getNext(String& event);
 
+  // Get next event without converting a task value event into a string.
+  // Either event is set, or taskValueEvent is valid.
+  bool        getNext(String        & event,
+                      TaskValueEvent& taskValueEvent);
+
   void        clear();
 
   bool        isEmpty() const;
 
-  std::size_t size() {
-    return _eventQueue.size();
+  std::size_t size() const {
+    return _count;
+  }
+
+  // Statistics
+  uint32_t getNrDropped() const {
+    return _nrDropped;
+  }
+
+  uint32_t getNrCoalesced() const {
+    return _nrCoalesced;
+  }
+
+  uint16_t getPeakSize() const {
+    return _peakSize;
   }
 
 private:
 
-  bool isDuplicate(const String& event);
+  // Entry in the hash -> count index.
+  // An entry with _count == 0 is an empty bucket.
+  struct index_entry {
+    uint32_t _hash  = 0;
+    uint16_t _count = 0;
+  };
+
+  static uint32_t computeHash(const String& event);
+
+  bool            isDuplicate(const String& event,
+                              uint32_t      hash) const;
+
+  // Add the event to the queue, applying the overflow policy when full.
+  void            push(String&& event,
+                       uint32_t hash);
+
+  // Replace the latest event with the same name.
+  // Return false when there is no such event.
+  bool            coalesce(String&& event,
+                           uint32_t hash);
+
+  bool            coalesce(const TaskValueEvent& event);
+
+  // Return true when a slot is reserved in the ring buffer.
+  // When false, the overflow policy has been applied to the new event.
+  bool            reserveSlot(String              && event,
+                              uint32_t               hash,
+                              const TaskValueEvent *taskValueEvent);
+
+  uint16_t        taskValueSlotAt(uint16_t pos) const;
+
+  bool            ensureTaskValueCapacity();
+
+  uint16_t        slotAt(uint16_t pos) const;
+
+  // Make sure there is room for at least one more event.
+  // Return false when the max. depth is reached.
+  bool            ensureCapacity();
+
+  int32_t         indexFind(uint32_t hash) const;
+
+  void            indexAdd(uint32_t hash);
+
+  void            indexRemove(uint32_t hash);
+
+  void            rebuildIndex();
+
+  // Ring buffer of events, with the hash per event.
+  // An empty string marks a task value event, which is stored in
+  // _taskValueEvents in the same order.
+  std::vector<String>  _events;
+  std::vector<uint32_t>_hashes;
+
+  // Ring buffer of task value events.
+  // Only allocated when task value events are used.
+  std::vector<TaskValueEvent>_taskValueEvents;
+
+  // Open addressing hash table (linear probing) counting the number of
+  // queued events per hash.
+  // Size is a power of 2 and at least twice the ring buffer capacity.
+  std::vector<index_entry>_index;
+
+  uint16_t _head     = 0;
+  uint16_t _count    = 0;
+  uint16_t _peakSize = 0;
+
+  uint16_t _taskValueHead  = 0;
+  uint16_t _taskValueCount = 0;
 
-  std::list<String>_eventQueue;
+  uint32_t _nrDropped   = 0;
+  uint32_t _nrCoalesced = 0;
 };
 
 
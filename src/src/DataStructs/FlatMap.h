@@ -0,0 +1,238 @@
+#ifndef DATASTRUCTS_FLATMAP_H
+#define DATASTRUCTS_FLATMAP_H
+
+#include "../../ESPEasy_common.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+/*********************************************************************************************\
+* FlatMap
+* Drop-in replacement for the subset of std::map used by the caches.
+* Elements are kept in a vector sorted by key, so lookups are a binary search
+* on contiguous memory and there is no allocation per element.
+* Inserting and erasing invalidates iterators.
+\*********************************************************************************************/
+template<typename Key, typename T>
+class FlatMap {
+public:
+
+  typedef std::pair<Key, T>                               value_type;
+  typedef typename std::vector<value_type>::iterator       iterator;
+  typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+  iterator       begin()       {
+    return _elements.begin();
+  }
+
+  iterator       end()         {
+    return _elements.end();
+  }
+
+  const_iterator begin() const {
+    return _elements.begin();
+  }
+
+  const_iterator end() const   {
+    return _elements.end();
+  }
+
+  iterator find(const Key& key) {
+    iterator it = lowerBound(key);
+
+    if ((it != _elements.end()) && (it->first == key)) {
+      return it;
+    }
+    return _elements.end();
+  }
+
+  const_iterator find(const Key& key) const {
+    const_iterator it = std::lower_bound(_elements.begin(), _elements.end(), key, KeyLess());
+
+    if ((it != _elements.end()) && (it->first == key)) {
+      return it;
+    }
+    return _elements.end();
+  }
+
+  // Like std::map, an existing element is not replaced.
+  std::pair<iterator, bool>emplace(value_type&& element) {
+    iterator it = lowerBound(element.first);
+
+    if ((it != _elements.end()) && (it->first == element.first)) {
+      return std::make_pair(it, false);
+    }
+    it = _elements.insert(it, std::move(element));
+    return std::make_pair(it, true);
+  }
+
+  iterator erase(iterator it) {
+    return _elements.erase(it);
+  }
+
+  void clear() {
+    _elements.clear();
+    _elements.shrink_to_fit();
+  }
+
+  size_t size() const {
+    return _elements.size();
+  }
+
+  bool empty() const {
+    return _elements.empty();
+  }
+
+private:
+
+  // Function object instead of a function pointer, so the compare can be inlined
+  struct KeyLess {
+    bool operator()(const value_type& element, const Key& key) const {
+      return element.first < key;
+    }
+  };
+
+  iterator lowerBound(const Key& key) {
+    return std::lower_bound(_elements.begin(), _elements.end(), key, KeyLess());
+  }
+
+  std::vector<value_type>_elements;
+};
+
+
+/*********************************************************************************************\
+* FlatStringMap
+* Sorted vector of String keys with a precomputed hash.
+* Lookups do a binary search on the hash and only compare strings with the same hash.
+* An optional group (e.g. a task index) is part of the key, so the same name can be
+* stored for several groups without building a combined key string.
+\*********************************************************************************************/
+template<typename T, bool CaseInsensitive = false>
+class FlatStringMap {
+public:
+
+  struct Entry {
+    uint32_t _hash{};
+    uint8_t  _group{};
+    String   first;
+    T        second;
+  };
+
+  typedef typename std::vector<Entry>::iterator       iterator;
+  typedef typename std::vector<Entry>::const_iterator const_iterator;
+
+  iterator       begin()       {
+    return _entries.begin();
+  }
+
+  iterator       end()         {
+    return _entries.end();
+  }
+
+  const_iterator begin() const {
+    return _entries.begin();
+  }
+
+  const_iterator end() const   {
+    return _entries.end();
+  }
+
+  const_iterator find(const String& key, uint8_t group = 0) const {
+    return find(key, group, computeHash(key, group));
+  }
+
+  // An existing entry is not replaced.
+  void emplace(String&& key, const T& value, uint8_t group = 0) {
+    const uint32_t hash = computeHash(key, group);
+
+    if (find(key, group, hash) != _entries.end()) {
+      return;
+    }
+    Entry entry;
+
+    entry._hash  = hash;
+    entry._group = group;
+    entry.first  = std::move(key);
+    entry.second = value;
+
+    _entries.insert(
+      std::upper_bound(_entries.begin(), _entries.end(), hash, HashGreater()),
+      std::move(entry));
+  }
+
+  void emplace(const String& key, const T& value, uint8_t group = 0) {
+    emplace(String(key), value, group);
+  }
+
+  iterator erase(iterator it) {
+    return _entries.erase(it);
+  }
+
+  void clear() {
+    _entries.clear();
+    _entries.shrink_to_fit();
+  }
+
+  size_t size() const {
+    return _entries.size();
+  }
+
+  bool empty() const {
+    return _entries.empty();
+  }
+
+  // FNV-1a, including the group
+  static uint32_t computeHash(const String& key, uint8_t group) {
+    uint32_t hash       = 2166136261u;
+    const char *str     = key.c_str();
+    const size_t length = key.length();
+
+    hash ^= group;
+    hash *= 16777619u;
+
+    for (size_t i = 0; i < length; ++i) {
+      char c = str[i];
+
+      if (CaseInsensitive && (c >= 'A') && (c <= 'Z')) {
+        c += 'a' - 'A';
+      }
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 16777619u;
+    }
+    return hash;
+  }
+
+private:
+
+  const_iterator find(const String& key, uint8_t group, uint32_t hash) const {
+    for (auto it = std::lower_bound(_entries.begin(), _entries.end(), hash, HashLess());
+         it != _entries.end() && it->_hash == hash;
+         ++it) {
+      if ((it->_group == group) && keyEquals(it->first, key)) {
+        return it;
+      }
+    }
+    return _entries.end();
+  }
+
+  struct HashLess {
+    bool operator()(const Entry& entry, uint32_t hash) const {
+      return entry._hash < hash;
+    }
+  };
+
+  struct HashGreater {
+    bool operator()(uint32_t hash, const Entry& entry) const {
+      return hash < entry._hash;
+    }
+  };
+
+  static bool keyEquals(const String& a, const String& b) {
+    return CaseInsensitive ? a.equalsIgnoreCase(b) : a.equals(b);
+  }
+
+  std::vector<Entry>_entries;
+};
+
+#endif // ifndef DATASTRUCTS_FLATMAP_H
@@ -0,0 +1,170 @@
+#include "../DataStructs/LogRingBuffer.h"
+
+#include "../DataStructs/DeferredLogLine.h"
+#include "../Helpers/Memory.h"
+#include "../Helpers/StringConverter.h"
+
+// Bit in the loglevel byte of the header to mark a deferred entry
+#define LOG_RING_BUFFER_DEFERRED_FLAG 0x80
+
+LogRingBuffer::~LogRingBuffer() {
+  clear();
+}
+
+int LogRingBuffer::add(uint8_t loglevel, bool deferred, const uint8_t *data, size_t length) {
+  const size_t size = entrySize(length);
+
+  if ((length == 0) || (size > _size)) {
+    return -1;
+  }
+
+  if (_buffer == nullptr) {
+    // Try to allocate in PSRAM or 2nd heap if possible
+    _buffer = static_cast<uint8_t *>(special_calloc(1, _size));
+
+    if (_buffer == nullptr) {
+      return -1;
+    }
+  }
+
+  int nrRemoved = 0;
+
+  while (static_cast<size_t>(_size - _used) < size) {
+    pop();
+    ++nrRemoved;
+  }
+
+  const uint32_t timestamp = millis();
+  const uint16_t len16     = static_cast<uint16_t>(length);
+  uint8_t header[LOG_RING_BUFFER_ENTRY_HEADER_SIZE];
+
+  memcpy(header, &timestamp, sizeof(timestamp));
+  header[4] = deferred ? (loglevel | LOG_RING_BUFFER_DEFERRED_FLAG) : loglevel;
+  memcpy(header + 5, &len16, sizeof(len16));
+
+  write(header, sizeof(header));
+  write(data,   length);
+  ++_nrEntries;
+  return nrRemoved;
+}
+
+uint32_t LogRingBuffer::frontTimestamp() const {
+  if (isEmpty()) {
+    return 0;
+  }
+  Header header;
+
+  readHeader(header);
+  return header.timestamp;
+}
+
+uint8_t LogRingBuffer::frontLoglevel() const {
+  if (isEmpty()) {
+    return 0;
+  }
+  Header header;
+
+  readHeader(header);
+  return header.loglevel;
+}
+
+String LogRingBuffer::frontMessage() const {
+  String message;
+
+  if (isEmpty()) {
+    return message;
+  }
+  Header header;
+  const uint16_t pos = readHeader(header);
+
+  if (header.deferred) {
+    uint8_t data[DEFERRED_LOG_LINE_MAX_SIZE];
+
+    if (header.length <= sizeof(data)) {
+      read(data, pos, header.length);
+      message = DeferredLogLine::format(data, header.length);
+    }
+    return message;
+  }
+
+  if (!reserve_special(message, header.length)) {
+    return message;
+  }
+
+  // Text may wrap around the end of the buffer
+  const size_t first = _min(static_cast<size_t>(header.length), static_cast<size_t>(_size - pos));
+
+  message.concat(reinterpret_cast<const char *>(_buffer + pos), first);
+
+  if (first < header.length) {
+    message.concat(reinterpret_cast<const char *>(_buffer), header.length - first);
+  }
+  return message;
+}
+
+void LogRingBuffer::pop() {
+  if (isEmpty()) {
+    return;
+  }
+  Header header;
+
+  readHeader(header);
+  const size_t size = entrySize(header.length);
+
+  _readPos = (_readPos + size) % _size;
+  _used   -= size;
+  --_nrEntries;
+
+  if (_nrEntries == 0) {
+    _readPos  = 0;
+    _writePos = 0;
+    _used     = 0;
+  }
+}
+
+void LogRingBuffer::clear() {
+  if (_buffer != nullptr) {
+    free(_buffer);
+    _buffer = nullptr;
+  }
+  _readPos   = 0;
+  _writePos  = 0;
+  _used      = 0;
+  _nrEntries = 0;
+}
+
+uint16_t LogRingBuffer::readHeader(Header& header) const {
+  uint8_t data[LOG_RING_BUFFER_ENTRY_HEADER_SIZE];
+  const uint16_t pos = read(data, _readPos, sizeof(data));
+
+  memcpy(&header.timestamp, data, sizeof(header.timestamp));
+  header.loglevel = data[4] & ~LOG_RING_BUFFER_DEFERRED_FLAG;
+  header.deferred = (data[4] & LOG_RING_BUFFER_DEFERRED_FLAG) != 0;
+  memcpy(&header.length, data + 5, sizeof(header.length));
+  return pos;
+}
+
+void LogRingBuffer::write(const void *data, size_t size) {
+  const uint8_t *src   = static_cast<const uint8_t *>(data);
+  const size_t   first = _min(size, static_cast<size_t>(_size - _writePos));
+
+  memcpy(_buffer + _writePos, src, first);
+
+  if (first < size) {
+    memcpy(_buffer, src + first, size - first);
+  }
+  _writePos = (_writePos + size) % _size;
+  _used    += size;
+}
+
+uint16_t LogRingBuffer::read(void *data, uint16_t pos, size_t size) const {
+  uint8_t     *dst   = static_cast<uint8_t *>(data);
+  const size_t first = _min(size, static_cast<size_t>(_size - pos));
+
+  memcpy(dst, _buffer + pos, first);
+
+  if (first < size) {
+    memcpy(dst + first, _buffer, size - first);
+  }
+  return (pos + size) % _size;
+}
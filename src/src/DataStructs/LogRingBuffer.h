@@ -0,0 +1,94 @@
+#ifndef DATASTRUCTS_LOGRINGBUFFER_H
+#define DATASTRUCTS_LOGRINGBUFFER_H
+
+
+#include "../../ESPEasy_common.h"
+
+// Timestamp (4 bytes) + loglevel (1 byte) + length (2 bytes)
+#define LOG_RING_BUFFER_ENTRY_HEADER_SIZE 7
+
+/*********************************************************************************************\
+ * LogRingBuffer
+ * Log entries stored in a single byte ring buffer, sized in bytes.
+ * Each entry consists of a header (timestamp, loglevel, length) followed by either
+ * the text without terminating zero, or a DeferredLogLine (format string pointer + arguments)
+ * which is only formatted when the entry is read.
+ * The buffer is allocated when the first entry is added and freed by clear().
+\*********************************************************************************************/
+class LogRingBuffer {
+public:
+
+  explicit LogRingBuffer(uint16_t size) : _size(size) {}
+
+  ~LogRingBuffer();
+
+  LogRingBuffer(const LogRingBuffer&)            = delete;
+  LogRingBuffer& operator=(const LogRingBuffer&) = delete;
+
+  // Add an entry, oldest entries are removed to make room.
+  // Returns the number of entries removed, or -1 when the entry could not be stored.
+  int add(uint8_t        loglevel,
+          bool           deferred,
+          const uint8_t *data,
+          size_t         length);
+
+  bool isEmpty() const {
+    return _nrEntries == 0;
+  }
+
+  uint16_t nrEntries() const {
+    return _nrEntries;
+  }
+
+  // Properties of the oldest entry, only valid when not empty.
+  uint32_t frontTimestamp() const;
+
+  uint8_t  frontLoglevel() const;
+
+  // Text of the oldest entry, deferred entries are formatted here.
+  String   frontMessage() const;
+
+  // Remove the oldest entry.
+  void     pop();
+
+  // Remove all entries and free the buffer.
+  void     clear();
+
+  // Number of bytes used in the buffer for an entry with given payload length.
+  static size_t entrySize(size_t length) {
+    return LOG_RING_BUFFER_ENTRY_HEADER_SIZE + length;
+  }
+
+private:
+
+  struct Header {
+    uint32_t timestamp{};
+    uint8_t  loglevel{};
+    bool     deferred{};
+    uint16_t length{};
+  };
+
+  // Read the header of the oldest entry.
+  // Returns the position of its payload.
+  uint16_t readHeader(Header& header) const;
+
+  // Copy data into the ring buffer at _writePos
+  void     write(const void *data,
+                 size_t      size);
+
+  // Copy data from the ring buffer starting at pos.
+  // Returns the position right after the data read.
+  uint16_t read(void    *data,
+                uint16_t pos,
+                size_t   size) const;
+
+  uint8_t *_buffer = nullptr;
+  const uint16_t _size;
+  uint16_t _readPos   = 0;
+  uint16_t _writePos  = 0;
+  uint16_t _used      = 0;
+  uint16_t _nrEntries = 0;
+};
+
+
+#endif // DATASTRUCTS_LOGRINGBUFFER_H
@@ -0,0 +1,72 @@
+#include "../DataStructs/LogSinkQueue.h"
+
+#include "../DataStructs/DeferredLogLine.h"
+#include "../Helpers/ESPEasy_time_calc.h"
+
+static_assert(LOG_SINK_QUEUE_MAX_BYTES <= 65535, "LOG_SINK_QUEUE_MAX_BYTES must fit in uint16_t");
+static_assert(LOG_SINK_QUEUE_MAX_BYTES >= (LOG_RING_BUFFER_ENTRY_HEADER_SIZE + DEFERRED_LOG_LINE_MAX_SIZE), "LOG_SINK_QUEUE_MAX_BYTES too small");
+
+void LogSinkQueue::add(uint8_t loglevel, const String& line)
+{
+  add(loglevel, false, reinterpret_cast<const uint8_t *>(line.c_str()), line.length());
+}
+
+void LogSinkQueue::add(uint8_t loglevel, const DeferredLogLine& line)
+{
+  add(loglevel, true, line.data(), line.size());
+}
+
+void LogSinkQueue::add(uint8_t loglevel, bool deferred, const uint8_t *data, size_t length)
+{
+  if (length == 0) {
+    return;
+  }
+
+  while (_entries.nrEntries() >= LOG_SINK_QUEUE_MAX_LINES) {
+    _entries.pop();
+    ++_nrDropped;
+  }
+
+  const int nrRemoved = _entries.add(loglevel, deferred, data, length);
+
+  if (nrRemoved < 0) {
+    // Too long or buffer could not be allocated
+    ++_nrDropped;
+  } else {
+    _nrDropped += nrRemoved;
+  }
+}
+
+void LogSinkQueue::pop()
+{
+  if (_entries.isEmpty()) {
+    return;
+  }
+  const uint32_t latency = timePassedSince(_entries.frontTimestamp());
+
+  if (latency > _maxLatency) {
+    _maxLatency = latency;
+  }
+  _totalLatency += latency;
+  ++_nrProcessed;
+  _entries.pop();
+
+  if (_entries.isEmpty()) {
+    // Do not keep the buffer allocated while nothing is queued
+    _entries.clear();
+  }
+}
+
+void LogSinkQueue::clear()
+{
+  _nrDropped += _entries.nrEntries();
+  _entries.clear();
+}
+
+uint32_t LogSinkQueue::getAvgLatency() const
+{
+  if (_nrProcessed == 0) {
+    return 0;
+  }
+  return _totalLatency / _nrProcessed;
+}
@@ -0,0 +1,98 @@
+#ifndef DATASTRUCTS_LOGSINKQUEUE_H
+#define DATASTRUCTS_LOGSINKQUEUE_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataStructs/LogRingBuffer.h"
+
+class DeferredLogLine;
+
+// Max. number of log lines queued per log sink (syslog, SD card)
+#ifndef LOG_SINK_QUEUE_MAX_LINES
+# ifdef ESP32
+#  define LOG_SINK_QUEUE_MAX_LINES  64
+# else // ifdef ESP32
+#  define LOG_SINK_QUEUE_MAX_LINES  16
+# endif // ifdef ESP32
+#endif // ifndef LOG_SINK_QUEUE_MAX_LINES
+
+// Max. number of bytes of the buffer per log sink, including the entry headers
+#ifndef LOG_SINK_QUEUE_MAX_BYTES
+# ifdef ESP32
+#  define LOG_SINK_QUEUE_MAX_BYTES  8192
+# else // ifdef ESP32
+#  define LOG_SINK_QUEUE_MAX_BYTES  1536
+# endif // ifdef ESP32
+#endif // ifndef LOG_SINK_QUEUE_MAX_BYTES
+
+
+/*********************************************************************************************\
+* LogSinkQueue
+* Bounded queue of log lines for a log destination which may be slow (syslog, SD card).
+* Lines are added by addLog() and processed later from backgroundtasks(),
+* so a slow destination does not stall the code logging the line.
+* Stored in a single byte ring buffer (see LogRingBuffer), lines logged via addLogFormat()
+* are only formatted when processed.
+* When full, the oldest line is dropped.
+\*********************************************************************************************/
+class LogSinkQueue {
+public:
+
+  LogSinkQueue() : _entries(LOG_SINK_QUEUE_MAX_BYTES) {}
+
+  void add(uint8_t       loglevel,
+           const String& line);
+
+  void add(uint8_t                loglevel,
+           const DeferredLogLine& line);
+
+  bool isEmpty() const {
+    return _entries.isEmpty();
+  }
+
+  uint8_t frontLoglevel() const {
+    return _entries.frontLoglevel();
+  }
+
+  // Text of the first entry
+  String frontMessage() const {
+    return _entries.frontMessage();
+  }
+
+  // Remove the first entry after it has been processed.
+  // Keeps track of the time it took between adding and processing.
+  void     pop();
+
+  void     clear();
+
+  // Statistics
+  uint32_t getNrProcessed() const {
+    return _nrProcessed;
+  }
+
+  uint32_t getNrDropped() const {
+    return _nrDropped;
+  }
+
+  uint32_t getMaxLatency() const {
+    return _maxLatency;
+  }
+
+  uint32_t getAvgLatency() const;
+
+private:
+
+  void add(uint8_t        loglevel,
+           bool           deferred,
+           const uint8_t *data,
+           size_t         length);
+
+  LogRingBuffer _entries;
+
+  uint32_t _nrProcessed  = 0;
+  uint32_t _nrDropped    = 0;
+  uint32_t _maxLatency   = 0;
+  uint64_t _totalLatency = 0;
+};
+
+#endif // ifndef DATASTRUCTS_LOGSINKQUEUE_H
@@ -1,26 +1,23 @@
 #include "../DataStructs/LogStruct.h"
 
+#include "../DataStructs/DeferredLogLine.h"
 #include "../Helpers/ESPEasy_time_calc.h"
-#include "../Helpers/StringConverter.h"
 
-void LogStruct::add_end() {
-  if (isFull()) {
-    read_idx = nextIndex(read_idx);
-  }
-  write_idx = nextIndex(write_idx);
-  is_full   = (write_idx == read_idx);
-}
+static_assert(LOG_STRUCT_BUFFER_SIZE <= 65535, "LOG_STRUCT_BUFFER_SIZE must fit in uint16_t");
+static_assert(LOG_STRUCT_BUFFER_SIZE >= (LOG_RING_BUFFER_ENTRY_HEADER_SIZE + LOG_STRUCT_MESSAGE_SIZE), "LOG_STRUCT_BUFFER_SIZE too small");
+static_assert(LOG_STRUCT_BUFFER_SIZE >= (LOG_RING_BUFFER_ENTRY_HEADER_SIZE + DEFERRED_LOG_LINE_MAX_SIZE), "LOG_STRUCT_BUFFER_SIZE too small");
 
 void LogStruct::add(const uint8_t loglevel, const String& line) {
-  if (Message[write_idx].add(loglevel, line)) {
-    add_end();
+  size_t length = line.length();
+
+  if (length > LOG_STRUCT_MESSAGE_SIZE - 1) {
+    length = LOG_STRUCT_MESSAGE_SIZE - 1;
   }
+  _entries.add(loglevel, false, reinterpret_cast<const uint8_t *>(line.c_str()), length);
 }
 
-void LogStruct::add(const uint8_t loglevel, String&& line) {
-  if (Message[write_idx].add(loglevel, std::move(line))) {
-    add_end();
-  }
+void LogStruct::add(const uint8_t loglevel, const DeferredLogLine& line) {
+  _entries.add(loglevel, true, line.data(), line.size());
 }
 
 bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel) {
@@ -30,10 +27,10 @@ bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, Strin
   if (isEmpty()) {
     return false;
   }
-  timestamp = Message[read_idx]._timestamp;
-  message   = std::move(Message[read_idx]._message);
-  loglevel  = Message[read_idx]._loglevel;
-  clearOldest();
+  timestamp = _entries.frontTimestamp();
+  loglevel  = _entries.frontLoglevel();
+  message   = _entries.frontMessage();
+  _entries.pop();
 
   if (!isEmpty()) {
     logLinesAvailable = true;
@@ -44,28 +41,18 @@ bool LogStruct::getNext(bool& logLinesAvailable, unsigned long& timestamp, Strin
 
 bool LogStruct::logActiveRead() {
   clearExpiredEntries();
-  return timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
-}
+  const bool active = timePassedSince(lastReadTimeStamp) < LOG_BUFFER_ACTIVE_READ_TIMEOUT;
 
-void LogStruct::clearExpiredEntries() {
-  unsigned int maxLoops = LOG_STRUCT_MESSAGE_LINES;
-
-  while (maxLoops > 0) {
-    --maxLoops;
-
-    if (isEmpty() || // Nothing left
-        !Message[read_idx].isExpired())
-    {
-      return;
-    }
-    clearOldest();
+  if (!active && isEmpty()) {
+    _entries.clear();
   }
+  return active;
 }
 
-void LogStruct::clearOldest() {
-  if (!isEmpty()) {
-    is_full = false;
-    Message[read_idx].clear();
-    read_idx = nextIndex(read_idx);
+void LogStruct::clearExpiredEntries() {
+  while (!isEmpty() &&
+         timePassedSince(_entries.frontTimestamp()) >= LOG_BUFFER_EXPIRE)
+  {
+    _entries.pop();
   }
 }
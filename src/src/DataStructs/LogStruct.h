@@ -4,70 +4,79 @@
 
 #include "../../ESPEasy_common.h"
 
-#include "../DataStructs/LogEntry.h"
+#include "../DataStructs/LogRingBuffer.h"
+
+class DeferredLogLine;
 
 /*********************************************************************************************\
  * LogStruct
+ * Log lines for the web log viewer, stored in a single byte ring buffer (see LogRingBuffer).
+ * Lines logged via addLogFormat() are stored as format string pointer + arguments
+ * and only formatted when read by the web log viewer.
+ * The buffer is only allocated when log lines are added (web log is being read)
+ * and freed again when it is no longer read and all entries have expired.
 \*********************************************************************************************/
-#ifdef ESP32
-  #define LOG_STRUCT_MESSAGE_LINES 120
-#else
-  #ifdef USE_SECOND_HEAP
-    #define LOG_STRUCT_MESSAGE_LINES 60
+#ifndef LOG_STRUCT_BUFFER_SIZE
+  #ifdef ESP32
+    #define LOG_STRUCT_BUFFER_SIZE 8192
   #else
-    #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
-      #define LOG_STRUCT_MESSAGE_LINES 10
+    #ifdef USE_SECOND_HEAP
+      #define LOG_STRUCT_BUFFER_SIZE 4096
     #else
-      #define LOG_STRUCT_MESSAGE_LINES 15
+      #if defined(PLUGIN_BUILD_COLLECTION) || defined(PLUGIN_BUILD_DEV)
+        #define LOG_STRUCT_BUFFER_SIZE 1024
+      #else
+        #define LOG_STRUCT_BUFFER_SIZE 1536
+      #endif
     #endif
   #endif
 #endif
 
+// Max. length of a log line, including the terminating zero.
+#define LOG_STRUCT_MESSAGE_SIZE 128
+
 #ifdef ESP32
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 30000
+  #define LOG_BUFFER_EXPIRE              30000 // Time after which a buffered log item is considered expired.
 #else
   #define LOG_BUFFER_ACTIVE_READ_TIMEOUT 5000
+  #define LOG_BUFFER_EXPIRE              5000  // Time after which a buffered log item is considered expired.
 #endif
 
 
 struct LogStruct {
-    
+
+    LogStruct() : _entries(LOG_STRUCT_BUFFER_SIZE) {}
+
+    LogStruct(const LogStruct&) = delete;
+    LogStruct& operator=(const LogStruct&) = delete;
+
+    // Lines longer than LOG_STRUCT_MESSAGE_SIZE - 1 are truncated.
+    // Oldest entries are removed to make room for the new line.
     void add(const uint8_t loglevel, const String& line);
-    void add(const uint8_t loglevel, String&& line);
 
-    // Read the next item and append it to the given string.
-    // Returns whether new lines are available.
-//    bool get(String& output, const String& lineEnd);
+    void add(const uint8_t loglevel, const DeferredLogLine& line);
 
     // Returns whether a line was retrieved.
     bool getNext(bool& logLinesAvailable, unsigned long& timestamp, String& message, uint8_t& loglevel);
 
     bool isEmpty() const {
-      return !is_full && (write_idx == read_idx);
+      return _entries.isEmpty();
     }
 
-    bool isFull() const { return is_full; }
-
     bool logActiveRead();
 
-  private:
+    // Number of bytes used in the buffer for a line of given length.
+    static size_t entrySize(size_t messageLength) {
+      return LogRingBuffer::entrySize(messageLength);
+    }
 
-    void add_end();
+  private:
 
     void clearExpiredEntries();
 
-    void clearOldest();
-
-    static int nextIndex(int idx) {
-//      return ((++idx) == LOG_STRUCT_MESSAGE_LINES) ? 0 : idx;
-      return (idx + 1) % LOG_STRUCT_MESSAGE_LINES;
-    }
-
-    LogEntry_t Message[LOG_STRUCT_MESSAGE_LINES];
-    int write_idx = 0;
-    int read_idx = 0;
+    LogRingBuffer _entries;
     unsigned long lastReadTimeStamp = 0;
-    bool is_full = false;
 };
 
 
@@ -567,6 +567,7 @@ bool NodesHandler::refreshNodeList(unsigned long max_age_allowed, unsigned long&
           // Add event about removing node from nodeslist.
           eventQueue.addMove(strformat(F("p2pNode#Disconnected=%d"), it->second.unit));
         }
+        _p2pStats.erase(it->second.unit);
         {
           _nodes_mutex.lock();
           it          = _nodes.erase(it);
@@ -652,6 +653,26 @@ void NodesHandler::setRSSI(NodeStruct * node, int rssi)
   }
 }
 
+void NodesHandler::markP2P_sent(uint8_t unit, uint8_t nrRecords)
+{
+  _p2pStats[unit].markSent(nrRecords);
+}
+
+void NodesHandler::markP2P_received(uint8_t unit, uint8_t nrRecords)
+{
+  _p2pStats[unit].markReceived(nrRecords);
+}
+
+P2P_Node_statistics_t * NodesHandler::getP2P_statistics(uint8_t unit)
+{
+  auto it = _p2pStats.find(unit);
+
+  if (it == _p2pStats.end()) {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
 bool NodesHandler::lastTimeValidDistanceExpired() const
 {
 //  if (_lastTimeValidDistance == 0) return false;
@@ -7,6 +7,7 @@
 #include "../DataStructs/MAC_address.h"
 #include "../DataStructs/NodeStruct.h"
 #include "../DataStructs/NTP_candidate.h"
+#include "../DataStructs/P2P_Node_statistics.h"
 
 
 #ifdef USES_ESPEASY_NOW
@@ -115,6 +116,15 @@ public:
 
 #endif // ifdef USES_ESPEASY_NOW
 
+  // Count ESPEasy p2p messages sent to/received from a unit (255 = broadcast)
+  void                   markP2P_sent(uint8_t unit,
+                                      uint8_t nrRecords);
+  void                   markP2P_received(uint8_t unit,
+                                          uint8_t nrRecords);
+
+  // @retval nullptr when no messages were sent to/received from this unit
+  P2P_Node_statistics_t* getP2P_statistics(uint8_t unit);
+
   timeSource_t getUnixTime(double &unix_time, int32_t& wander, uint8_t& unit) const {
     return _ntp_candidate.getUnixTime(unix_time, wander, unit);
   }
@@ -133,6 +143,8 @@ private:
   ESPEasy_Mutex _nodes_mutex;
 
   NTP_candidate_struct _ntp_candidate;
+
+  P2P_Node_statisticsMap _p2pStats;
   
 
 #ifdef USES_ESPEASY_NOW
@@ -0,0 +1,63 @@
+#include "../DataStructs/P2P_Node_statistics.h"
+
+#if FEATURE_ESPEASY_P2P
+
+# include "../Helpers/ESPEasy_time_calc.h"
+
+void P2P_Node_statistics_t::markSent(uint8_t nrRecords)
+{
+  updateRates();
+  ++sentMessages;
+  sentRecords += nrRecords;
+  lastSent     = millis();
+
+  if (_sentInInterval < 0xFFFF) {
+    ++_sentInInterval;
+  }
+}
+
+void P2P_Node_statistics_t::markReceived(uint8_t nrRecords)
+{
+  updateRates();
+  ++receivedMessages;
+  receivedRecords += nrRecords;
+  lastReceived     = millis();
+
+  if (_receivedInInterval < 0xFFFF) {
+    ++_receivedInInterval;
+  }
+}
+
+float P2P_Node_statistics_t::getSentPerMinute()
+{
+  updateRates();
+  return _sentRate;
+}
+
+float P2P_Node_statistics_t::getReceivedPerMinute()
+{
+  updateRates();
+  return _receivedRate;
+}
+
+void P2P_Node_statistics_t::updateRates()
+{
+  if (_intervalStart == 0) {
+    _intervalStart = millis();
+    return;
+  }
+  const long elapsed = timePassedSince(_intervalStart);
+
+  if (elapsed < P2P_NODE_STATISTICS_RATE_INTERVAL) {
+    return;
+  }
+
+  // When nothing happened for several intervals, the rate is averaged over the entire time.
+  _sentRate           = (_sentInInterval * 60000.0f) / elapsed;
+  _receivedRate       = (_receivedInInterval * 60000.0f) / elapsed;
+  _sentInInterval     = 0;
+  _receivedInInterval = 0;
+  _intervalStart      = millis();
+}
+
+#endif // if FEATURE_ESPEASY_P2P
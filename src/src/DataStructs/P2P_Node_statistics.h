@@ -0,0 +1,50 @@
+#ifndef DATASTRUCTS_P2P_NODE_STATISTICS_H
+#define DATASTRUCTS_P2P_NODE_STATISTICS_H
+
+#include "../../ESPEasy_common.h"
+
+#if FEATURE_ESPEASY_P2P
+
+# include <map>
+
+// Interval in msec over which the send/receive rates are computed
+# ifndef P2P_NODE_STATISTICS_RATE_INTERVAL
+#  define P2P_NODE_STATISTICS_RATE_INTERVAL  60000
+# endif // ifndef P2P_NODE_STATISTICS_RATE_INTERVAL
+
+
+// Counters of ESPEasy p2p messages sent to and received from a node.
+// A message may contain multiple records (e.g. batched sensor data)
+struct P2P_Node_statistics_t {
+  void     markSent(uint8_t nrRecords);
+  void     markReceived(uint8_t nrRecords);
+
+  // Messages per minute, computed over the last completed interval
+  float    getSentPerMinute();
+  float    getReceivedPerMinute();
+
+  uint32_t sentMessages     = 0;
+  uint32_t sentRecords      = 0;
+  uint32_t receivedMessages = 0;
+  uint32_t receivedRecords  = 0;
+
+  // Moment (millis) of last message sent/received
+  uint32_t lastSent     = 0;
+  uint32_t lastReceived = 0;
+
+private:
+
+  void updateRates();
+
+  uint32_t _intervalStart      = 0;
+  uint16_t _sentInInterval     = 0;
+  uint16_t _receivedInInterval = 0;
+  float    _sentRate           = 0.0f;
+  float    _receivedRate       = 0.0f;
+};
+
+typedef std::map<uint8_t, P2P_Node_statistics_t> P2P_Node_statisticsMap;
+
+#endif // if FEATURE_ESPEASY_P2P
+
+#endif // ifndef DATASTRUCTS_P2P_NODE_STATISTICS_H
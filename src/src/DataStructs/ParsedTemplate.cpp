@@ -0,0 +1,207 @@
+#include "../DataStructs/ParsedTemplate.h"
+
+#ifndef LIMIT_BUILD_SIZE
+
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/StringConverter.h"
+# include "../Helpers/StringParser.h"
+
+// Same characters as used in parseTemplate_padded() to mask escaped square brackets
+# define PARSED_TEMPLATE_MASK_OPEN   static_cast<char>(0x05)
+# define PARSED_TEMPLATE_MASK_CLOSE  static_cast<char>(0x06)
+
+
+ParsedTemplate::ParsedTemplate(const String& tmpl)
+{
+  String masked(tmpl);
+
+  masked.replace(F("\\["), String(PARSED_TEMPLATE_MASK_OPEN));
+  masked.replace(F("\\]"), String(PARSED_TEMPLATE_MASK_CLOSE));
+
+  int  startpos     = 0;
+  int  lastStartpos = 0;
+  int  endpos       = 0;
+  bool unsupported  = false;
+
+  {
+    String deviceName, valueName, format;
+
+    while (findNextDevValNameInString(masked, startpos, endpos, deviceName, valueName, format)) {
+      if (!addText(masked, lastStartpos, startpos)) {
+        unsupported = true;
+        break;
+      }
+
+      // System variables are replaced before the [...#...] is looked up,
+      // so those may change what is referred to.
+      const int percent_pos = masked.indexOf('%', startpos);
+
+      if ((percent_pos != -1) && (percent_pos < endpos)) {
+        unsupported = true;
+        break;
+      }
+
+      // Right alignment depends on the length of the entire parsed string
+      if (format.indexOf('R') != -1) {
+        unsupported = true;
+        break;
+      }
+
+      // Escaped brackets are unmasked on the entire parsed string,
+      // so also in whatever a [...#...] results in.
+      const int mask_pos = masked.indexOf(PARSED_TEMPLATE_MASK_OPEN, startpos);
+      const int mask_end = masked.indexOf(PARSED_TEMPLATE_MASK_CLOSE, startpos);
+
+      if (((mask_pos != -1) && (mask_pos < endpos)) ||
+          ((mask_end != -1) && (mask_end < endpos))) {
+        unsupported = true;
+        break;
+      }
+      Token token(TokenType::DevValRef);
+      move_special(token._text,      std::move(deviceName));
+      move_special(token._valueName, std::move(valueName));
+      move_special(token._format,    std::move(format));
+      _tokens.emplace_back(std::move(token));
+
+      lastStartpos = endpos + 1;
+      startpos     = endpos + 1;
+    }
+  }
+
+  if (!unsupported && addText(masked, lastStartpos, masked.length())) {
+    _isValid = true;
+  } else {
+    _tokens.clear();
+    _tokens.shrink_to_fit();
+  }
+}
+
+void ParsedTemplate::addLiteral(const String& tmpl, int start, int end)
+{
+  if (end <= start) {
+    return;
+  }
+  Token token(TokenType::Literal);
+
+  token._text = tmpl.substring(start, end);
+  token._text.replace(String(PARSED_TEMPLATE_MASK_OPEN),  F("\\["));
+  token._text.replace(String(PARSED_TEMPLATE_MASK_CLOSE), F("\\]"));
+  _literalLength += token._text.length();
+  _tokens.emplace_back(std::move(token));
+}
+
+bool ParsedTemplate::addText(const String& tmpl, int start, int end)
+{
+  int pos = start;
+
+  while (pos < end) {
+    const int percent_pos = tmpl.indexOf('%', pos);
+
+    if ((percent_pos == -1) || (percent_pos >= end)) {
+      break;
+    }
+    const int percent_end = tmpl.indexOf('%', percent_pos + 1);
+
+    if ((percent_end == -1) || (percent_end >= end)) {
+      return false;
+    }
+    const SystemVariables::Enum sysvar = findSystemVariable(tmpl.substring(percent_pos + 1, percent_end));
+
+    if (sysvar == SystemVariables::Enum::UNKNOWN) {
+      return false;
+    }
+    addLiteral(tmpl, pos, percent_pos);
+
+    Token token(TokenType::SystemVariable);
+    token._sysvar = sysvar;
+    _tokens.emplace_back(std::move(token));
+    ++_nrSystemVariables;
+
+    pos = percent_end + 1;
+  }
+  addLiteral(tmpl, pos, end);
+  return true;
+}
+
+SystemVariables::Enum ParsedTemplate::findSystemVariable(const String& name)
+{
+  if (name.isEmpty() ||
+      (SystemVariables::startIndex_beginWith(name[0]) == SystemVariables::Enum::UNKNOWN)) {
+    return SystemVariables::Enum::UNKNOWN;
+  }
+
+  for (int i = 0; i < SystemVariables::Enum::UNKNOWN; ++i) {
+    const SystemVariables::Enum enumval = static_cast<SystemVariables::Enum>(i);
+
+    // These may have arguments, so let parseSystemVariables() handle them.
+    if ((enumval == SystemVariables::Enum::SUNRISE) ||
+        (enumval == SystemVariables::Enum::SUNSET) ||
+        (enumval == SystemVariables::Enum::VARIABLE)) {
+      continue;
+    }
+
+    if (equals(name, SystemVariables::toFlashString(enumval))) {
+      return enumval;
+    }
+  }
+  return SystemVariables::Enum::UNKNOWN;
+}
+
+std::shared_ptr<const ParsedTemplate>ParsedTemplate_cache::get(const String& tmpl)
+{
+  auto it = _parsed.find(tmpl);
+
+  if (it != _parsed.end()) {
+    if (it->second->isValid()) {
+      ++_nrHits;
+    } else {
+      ++_nrMisses;
+    }
+    return it->second;
+  }
+  ++_nrMisses;
+
+  const uint32_t hash = calc_CRC32(reinterpret_cast<const uint8_t *>(tmpl.c_str()), tmpl.length());
+
+  for (size_t i = 0; i < NR_ELEMENTS(_seen); ++i) {
+    if (_seen[i] == hash) {
+      _seen[i] = 0;
+
+      if (_parsed.size() >= PARSED_TEMPLATE_CACHE_SIZE) {
+        _parsed.clear();
+      }
+      std::shared_ptr<const ParsedTemplate> parsed(new (std::nothrow) ParsedTemplate(tmpl));
+
+      if (parsed) {
+        _parsed.emplace(tmpl, parsed);
+      }
+      return parsed;
+    }
+  }
+
+  _seen[_seenPos] = hash;
+  ++_seenPos;
+
+  if (_seenPos >= NR_ELEMENTS(_seen)) {
+    _seenPos = 0;
+  }
+  return nullptr;
+}
+
+void ParsedTemplate_cache::clear()
+{
+  _parsed.clear();
+
+  for (size_t i = 0; i < NR_ELEMENTS(_seen); ++i) {
+    _seen[i] = 0;
+  }
+  _seenPos = 0;
+}
+
+void ParsedTemplate_cache::resetStats()
+{
+  _nrHits   = 0;
+  _nrMisses = 0;
+}
+
+#endif // ifndef LIMIT_BUILD_SIZE
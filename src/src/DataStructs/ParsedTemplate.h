@@ -0,0 +1,127 @@
+#ifndef DATASTRUCTS_PARSEDTEMPLATE_H
+#define DATASTRUCTS_PARSEDTEMPLATE_H
+
+#include "../../ESPEasy_common.h"
+
+#ifndef LIMIT_BUILD_SIZE
+
+# include "../Helpers/SystemVariables.h"
+
+# include <map>
+# include <memory>
+# include <vector>
+
+// Max. number of parsed templates kept in memory.
+// When full, all parsed templates are discarded.
+# ifndef PARSED_TEMPLATE_CACHE_SIZE
+#  ifdef ESP32
+#   define PARSED_TEMPLATE_CACHE_SIZE  24
+#  else // ifdef ESP32
+#   define PARSED_TEMPLATE_CACHE_SIZE  8
+#  endif // ifdef ESP32
+# endif // ifndef PARSED_TEMPLATE_CACHE_SIZE
+
+
+// A template string as used by parseTemplate(), split into tokens.
+// This allows to render frequently used templates (e.g. display lines)
+// without scanning the template for system variables and [task#value]
+// references on every call.
+//
+// Only templates which render exactly the same as the regular text based
+// parsing are considered valid:
+// - Every '%' must be part of a known system variable, without parameters
+// - System variables may not be part of a [...#...] reference
+// - No right aligned formatting, as it depends on the full string length
+struct ParsedTemplate {
+  enum class TokenType : uint8_t {
+    Literal,
+    SystemVariable,
+    DevValRef // [deviceName#valueName#format]
+  };
+
+  struct Token {
+    explicit Token(TokenType type) : _type(type) {}
+
+    // Literal text or deviceName of a [...#...] reference
+    String                _text;
+    String                _valueName;
+    String                _format;
+    SystemVariables::Enum _sysvar = SystemVariables::Enum::UNKNOWN;
+    TokenType             _type;
+  };
+
+  explicit ParsedTemplate(const String& tmpl);
+
+  bool isValid() const {
+    return _isValid;
+  }
+
+  // Total length of all literal tokens.
+  // Used to reserve memory for the rendered string.
+  size_t literalLength() const {
+    return _literalLength;
+  }
+
+  size_t nrSystemVariables() const {
+    return _nrSystemVariables;
+  }
+
+  std::vector<Token>_tokens;
+
+private:
+
+  void   addLiteral(const String& tmpl,
+                    int           start,
+                    int           end);
+
+  // Add literal text and system variables found in tmpl[start ... end)
+  // Return false when not all '%' are part of a known system variable.
+  bool   addText(const String& tmpl,
+                 int           start,
+                 int           end);
+
+  static SystemVariables::Enum findSystemVariable(const String& name);
+
+  size_t _literalLength     = 0;
+  size_t _nrSystemVariables = 0;
+  bool   _isValid           = false;
+};
+
+
+class ParsedTemplate_cache {
+public:
+
+  // Return parsed template, or nullptr when the template is not (yet) cached.
+  // A template is only parsed when it is seen for the 2nd time, to not
+  // waste resources on strings which are generated only once (e.g. rules
+  // lines with substituted event values)
+  // Shared ownership is returned, as rendering the template may call
+  // parseTemplate() again, which may clear the cache.
+  std::shared_ptr<const ParsedTemplate>get(const String& tmpl);
+
+  void                                 clear();
+
+  uint32_t              getNrHits() const {
+    return _nrHits;
+  }
+
+  uint32_t getNrMisses() const {
+    return _nrMisses;
+  }
+
+  void resetStats();
+
+private:
+
+  std::map<String, std::shared_ptr<const ParsedTemplate> >_parsed;
+
+  // Hashes of recently seen templates, which are not (yet) parsed.
+  uint32_t _seen[PARSED_TEMPLATE_CACHE_SIZE]{};
+  uint8_t  _seenPos  = 0;
+  uint32_t _nrHits   = 0;
+  uint32_t _nrMisses = 0;
+};
+
+#endif // ifndef LIMIT_BUILD_SIZE
+
+#endif // ifndef DATASTRUCTS_PARSEDTEMPLATE_H
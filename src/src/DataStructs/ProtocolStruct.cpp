@@ -7,5 +7,8 @@ ProtocolStruct::ProtocolStruct() :
     usesExtCreds(false), needsNetwork(true), allowsExpire(true), allowLocalSystemTime(false)
   #if FEATURE_MQTT_TLS
   , usesTLS(false)
+  #endif
+  #if FEATURE_MQTT
+  , allowsBatchJSON(false)
   #endif
     {}
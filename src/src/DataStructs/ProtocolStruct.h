@@ -42,6 +42,9 @@ struct ProtocolStruct
 #if FEATURE_MQTT_TLS
   bool     usesTLS              : 1; // May offer TLS related settings and options
 #endif
+#if FEATURE_MQTT
+  bool     allowsBatchJSON      : 1; // May publish all task values as a single JSON message
+#endif
 
 //  uint8_t Number{};
 };
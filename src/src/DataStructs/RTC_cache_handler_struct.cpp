@@ -76,7 +76,7 @@ bool RTC_cache_handler_struct::peekDataAvailable() const {
   if (_peekfilenr == RTC_cache.writeFileNr) {
     if (fw) {
       constexpr size_t errorcode = (size_t)-1;
-      size_t pos = fp.position();
+      size_t pos = getPeekFilePosition();
       if (pos == errorcode) {
         pos = 0;
       }
@@ -91,7 +91,7 @@ int RTC_cache_handler_struct::getPeekFilePos(int& peekFileNr) {
   peekFileNr = _peekfilenr;
   constexpr size_t errorcode = (size_t)-1;
   if (fp) {
-    size_t pos = fp.position();
+    size_t pos = getPeekFilePosition();
     if (pos == errorcode) {
       _peekreadpos = 0;
       return -1;
@@ -116,7 +116,7 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
 
   if (fp) {
     constexpr size_t errorcode = (size_t)-1;
-    size_t pos = fp.position();
+    size_t pos = getPeekFilePosition();
     if (pos == errorcode) {
       pos = 0;
     }
@@ -140,11 +140,7 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
 
 
   if (!fp) {
-    String fname = createCacheFilename(newPeekFileNr);
-
-    if (fname.isEmpty()) { return; }
-
-    fp = tryOpenFile(fname, "r");
+    openPeekFile(newPeekFileNr);
   }
 
   if (fp) {
@@ -154,10 +150,14 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
       const int fileSize = fp.size();
 
       if (fileSize <= newPeekReadPos) {
-        fp.seek(0, fs::SeekEnd);
+        if (_peekCompressed) {
+          _peekDecoder.seek(fp, fileSize);
+        } else {
+          fp.seek(0, fs::SeekEnd);
+        }
 
         constexpr size_t errorcode = (size_t)-1;
-        size_t pos = fp.position();
+        size_t pos = getPeekFilePosition();
         if (pos == errorcode) {
           pos = 0;
         }
@@ -166,11 +166,15 @@ void RTC_cache_handler_struct::setPeekFilePos(int newPeekFileNr, int newPeekRead
         return;
       }
 
-      if (fp.seek(newPeekReadPos)) {
+      if (_peekCompressed) {
+        if (_peekDecoder.seek(fp, newPeekReadPos)) {
+          _peekreadpos = _peekDecoder.position();
+        }
+      } else if (fp.seek(newPeekReadPos)) {
         _peekreadpos = newPeekReadPos;
       }
     } else {
-      _peekreadpos = 0;
+      _peekreadpos = _peekCompressed ? _peekDecoder.position() : 0;
     }
     return;
   }
@@ -195,10 +199,21 @@ bool RTC_cache_handler_struct::peek(uint8_t *data, unsigned int size) {
 
   if (!fp) { return false; }
 
-  const size_t bytesRead = fp.read(data, size);
+  size_t bytesRead = 0;
+
+  if (_peekCompressed) {
+    C016_binary_element element;
+
+    if ((size == sizeof(element)) && _peekDecoder.read(fp, element)) {
+      memcpy(data, &element, size);
+      bytesRead = size;
+    }
+  } else {
+    bytesRead = fp.read(data, size);
+  }
 
   constexpr size_t errorcode = (size_t)-1;
-  size_t pos = fp.position();
+  size_t pos = getPeekFilePosition();
   if (pos == errorcode) {
     pos = 0;
   }
@@ -273,7 +288,22 @@ bool RTC_cache_handler_struct::flush() {
         fp.close();
       }
 
-      int bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      int bytesToWrite = RTC_cache.writePos;
+      int bytesWritten = 0;
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+      if (_writeCompressed) {
+        std::vector<uint8_t> block;
+
+        if (ControllerCache_encodeBlock(&RTC_cache_data[0], RTC_cache.writePos, block)) {
+          bytesToWrite = block.size();
+          bytesWritten = fw.write(&block[0], block.size());
+        }
+      } else
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+      {
+        bytesWritten = fw.write(&RTC_cache_data[0], RTC_cache.writePos);
+      }
 
       delay(0);
       fw.flush();
@@ -282,7 +312,7 @@ bool RTC_cache_handler_struct::flush() {
         #endif // ifdef RTC_STRUCT_DEBUG
 
 
-      if ((bytesWritten < RTC_cache.writePos) /*|| (fw.size() == filesize)*/) {
+      if ((bytesWritten < bytesToWrite) /*|| (fw.size() == filesize)*/) {
           #ifdef RTC_STRUCT_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
@@ -626,6 +656,16 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
         addLog(LOG_LEVEL_ERROR, F("RTC  : error opening file"));
           #endif // ifdef RTC_STRUCT_DEBUG
       } else {
+#if FEATURE_RTC_CACHE_COMPRESSION
+
+        // Keep the format of an existing file, so files are never mixed.
+        if (fw.size() == 0) {
+          _writeCompressed = ControllerCache_writeCompressedHeader(fw);
+        } else {
+          fs::File f       = tryOpenFile(fname, "r");
+          _writeCompressed = f && ControllerCache_isCompressedFile(f);
+        }
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
           #ifdef RTC_STRUCT_DEBUG
 
         if (loglevelActiveFor(LOG_LEVEL_INFO)) {
@@ -649,6 +689,27 @@ bool RTC_cache_handler_struct::prepareFileForWrite() {
   return false;
 }
 
+void RTC_cache_handler_struct::openPeekFile(int fileNr) {
+  const String fname = createCacheFilename(fileNr);
+
+  if (fname.isEmpty()) { return; }
+
+  fp = tryOpenFile(fname, "r");
+
+  _peekCompressed = fp && ControllerCache_isCompressedFile(fp);
+
+  if (_peekCompressed) {
+    _peekDecoder.reset();
+  }
+}
+
+size_t RTC_cache_handler_struct::getPeekFilePosition() const {
+  if (_peekCompressed && fp) {
+    return _peekDecoder.position();
+  }
+  return fp.position();
+}
+
 void RTC_cache_handler_struct::validateFilePos(int& fileNr, int& readPos) {
   {
     // Check to see if we try to set it to a no longer existing file
@@ -7,6 +7,7 @@
 
 #if FEATURE_RTC_CACHE_STORAGE
 
+#include "../DataStructs/ESPEasyControllerCache_Compression.h"
 #include "../DataStructs/RTCCacheStruct.h"
 
 #include <FS.h>
@@ -99,6 +100,13 @@ private:
 
   bool     prepareFileForWrite();
 
+  // Open the peek file and detect whether it is compressed.
+  void     openPeekFile(int fileNr);
+
+  // Position in the peek file, (size_t)-1 on error.
+  // For compressed files this is the position right after the last decoded sample.
+  size_t   getPeekFilePosition() const;
+
 #ifdef RTC_STRUCT_DEBUG
   void     rtc_debug_log(const String& description,
                          size_t        nrBytes);
@@ -114,6 +122,12 @@ private:
   size_t   _peekfilenr  = 0;
   size_t   _peekreadpos = 0;
 
+  ControllerCache_Decoder _peekDecoder;
+  bool                    _peekCompressed = false;
+#if FEATURE_RTC_CACHE_COMPRESSION
+  bool                    _writeCompressed = false;
+#endif // if FEATURE_RTC_CACHE_COMPRESSION
+
   uint8_t storageLocation = CACHE_STORAGE_SPIFFS;
   bool    writeError      = false;
 };
@@ -0,0 +1,75 @@
+#include "../DataStructs/RulesCompiledLine.h"
+
+#include "../Helpers/StringConverter.h"
+
+
+RulesCompiledLine::RulesCompiledLine(String&& line) :
+  _type(Type::Command),
+  _hasEventValue(false),
+  _needsParseTemplate(false),
+  _startsWithPercentEvent(false)
+{
+  move_special(_line, std::move(line));
+
+  _hasEventValue          = _line.indexOf(F("%event")) != -1;
+  _startsWithPercentEvent = _line.startsWith(F("%event"));
+
+  // Only consider characters which parseTemplate() may replace.
+  // See parseSystemVariables(), findNextDevValNameInString()
+  // and parse_string_commands()
+  int firstTemplateChar = -1;
+
+  for (size_t i = 0; i < _line.length() && firstTemplateChar == -1; ++i) {
+    switch (_line[i]) {
+      case '%':
+      case '[':
+      case '{':
+      case '&':
+      case '\\':
+        firstTemplateChar = i;
+        break;
+    }
+  }
+  _needsParseTemplate = firstTemplateChar != -1;
+
+  if (_line.equalsIgnoreCase(F("endon"))) {
+    _type = Type::EndOn;
+    return;
+  }
+
+  // The keyword is determined on the line after substitution.
+  // Only when the first word cannot change, it can be classified now.
+  const int firstSpace = _line.indexOf(' ');
+
+  if ((firstTemplateChar != -1) &&
+      ((firstSpace == -1) || (firstTemplateChar < firstSpace))) {
+    _type = Type::Dynamic;
+    return;
+  }
+
+  String keyword = firstSpace == -1 ? _line : _line.substring(0, firstSpace + 1);
+
+  keyword.toLowerCase();
+
+  if (equals(keyword, F("on "))) {
+    _type = Type::On;
+  } else if (equals(keyword, F("if "))) {
+    _type = Type::If;
+  } else if (equals(keyword, F("elseif "))) {
+    _type = Type::ElseIf;
+  } else if (equals(keyword, F("else"))) {
+    _type = Type::Else;
+  } else if (equals(keyword, F("endif"))) {
+    _type = Type::EndIf;
+  }
+}
+
+uint8_t RulesCompiledLine::conditionOffset() const
+{
+  switch (_type) {
+    case Type::If:     return 3;
+    case Type::ElseIf: return 7;
+    default: break;
+  }
+  return 0;
+}
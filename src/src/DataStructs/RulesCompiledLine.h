@@ -0,0 +1,54 @@
+#ifndef DATASTRUCTS_RULESCOMPILEDLINE_H
+#define DATASTRUCTS_RULESCOMPILEDLINE_H
+
+#include "../../ESPEasy_common.h"
+
+
+// A rules line which has been classified when the rules file was read.
+// This allows to execute a matched "on ... do" block without having to
+// parse the keywords of each line again for every event.
+struct RulesCompiledLine {
+  enum class Type : uint8_t {
+    On,      // "on ... do" line, may be a one-liner
+    EndOn,
+    If,
+    ElseIf,
+    Else,
+    EndIf,
+    Command,
+
+    // Keyword of the line can only be determined after substitution
+    // of variables, so it must be parsed at runtime.
+    Dynamic
+  };
+
+  explicit RulesCompiledLine(String&& line);
+
+  // Line contains "%event", so substitute_eventvalue() must be called
+  bool hasEventValue() const {
+    return _hasEventValue;
+  }
+
+  // Line contains characters which may be replaced by parseTemplate()
+  bool needsParseTemplate() const {
+    return _needsParseTemplate;
+  }
+
+  bool startsWithPercentEvent() const {
+    return _startsWithPercentEvent;
+  }
+
+  // Offset in _line where the condition of an if/elseif starts.
+  uint8_t conditionOffset() const;
+
+  String _line;
+  Type   _type;
+
+private:
+
+  bool _hasEventValue          : 1;
+  bool _needsParseTemplate     : 1;
+  bool _startsWithPercentEvent : 1;
+};
+
+#endif // ifndef DATASTRUCTS_RULESCOMPILEDLINE_H
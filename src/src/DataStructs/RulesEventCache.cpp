@@ -24,6 +24,8 @@ RulesEventCache_element::RulesEventCache_element(
 void RulesEventCache::clear()
 {
   _eventCache.clear();
+  _eventIndex.clear();
+  _wildcardIndex.clear();
   _initialized = false;
 }
 
@@ -46,6 +48,15 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
     reserve_special(action, action.length());
     #endif
 
+    String key;
+    const uint16_t index = _eventCache.size();
+
+    if (getIndexKey(event, true, key)) {
+      _eventIndex[key].push_back(index);
+    } else {
+      _wildcardIndex.push_back(index);
+    }
+
     _eventCache.emplace_back(filename, pos, std::move(event), std::move(action));
     return true;
   }
@@ -54,49 +65,131 @@ bool RulesEventCache::addLine(const String& line, const String& filename, size_t
 
 RulesEventCache_vector::const_iterator RulesEventCache::findMatchingRule(const String& event, bool optimize)
 {
-  RulesEventCache_vector::iterator it   = _eventCache.begin();
-//  RulesEventCache_vector::iterator prev = _eventCache.end();
-
   // FIXME TD-er: Disable optimize as it has some side effects.
   // For example, matching a specific event first and then a more generic one is perfectly normal to do.
   // But this optimization will then put the generic one in front as it will be matched more often.
   // Thus it will never match the more specific one anymore.
+  //
+  // Only the rules with the same event name and the wildcard rules need to be checked.
+  // Both lists are in order of declaration, so merge them to keep the first match semantics.
+  const RulesEventCache_indices *named = nullptr;
 
-
-  for (; it != _eventCache.end(); ++it)
   {
+    String key;
+
+    if (getIndexKey(event, false, key)) {
+      auto it = _eventIndex.find(key);
+
+      if (it != _eventIndex.end()) {
+        named = &(it->second);
+      }
+    }
+  }
+
+  const size_t nrNamed    = named == nullptr ? 0 : named->size();
+  const size_t nrWildcard = _wildcardIndex.size();
+  size_t n                = 0;
+  size_t w                = 0;
+
+  while (n < nrNamed || w < nrWildcard) {
+    uint16_t index;
+
+    if ((w >= nrWildcard) || ((n < nrNamed) && ((*named)[n] < _wildcardIndex[w]))) {
+      index = (*named)[n++];
+    } else {
+      index = _wildcardIndex[w++];
+    }
+
+    ++_nrCandidatesTested;
     START_TIMER
-    const bool match = ruleMatch(event, it->_event);
+    const bool match = ruleMatch(event, _eventCache[index]._event);
     STOP_TIMER(RULES_MATCH);
 
     if (match) {
-      /*
-      if (optimize) {
-        it->_nrTimesMatched++;
-
-        if (prev != _eventCache.end()) {
-          // Check to see if we need to place this one more to the front of the vector
-          // to speed up parsing.
-          if (prev->_nrTimesMatched < it->_nrTimesMatched) {
-            std::swap(*prev, *it);
-            return prev;
-          }
-        }
-      }
-      */
-      return it;
+      ++_nrHits;
+      return _eventCache.begin() + index;
     }
-/*
-    if (optimize) {
-      if (prev == _eventCache.end()) {
-        prev = it;
-      }
-      else if (prev->_nrTimesMatched > it->_nrTimesMatched) {
-        // Found one that's having a lower match rate
-        prev = it;
+  }
+  ++_nrMisses;
+  return _eventCache.end();
+}
+
+bool RulesEventCache::mayMatch(const String& eventName) const
+{
+  if (!_wildcardIndex.empty()) {
+    return true;
+  }
+  String key;
+
+  if (!getIndexKey(eventName, false, key)) {
+    return true;
+  }
+  return _eventIndex.find(key) != _eventIndex.end();
+}
+
+float RulesEventCache::getAvgCandidatesTested() const
+{
+  const uint32_t nrLookups = _nrHits + _nrMisses;
+
+  if (nrLookups == 0) { return 0.0f; }
+  return static_cast<float>(_nrCandidatesTested) / nrLookups;
+}
+
+void RulesEventCache::resetStats()
+{
+  _nrHits             = 0;
+  _nrMisses           = 0;
+  _nrCandidatesTested = 0;
+}
+
+bool RulesEventCache::getIndexKey(const String& eventOrRule, bool isRule, String& key)
+{
+  const size_t length = eventOrRule.length();
+  size_t start        = 0;
+
+  while (start < length && eventOrRule[start] == ' ') {
+    ++start;
+  }
+
+  if (isRule) {
+    if (equals(eventOrRule, '*')) {
+      return false;
+    }
+
+    // Literal string events (starting with '!') match on a prefix when the rule has no '#'
+    if ((start < length) && (eventOrRule[start] == '!') && (eventOrRule.indexOf('#') == -1)) {
+      return false;
+    }
+  }
+
+  size_t end = start;
+
+  for (; end < length; ++end) {
+    const char c = eventOrRule[end];
+
+    if ((c == '#') || (c == '=') || (c == '<') || (c == '>')) {
+      break;
+    }
+
+    if ((c == '!') && ((end + 1) < length) && (eventOrRule[end + 1] == '=')) {
+      break;
+    }
+
+    if (isRule) {
+      switch (c) {
+        case '*':
+        // Rules are processed by parseTemplate() before matching,
+        // so the name may be different after substitution.
+        case '%':
+        case '[':
+        case '{':
+        case '&':
+        case '\\':
+          return false;
       }
     }
-    */
   }
-  return it;
+  key = eventOrRule.substring(start, end);
+  key.toLowerCase();
+  return true;
 }
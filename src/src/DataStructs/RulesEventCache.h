@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <map>
 #include <vector>
 
 struct RulesEventCache_element {
@@ -20,6 +21,12 @@ struct RulesEventCache_element {
 
 typedef std::vector<RulesEventCache_element> RulesEventCache_vector;
 
+// Indices in RulesEventCache_vector, in order of declaration in the rules.
+typedef std::vector<uint16_t>                 RulesEventCache_indices;
+
+// Key is the lower case event name (part before '#', '=' or compare operator)
+typedef std::map<String, RulesEventCache_indices> RulesEventCache_index;
+
 class RulesEventCache {
 public:
 
@@ -39,13 +46,47 @@ public:
 
   RulesEventCache_vector::const_iterator findMatchingRule(const String& event, bool optimize);
 
+  // Return false when no rule can match an event with this name.
+  // Only the part used as index key is considered, e.g. the task name.
+  bool mayMatch(const String& eventName) const;
+
   RulesEventCache_vector::const_iterator end() const {
     return _eventCache.end();
   }
 
+  // Statistics on the lookup of events
+  uint32_t getNrHits() const {
+    return _nrHits;
+  }
+
+  uint32_t getNrMisses() const {
+    return _nrMisses;
+  }
+
+  float getAvgCandidatesTested() const;
+
+  void  resetStats();
+
+  // Get the name part of an event or rule used as key for the index.
+  // Return false when the rule may match events with a different name,
+  // for example when it contains a wildcard or variables in the name part.
+  static bool getIndexKey(const String& eventOrRule,
+                          bool          isRule,
+                          String      & key);
+
 private:
 
   RulesEventCache_vector _eventCache;
+
+  RulesEventCache_index _eventIndex;
+
+  // Rules which must be tested for every event.
+  RulesEventCache_indices _wildcardIndex;
+
+  uint32_t _nrHits             = 0;
+  uint32_t _nrMisses           = 0;
+  uint32_t _nrCandidatesTested = 0;
+
   bool _initialized = false;
 };
 
@@ -0,0 +1,171 @@
+#include "../DataStructs/SettingsFilePageCache.h"
+
+#ifndef LIMIT_BUILD_SIZE
+
+# include "../DataStructs/TimingStats.h"
+# include "../Helpers/CRC_functions.h"
+# include "../Helpers/ESPEasy_Storage.h"
+
+bool SettingsFilePageCache::read(const String& fname, int offset, uint8_t *memAddress, int datasize)
+{
+  if ((offset < 0) || (datasize <= 0)) {
+    return false;
+  }
+  const uint32_t fileHash = computeHash(fname);
+  const uint32_t end      = offset + datasize;
+  uint32_t pos            = offset;
+  bool     res            = true;
+  fs::File f; // Only opened when a page is not cached
+
+  while (pos < end) {
+    const uint32_t pageIndex = pos / SETTINGS_FILE_PAGE_SIZE;
+    const Page    *page      = getPage(fname, fileHash, pageIndex, f);
+
+    if (page == nullptr) {
+      res = false;
+      break;
+    }
+    const uint32_t posInPage = pos - (pageIndex * SETTINGS_FILE_PAGE_SIZE);
+    uint8_t       *dest      = memAddress + (pos - offset);
+
+    if (posInPage >= page->_length) {
+      // Beyond end of file.
+      // Like reading directly from file, leave memory untouched when
+      // nothing can be read at all, else set the remainder to 0.
+      if (pos != static_cast<uint32_t>(offset)) {
+        memset(dest, 0u, end - pos);
+      }
+      break;
+    }
+    const uint32_t chunkSize = _min(static_cast<uint32_t>(page->_length - posInPage), end - pos);
+    memcpy(dest, page->_data + posInPage, chunkSize);
+    pos += chunkSize;
+
+    if ((page->_length < SETTINGS_FILE_PAGE_SIZE) && (pos < end)) {
+      // Last page of the file
+      memset(memAddress + (pos - offset), 0u, end - pos);
+      break;
+    }
+  }
+
+  if (f) {
+    f.close();
+  }
+  return res;
+}
+
+void SettingsFilePageCache::invalidate(const String& fname)
+{
+  if (_pages.empty()) {
+    return;
+  }
+  const uint32_t fileHash = computeHash(fname);
+
+  for (auto it = _pages.begin(); it != _pages.end(); ++it) {
+    if (it->_fileHash == fileHash) {
+      it->_valid = false;
+    }
+  }
+}
+
+void SettingsFilePageCache::clear()
+{
+  _pages.clear();
+  _pages.shrink_to_fit();
+  _useCounter = 0;
+}
+
+uint32_t SettingsFilePageCache::computeHash(const String& fname)
+{
+  const String patched_fname = patch_fname(fname);
+
+  return calc_CRC32(reinterpret_cast<const uint8_t *>(patched_fname.c_str()), patched_fname.length());
+}
+
+const SettingsFilePageCache::Page * SettingsFilePageCache::getPage(
+  const String& fname,
+  uint32_t      fileHash,
+  uint32_t      pageIndex,
+  fs::File    & f)
+{
+  for (auto it = _pages.begin(); it != _pages.end(); ++it) {
+    if (it->_valid && (it->_fileHash == fileHash) && (it->_pageIndex == pageIndex)) {
+      it->_lastUsed = ++_useCounter;
+      ++_nrHits;
+      return &(*it);
+    }
+  }
+  ++_nrMisses;
+
+  if (!f) {
+    f = tryOpenFile(fname, F("r"));
+
+    if (!f) {
+      return nullptr;
+    }
+  }
+  Page *page = getFreePage();
+
+  if (page == nullptr) {
+    return nullptr;
+  }
+  START_TIMER;
+  const uint32_t fileSize  = f.size();
+  const uint32_t pageStart = pageIndex * SETTINGS_FILE_PAGE_SIZE;
+  uint16_t length          = 0;
+
+  if (fileSize > pageStart) {
+    length = _min(fileSize - pageStart, static_cast<uint32_t>(SETTINGS_FILE_PAGE_SIZE));
+
+    if (!f.seek(pageStart, fs::SeekSet) ||
+        (f.read(page->_data, length) != length)) {
+      return nullptr;
+    }
+  }
+  page->_fileHash  = fileHash;
+  page->_pageIndex = pageIndex;
+  page->_lastUsed  = ++_useCounter;
+  page->_length    = length;
+  page->_valid     = true;
+  STOP_TIMER(LOADFILE_PAGE);
+  return page;
+}
+
+SettingsFilePageCache::Page * SettingsFilePageCache::getFreePage()
+{
+  for (auto it = _pages.begin(); it != _pages.end(); ++it) {
+    if (!it->_valid) {
+      return &(*it);
+    }
+  }
+
+  if (_pages.size() < SETTINGS_FILE_PAGE_CACHE_SIZE) {
+    # ifdef USE_SECOND_HEAP
+
+    // Page data is accessed per byte, so keep it out of the 2nd heap
+    HeapSelectDram ephemeral;
+    # endif // ifdef USE_SECOND_HEAP
+
+    if (_pages.capacity() < SETTINGS_FILE_PAGE_CACHE_SIZE) {
+      _pages.reserve(SETTINGS_FILE_PAGE_CACHE_SIZE);
+    }
+    _pages.emplace_back();
+    return &_pages.back();
+  }
+
+  // Evict the least recently used page
+  Page *lru = nullptr;
+
+  for (auto it = _pages.begin(); it != _pages.end(); ++it) {
+    if ((lru == nullptr) || (it->_lastUsed < lru->_lastUsed)) {
+      lru = &(*it);
+    }
+  }
+
+  if (lru != nullptr) {
+    lru->_valid = false;
+  }
+  return lru;
+}
+
+#endif // ifndef LIMIT_BUILD_SIZE
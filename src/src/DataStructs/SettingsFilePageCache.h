@@ -0,0 +1,88 @@
+#ifndef DATASTRUCTS_SETTINGSFILEPAGECACHE_H
+#define DATASTRUCTS_SETTINGSFILEPAGECACHE_H
+
+#include "../../ESPEasy_common.h"
+
+#ifndef LIMIT_BUILD_SIZE
+
+# include <FS.h>
+# include <vector>
+
+// Size of a cached page, aligned to the page size of the file system.
+# ifndef SETTINGS_FILE_PAGE_SIZE
+#  define SETTINGS_FILE_PAGE_SIZE  256
+# endif // ifndef SETTINGS_FILE_PAGE_SIZE
+
+// Max. number of pages kept in memory.
+// Memory is allocated on demand, up to this number of pages.
+# ifndef SETTINGS_FILE_PAGE_CACHE_SIZE
+#  ifdef ESP32
+#   define SETTINGS_FILE_PAGE_CACHE_SIZE  16
+#  else // ifdef ESP32
+#   define SETTINGS_FILE_PAGE_CACHE_SIZE  4
+#  endif // ifdef ESP32
+# endif // ifndef SETTINGS_FILE_PAGE_CACHE_SIZE
+
+
+// Least recently used cache of file pages, used by LoadFromFile()
+// to avoid opening and seeking in settings files (e.g. config.dat)
+// for every small struct being loaded.
+// Pages of a file are invalidated when the file is opened for writing.
+class SettingsFilePageCache {
+public:
+
+  // Copy datasize bytes starting at offset into memAddress.
+  // Missing pages are read from the file.
+  // Return false when the file could not be read, so the caller can
+  // handle the error.
+  bool read(const String& fname,
+            int           offset,
+            uint8_t      *memAddress,
+            int           datasize);
+
+  void invalidate(const String& fname);
+
+  void clear();
+
+  uint32_t getNrHits() const {
+    return _nrHits;
+  }
+
+  uint32_t getNrMisses() const {
+    return _nrMisses;
+  }
+
+private:
+
+  struct Page {
+    uint32_t _fileHash  = 0;
+    uint32_t _pageIndex = 0;
+    uint32_t _lastUsed  = 0;
+
+    // Nr of bytes present in the file, less than SETTINGS_FILE_PAGE_SIZE
+    // for the last page of a file.
+    uint16_t _length = 0;
+    bool     _valid  = false;
+    uint8_t  _data[SETTINGS_FILE_PAGE_SIZE]{};
+  };
+
+  static uint32_t computeHash(const String& fname);
+
+  // Return the page, loaded from file f when not cached.
+  // Return nullptr when the page could not be read.
+  const Page* getPage(const String& fname,
+                      uint32_t      fileHash,
+                      uint32_t      pageIndex,
+                      fs::File    & f);
+
+  Page      * getFreePage();
+
+  std::vector<Page>_pages;
+  uint32_t _useCounter = 0;
+  uint32_t _nrHits     = 0;
+  uint32_t _nrMisses   = 0;
+};
+
+#endif // ifndef LIMIT_BUILD_SIZE
+
+#endif // ifndef DATASTRUCTS_SETTINGSFILEPAGECACHE_H
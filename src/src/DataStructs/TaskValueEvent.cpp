@@ -0,0 +1,115 @@
+#include "../DataStructs/TaskValueEvent.h"
+
+#include "../../_Plugin_Helper.h"
+
+#include "../DataStructs/ESPEasy_EventStruct.h"
+#include "../DataTypes/SensorVType.h"
+#include "../Globals/Cache.h"
+#include "../Globals/Device.h"
+#include "../Globals/Plugins.h"
+#include "../Globals/RuntimeData.h"
+#include "../Helpers/ESPEasy_math.h"
+#include "../Helpers/Misc.h"
+#include "../Helpers/StringConverter.h"
+#include "../Helpers/StringConverter_Numerical.h"
+
+
+bool TaskValueEvent::set(struct EventStruct *event, uint8_t varNr)
+{
+  clear();
+
+  if (event == nullptr) { return false; }
+
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(event->TaskIndex);
+
+  if (!validDeviceIndex(DeviceIndex) || Device[DeviceIndex].HasFormatUserVar) {
+    return false;
+  }
+
+  const Sensor_VType sensorType = event->getSensorType();
+
+  if (!isFloatOutputDataType(sensorType)) {
+    return false;
+  }
+
+  const int valueCount = getValueCountForTask(event->TaskIndex);
+  int first = varNr;
+  int last  = varNr + 1;
+
+  if (varNr == VARS_PER_TASK) {
+    first = 0;
+    last  = valueCount;
+  }
+
+  if ((last > valueCount) || (last > VARS_PER_TASK) || (first >= last)) {
+    return false;
+  }
+
+  for (int i = first; i < last; ++i) {
+    // Same number of decimals as used in doFormatUserVar()
+    uint8_t decimals = 0;
+
+    if (Device[DeviceIndex].configurableDecimals()) {
+      decimals = Cache.getTaskDeviceValueDecimals(event->TaskIndex, i);
+    }
+    values[nrValues]     = UserVar.getAsDouble(event->TaskIndex, i, sensorType);
+    nrDecimals[nrValues] = decimals;
+    ++nrValues;
+  }
+  TaskIndex = event->TaskIndex;
+  VarNr     = varNr;
+  return true;
+}
+
+String TaskValueEvent::getEventName() const
+{
+  if (!isValid()) {
+    return EMPTY_STRING;
+  }
+  return strformat(
+    F("%s#%s"),
+    getTaskDeviceName(TaskIndex).c_str(),
+    isCombined() ? "All" : Cache.getTaskDeviceValueName(TaskIndex, VarNr).c_str());
+}
+
+String TaskValueEvent::getEventValues() const
+{
+  String res;
+
+  reserve_special(res, 8 * nrValues);
+
+  for (uint8_t i = 0; i < nrValues; ++i) {
+    if (i != 0) {
+      res += ',';
+    }
+
+    // Same as TaskValues_Data_t::getAsString()
+    uint8_t decimals = nrDecimals[i];
+
+    if (decimals == 254) {
+      decimals = maxNrDecimals_fpType(values[i]);
+    }
+    String value = ::toString(values[i], decimals);
+    value.trim();
+    res += value;
+  }
+  return res;
+}
+
+String TaskValueEvent::toString() const
+{
+  if (!isValid()) {
+    return EMPTY_STRING;
+  }
+  return strformat(
+    F("%s=%s"),
+    getEventName().c_str(),
+    getEventValues().c_str());
+}
+
+void TaskValueEvent::clear()
+{
+  TaskIndex = INVALID_TASK_INDEX;
+  VarNr     = 0;
+  nrValues  = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef DATASTRUCTS_TASKVALUEEVENT_H
+#define DATASTRUCTS_TASKVALUEEVENT_H
+
+#include "../../ESPEasy_common.h"
+
+#include "../DataTypes/TaskIndex.h"
+
+
+// Event for new task values, as generated by createRuleEvents()
+// The values are kept as numbers in the event queue.
+// The event string (Taskname#Valuename=value or Taskname#All=value1,value2,...)
+// is only generated when the event is processed by the rules or logged.
+//
+// Only float task values are stored this way, as these are formatted
+// using just the number of decimals.
+struct TaskValueEvent {
+  TaskValueEvent() = default;
+
+  // Store the current task value varNr, to be formatted like formatUserVarNoCheck()
+  // Use varNr = VARS_PER_TASK to store all task values for a combined event.
+  // Return false when the values cannot be stored as TaskValueEvent,
+  // for example when the plugin uses its own formatting.
+  bool set(struct EventStruct *event,
+           uint8_t             varNr);
+
+  bool isValid() const {
+    return validTaskIndex(TaskIndex) && (nrValues != 0);
+  }
+
+  bool isCombined() const {
+    return VarNr == VARS_PER_TASK;
+  }
+
+  // Return true when both will result in the same event name.
+  bool sameName(const TaskValueEvent& other) const {
+    return TaskIndex == other.TaskIndex && VarNr == other.VarNr;
+  }
+
+  // Taskname#Valuename or Taskname#All
+  String getEventName() const;
+
+  // Values separated by a comma, like %eventvalue1%,%eventvalue2%,...
+  String getEventValues() const;
+
+  String toString() const;
+
+  void   clear();
+
+  float       values[VARS_PER_TASK]{};
+  uint8_t     nrDecimals[VARS_PER_TASK]{};
+  taskIndex_t TaskIndex = INVALID_TASK_INDEX;
+
+  // VARS_PER_TASK for all task values combined in a single event.
+  uint8_t VarNr    = 0;
+  uint8_t nrValues = 0;
+};
+
+
+#endif // ifndef DATASTRUCTS_TASKVALUEEVENT_H
@@ -22,6 +22,15 @@ void TimingStats::add(int64_t time) {
   if (time > static_cast<int64_t>(_maxVal)) { _maxVal = time; }
 
   if (time < static_cast<int64_t>(_minVal)) { _minVal = time; }
+
+  uint16_t& bucketCount = _buckets[getBucket(time < 0 ? 0 : time)];
+
+  if (bucketCount == 0xFFFF) {
+    for (uint8_t i = 0; i < TIMING_STATS_NR_BUCKETS; ++i) {
+      _buckets[i] = (_buckets[i] + 1) >> 1;
+    }
+  }
+  ++bucketCount;
 }
 
 void TimingStats::reset() {
@@ -29,6 +38,10 @@ void TimingStats::reset() {
   _count     = 0;
   _maxVal    = 0;
   _minVal    = 4294967295;
+
+  for (uint8_t i = 0; i < TIMING_STATS_NR_BUCKETS; ++i) {
+    _buckets[i] = 0;
+  }
 }
 
 bool TimingStats::isEmpty() const {
@@ -58,6 +71,72 @@ bool TimingStats::thresholdExceeded(const uint64_t& threshold) const {
   return _maxVal > threshold;
 }
 
+uint64_t TimingStats::getPercentile(float fraction) const {
+  uint32_t total = 0;
+
+  for (uint8_t i = 0; i < TIMING_STATS_NR_BUCKETS; ++i) {
+    total += _buckets[i];
+  }
+
+  if (total == 0) {
+    return 0;
+  }
+  const float target = fraction * total;
+  uint32_t cumulative = 0;
+  uint8_t  bucket     = 0;
+
+  while (bucket < (TIMING_STATS_NR_BUCKETS - 1) &&
+         (cumulative + _buckets[bucket]) < target) {
+    cumulative += _buckets[bucket];
+    ++bucket;
+  }
+
+  const uint64_t lower = (bucket == 0) ? 0 : getBucketUpperBound(bucket - 1);
+  uint64_t upper       = getBucketUpperBound(bucket);
+
+  if ((upper == 0) || (upper > _maxVal)) {
+    upper = _maxVal;
+  }
+  uint64_t res = lower;
+
+  if ((_buckets[bucket] != 0) && (upper > lower)) {
+    res += static_cast<uint64_t>((upper - lower) * ((target - cumulative) / _buckets[bucket]));
+  }
+
+  if (res < _minVal) { return _minVal; }
+
+  if (res > _maxVal) { return _maxVal; }
+  return res;
+}
+
+uint64_t TimingStats::getBucketUpperBound(uint8_t bucket) {
+  if (bucket >= (TIMING_STATS_NR_BUCKETS - 1)) {
+    return 0;
+  }
+  return 1ull << (TIMING_STATS_FIRST_BUCKET_LOG2 + bucket);
+}
+
+uint16_t TimingStats::getBucketCount(uint8_t bucket) const {
+  if (bucket >= TIMING_STATS_NR_BUCKETS) {
+    return 0;
+  }
+  return _buckets[bucket];
+}
+
+uint8_t TimingStats::getBucket(uint64_t time) {
+  if (time < (1ull << TIMING_STATS_FIRST_BUCKET_LOG2)) {
+    return 0;
+  }
+
+  // Position of the highest set bit, so no loop is needed.
+  const uint8_t bucket = (63 - __builtin_clzll(time)) - TIMING_STATS_FIRST_BUCKET_LOG2 + 1;
+
+  if (bucket >= TIMING_STATS_NR_BUCKETS) {
+    return TIMING_STATS_NR_BUCKETS - 1;
+  }
+  return bucket;
+}
+
 /********************************************************************************************\
    Functions used for displaying timing stats
  \*********************************************************************************************/
@@ -210,6 +289,7 @@ bool mustLogCFunction(CPlugin::Function function) {
 const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
   switch (stat) {
     case TimingStatsElements::LOADFILE_STATS:             return F("Load File");
+    case TimingStatsElements::LOADFILE_PAGE:              return F("Load File Page (not cached)");
     case TimingStatsElements::SAVEFILE_STATS:             return F("Save File");
     case TimingStatsElements::LOOP_STATS:                 return F("Loop");
     case TimingStatsElements::PLUGIN_CALL_50PS:           return F("Plugin call 50 p/s");
@@ -221,6 +301,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::SENSOR_SEND_TASK:           return F("SensorSendTask()");
     case TimingStatsElements::COMMAND_EXEC_INTERNAL:      return F("Exec Internal Command");
     case TimingStatsElements::COMMAND_DECODE_INTERNAL:    return F("Decode Internal Command");
+    case TimingStatsElements::COMMAND_DECODE_INTERNAL_NOT_MATCHED: return F("Decode Internal Command (not matched)");
     case TimingStatsElements::CONSOLE_LOOP:               return F("Console loop()");
     case TimingStatsElements::CONSOLE_WRITE_SERIAL:       return F("Console out");
     case TimingStatsElements::SEND_DATA_STATS:            return F("sendData()");
@@ -265,6 +346,7 @@ const __FlashStringHelper* getMiscStatsName_F(TimingStatsElements stat) {
     case TimingStatsElements::HANDLE_SCHEDULER_IDLE:      return F("handle_schedule() idle");
     case TimingStatsElements::HANDLE_SCHEDULER_TASK:      return F("handle_schedule() task");
     case TimingStatsElements::PARSE_TEMPLATE_PADDED:      return F("parseTemplate_padded()");
+    case TimingStatsElements::PARSE_TEMPLATE_PADDED_CACHED: return F("parseTemplate_padded() parsed template");
     case TimingStatsElements::PARSE_SYSVAR:               return F("parseSystemVariables()");
     case TimingStatsElements::PARSE_SYSVAR_NOCHANGE:      return F("parseSystemVariables() No change");
     case TimingStatsElements::HANDLE_SERVING_WEBPAGE:     return F("handle webpage");
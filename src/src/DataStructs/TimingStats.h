@@ -72,6 +72,7 @@ enum class TimingStatsElements {
   PARSE_SYSVAR,
   PARSE_SYSVAR_NOCHANGE,
   PARSE_TEMPLATE_PADDED,
+  PARSE_TEMPLATE_PADDED_CACHED,
   IS_NUMERICAL,
   FORMAT_USER_VAR,
   PROCESS_SYSTEM_EVENT_QUEUE,
@@ -81,11 +82,13 @@ enum class TimingStatsElements {
   RULES_PARSE_LINE,
   COMMAND_EXEC_INTERNAL,
   COMMAND_DECODE_INTERNAL,
+  COMMAND_DECODE_INTERNAL_NOT_MATCHED,
   CONSOLE_LOOP,
   CONSOLE_WRITE_SERIAL,
   
   // Related to file access
   LOADFILE_STATS,
+  LOADFILE_PAGE,
   LOAD_TASK_SETTINGS,
   LOAD_CUSTOM_TASK_STATS,
   LOAD_CONTROLLER_SETTINGS,
@@ -139,6 +142,12 @@ enum class TimingStatsElements {
 
 #if FEATURE_TIMING_STATS
 
+// Histogram buckets on a log2 scale.
+// Bucket 0 holds durations < 16 usec, bucket N holds durations < (16 << N) usec.
+// The last bucket holds everything >= 262 msec.
+# define TIMING_STATS_NR_BUCKETS       16
+# define TIMING_STATS_FIRST_BUCKET_LOG2 4
+
 class TimingStats {
 public:
 
@@ -152,12 +161,26 @@ public:
                      uint64_t& maxVal) const;
   bool     thresholdExceeded(const uint64_t& threshold) const;
 
+  // Estimate of the duration in usec below which the given fraction (0.0 ... 1.0) of the calls did end.
+  // Interpolated within the histogram bucket, so the resolution is limited to the bucket size.
+  uint64_t getPercentile(float fraction) const;
+
+  // Upper bound in usec of a histogram bucket, 0 for the last (open ended) bucket.
+  static uint64_t getBucketUpperBound(uint8_t bucket);
+
+  uint16_t getBucketCount(uint8_t bucket) const;
+
 private:
 
+  static uint8_t getBucket(uint64_t time);
+
   float _timeTotal;
   uint32_t _count;
   uint64_t _maxVal;
   uint64_t _minVal;
+
+  // Bucket counts are halved when one would overflow, so they keep the distribution, not the absolute count.
+  uint16_t _buckets[TIMING_STATS_NR_BUCKETS] = { 0 };
 };
 
 
@@ -5,6 +5,7 @@
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/Cache.h"
 #include "../Globals/Plugins.h"
+#include "../Globals/Plugins_other.h"
 #include "../Globals/RulesCalculate.h"
 #include "../Helpers/_Plugin_SensorTypeHelper.h"
 #include "../Helpers/CRC_functions.h"
@@ -21,6 +22,7 @@ void UserVarStruct::clear()
   _computed.clear();
 #ifndef LIMIT_BUILD_SIZE
   _preprocessedFormula.clear();
+  _compiledFormula.clear();
 #endif // ifndef LIMIT_BUILD_SIZE
   _prevValue.clear();
 }
@@ -345,6 +347,13 @@ void UserVarStruct::clear_computed(taskIndex_t taskIndex)
         _preprocessedFormula.erase(it);
       }
     }
+    {
+      auto it            = _compiledFormula.find(key);
+
+      if (it != _compiledFormula.end()) {
+        _compiledFormula.erase(it);
+      }
+    }
 #endif // ifndef LIMIT_BUILD_SIZE
     {
       auto it            = _prevValue.find(key);
@@ -435,13 +444,13 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
   {
     START_TIMER;
 
-    formula.replace(F("%value%"), value);
-
     // TD-er: Should we use the set nr of decimals here, or not round at all?
     // See: https://github.com/letscontrolit/ESPEasy/issues/3721#issuecomment-889649437
+    String pvalue;
+
     if (formula_has_prevvalue) {
       const String prev_str = getPreviousValue(taskIndex, varNr, sensorType);
-      formula.replace(F("%pvalue%"), prev_str.isEmpty() ? value : prev_str);
+      pvalue = prev_str.isEmpty() ? value : prev_str;
       /*
       addLog(LOG_LEVEL_INFO, 
         strformat(
@@ -453,8 +462,29 @@ bool UserVarStruct::applyFormula(taskIndex_t    taskIndex,
     }
 
     ESPEASY_RULES_FLOAT_TYPE result{};
+    CalculateReturnCode returnCode;
 
-    if (!isError(Calculate_preProcessed(parseTemplate(formula), result))) {
+#ifndef LIMIT_BUILD_SIZE
+    const RulesCalculate_program *program = getCompiledFormula(taskIndex, varNr, formula);
+    ESPEASY_RULES_FLOAT_TYPE slots[RULES_CALCULATE_NR_SLOTS]{};
+
+    if ((program != nullptr) &&
+        RulesCalculate_t::bindSlotValue(value, slots[0]) &&
+        (!formula_has_prevvalue || RulesCalculate_t::bindSlotValue(pvalue, slots[1]))) {
+      // No need to tokenize the formula again
+      returnCode = Calculate_compiled(*program, slots, result);
+    } else
+#endif // ifndef LIMIT_BUILD_SIZE
+    {
+      formula.replace(F("%value%"), value);
+
+      if (formula_has_prevvalue) {
+        formula.replace(F("%pvalue%"), pvalue);
+      }
+      returnCode = Calculate_preProcessed(parseTemplate(formula), result);
+    }
+
+    if (!isError(returnCode)) {
       _computed[taskIndex].set(varNr, result, sensorType);
     } else {
       // FIXME TD-er: What to do now? Just copy the raw value, set error value or don't update?
@@ -517,6 +547,54 @@ String UserVarStruct::getPreprocessedFormula(taskIndex_t taskIndex, taskVarIndex
 #endif // ifndef LIMIT_BUILD_SIZE
 }
 
+#ifndef LIMIT_BUILD_SIZE
+const RulesCalculate_program * UserVarStruct::getCompiledFormula(taskIndex_t    taskIndex,
+                                                                 taskVarIndex_t varNr,
+                                                                 const String & preprocessedFormula) const
+{
+  if (parseTemplate_CallBack_ptr != nullptr) {
+    return nullptr;
+  }
+  const uint16_t key = makeWord(taskIndex, varNr);
+  auto it            = _compiledFormula.find(key);
+
+  if (it == _compiledFormula.end()) {
+    String formula(preprocessedFormula);
+    formula.replace(F("%value%"),  String(RULES_CALCULATE_SLOT_VALUE));
+    formula.replace(F("%pvalue%"), String(RULES_CALCULATE_SLOT_PVALUE));
+
+    RulesCalculate_program program;
+
+    // Only compile when parseTemplate() will not change anything,
+    // e.g. no references to other task values or system variables.
+    bool canCompile = true;
+
+    for (size_t i = 0; i < formula.length() && canCompile; ++i) {
+      switch (formula[i]) {
+        case '%':
+        case '[':
+        case '{':
+        case '&':
+        case '\\':
+          canCompile = false;
+          break;
+      }
+    }
+
+    if (canCompile) {
+      RulesCalculate.compile(formula, program);
+    }
+    it = _compiledFormula.emplace(key, std::move(program)).first;
+  }
+
+  if (!it->second.isCompiled) {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+#endif // ifndef LIMIT_BUILD_SIZE
+
 String UserVarStruct::getPreviousValue(taskIndex_t taskIndex, taskVarIndex_t varNr, Sensor_VType sensorType) const
 {
   /*
@@ -8,6 +8,8 @@
 #include "../DataTypes/TaskIndex.h"
 #include "../DataTypes/TaskValues_Data.h"
 
+#include "../Helpers/Rules_calculate.h"
+
 #include <vector>
 #include <map>
 
@@ -170,7 +172,14 @@ private:
                           taskVarIndex_t varNr,
                           Sensor_VType   sensorType) const;
 #ifndef LIMIT_BUILD_SIZE
+
+  // Return nullptr when the formula cannot be executed as compiled program.
+  const RulesCalculate_program* getCompiledFormula(taskIndex_t    taskIndex,
+                                                   taskVarIndex_t varNr,
+                                                   const String & preprocessedFormula) const;
+
   mutable std::map<uint16_t, String>_preprocessedFormula;
+  mutable std::map<uint16_t, RulesCalculate_program>_compiledFormula;
 #endif // ifndef LIMIT_BUILD_SIZE
   mutable std::map<uint16_t, String>_prevValue;
 };
@@ -20,9 +20,17 @@
 #define CHUNKED_BUFFER_SIZE         1200
 #endif
 
+// Flash strings of at least this size are not copied into the buffer
+// when they do not fit in the remaining space of the buffer.
+// They are written to the client directly from flash instead.
+#ifndef CHUNKED_FLASH_REFERENCE_SIZE
+#define CHUNKED_FLASH_REFERENCE_SIZE  128
+#endif
+
 Web_StreamingBuffer::Web_StreamingBuffer(void) : lowMemorySkip(false),
   initialRam(0), beforeTXRam(0), duringTXRam(0), finalRam(0), maxCoreUsage(0),
-  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0)
+  maxServerUsage(0), sentBytes(0), flashStringCalls(0), flashStringData(0),
+  flashStringReferenced(0)
 {
   // Make sure this is allocated on the DRAM since access to primary heap is faster
   # ifdef USE_SECOND_HEAP
@@ -104,22 +112,32 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 
   checkFull();
 
+  if (length < 0) {
+    // Only check for \0 when no length was given, length may be given for binary data
+    length = strlen_P(str);
+  }
+
   int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
   if (flush_step < 1) { flush_step = 0; }
 
+  if ((length >= CHUNKED_FLASH_REFERENCE_SIZE) && (length > flush_step)) {
+    // Copying would need a flush anyway.
+    // Send what is already in the buffer and let the client read straight from flash.
+    flush();
+    sendFlashContentBlocking(str, length);
+    flashStringReferenced += length;
+    return *this;
+  }
+
   {
     // Copy to internal buffer and send in chunks
     PGM_P pos = str;
-    while (length != 0) {
+    while (length > 0) {
       if (flush_step == 0) {
         flush();
         flush_step = CHUNKED_BUFFER_SIZE;
       }
       const char c = (char)pgm_read_byte(pos);
-      if (c == '\0' && length < 0) {
-        // Only check for \0 when length was given (e.g. binary data)
-        return *this;
-      }
       this->buf += c;
       ++flashStringData;
       ++pos;
@@ -131,13 +149,16 @@ Web_StreamingBuffer& Web_StreamingBuffer::addFlashString(PGM_P str, int length)
 }
 
 Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
+  return addBuffer(a.c_str(), a.length());
+}
+
+Web_StreamingBuffer& Web_StreamingBuffer::addBuffer(const char *str, size_t length) {
   # ifdef USE_SECOND_HEAP
   HeapSelectDram ephemeral;
   # endif // ifdef USE_SECOND_HEAP
 
   if (lowMemorySkip) { return *this; }
-  const unsigned int length = a.length();
-  if (length == 0) { return *this; }
+  if ((str == nullptr) || (length == 0)) { return *this; }
 
   checkFull();
   int flush_step = CHUNKED_BUFFER_SIZE - this->buf.length();
@@ -145,8 +166,7 @@ Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
   if (flush_step < 1) { flush_step = 0; }
 
   if (length < static_cast<unsigned int>(flush_step)) {
-    // Just use the faster String operator to copy flash strings.
-    this->buf += a;
+    this->buf.concat(str, static_cast<unsigned int>(length));
     return *this;
   }
 
@@ -158,7 +178,7 @@ Web_StreamingBuffer& Web_StreamingBuffer::addString(const String& a) {
     } else {
       const int remaining = length - pos;
       const int fetchLength = flush_step >= remaining ? remaining : flush_step;
-      const char* ch = a.begin() + pos;
+      const char* ch = str + pos;
       this->buf.concat(ch, static_cast<unsigned int>(fetchLength));
       pos += fetchLength;
       flush_step -= fetchLength;
@@ -276,17 +296,17 @@ void Web_StreamingBuffer::endStream() {
 
     finalRam = ESP.getFreeHeap();
 
-/*
 #ifndef BUILD_NO_DEBUG
-        if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        String log = String("Ram usage: Webserver only: ") + maxServerUsage +
-                    " including Core: " + maxCoreUsage +
-                    " flashStringCalls: " + flashStringCalls +
-                    " flashStringData: " + flashStringData;
-        addLog(LOG_LEVEL_DEBUG, log);
-        }
+    if (loglevelActiveFor(LOG_LEVEL_DEBUG_DEV)) {
+      addLogMove(LOG_LEVEL_DEBUG_DEV, strformat(
+        F("Ram usage: Webserver only: %u including Core: %u flashStringCalls: %u copied: %u referenced: %u"),
+        maxServerUsage,
+        maxCoreUsage,
+        flashStringCalls,
+        flashStringData,
+        flashStringReferenced));
+    }
 #endif // ifndef BUILD_NO_DEBUG
-*/
 
   } else {
     if (loglevelActiveFor(LOG_LEVEL_ERROR))
@@ -360,6 +380,37 @@ void Web_StreamingBuffer::sendContentBlocking(String& data) {
   delay(1);
 }
 
+void Web_StreamingBuffer::sendFlashContentBlocking(PGM_P str, size_t length) {
+  #ifdef USE_SECOND_HEAP
+  HeapSelectDram ephemeral;
+  #endif
+
+  delay(0); // Try to prevent WDT reboots
+
+  const uint32_t freeBeforeSend = ESP.getFreeHeap();
+
+  if (beforeTXRam > freeBeforeSend) {
+    beforeTXRam = freeBeforeSend;
+  }
+  duringTXRam = freeBeforeSend;
+
+#if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
+  String size = formatToHex(length) + "\r\n";
+
+  // do chunked transfer encoding ourselves (WebServer doesn't support it)
+  web_server.sendContent(size);
+  web_server.sendContent_P(str, length);
+  web_server.sendContent("\r\n");
+#else // if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
+  // Written as a single chunk, the data is not copied to the heap first.
+  web_server.sendContent_P(str, length);
+#endif // if defined(ESP8266) && defined(ARDUINO_ESP8266_RELEASE_2_3_0)
+  trackCoreMem();
+
+  sentBytes += length;
+  delay(1);
+}
+
 void Web_StreamingBuffer::sendHeaderBlocking(bool allowOriginAll, 
                                              const String& content_type, 
                                              const String& origin,
@@ -25,7 +25,8 @@ public:
   uint32_t maxServerUsage;
   unsigned int sentBytes;
   uint32_t flashStringCalls;
-  uint32_t flashStringData;
+  uint32_t flashStringData;       // Flash string bytes copied into the buffer
+  uint32_t flashStringReferenced; // Flash string bytes sent directly from flash
 
 private:
 
@@ -55,6 +56,9 @@ template <typename T>
   Web_StreamingBuffer& operator+=(const __FlashStringHelper* str);
 
   Web_StreamingBuffer& addFlashString(PGM_P str, int length = -1);
+
+  // Copy from a buffer in RAM, e.g. a number formatted on the stack
+  Web_StreamingBuffer& addBuffer(const char *str, size_t length);
   
 private:
   Web_StreamingBuffer& addString(const String& a);
@@ -94,6 +98,8 @@ public:
 private: 
 
   void sendContentBlocking(String& data);
+  void sendFlashContentBlocking(PGM_P  str,
+                                size_t length);
   void sendHeaderBlocking(bool          allowOriginAll,
                           const String& content_type,
                           const String& origin,
@@ -33,6 +33,7 @@
 #include "../Helpers/Network.h"
 #include "../Helpers/PeriodicalActions.h"
 #include "../Helpers/PortStatus.h"
+#include "../WebServer/EventStream.h"
 
 
 constexpr pluginID_t PLUGIN_ID_MQTT_IMPORT(37);
@@ -84,6 +85,10 @@ void sendData(struct EventStruct *event, bool sendEvents)
     }
   }
 
+#ifdef WEBSERVER_EVENTS
+  events_task_values_updated(event->TaskIndex);
+#endif // ifdef WEBSERVER_EVENTS
+
   lastSend = millis();
   STOP_TIMER(SEND_DATA_STATS);
 }
@@ -979,6 +984,13 @@ void SensorSendTask(struct EventStruct *event, unsigned long timestampUnixTime,
   // If not, then it should be rescheduled after the check to see if it is enabled.
   Scheduler.reschedule_task_device_timer(event->TaskIndex, lasttimer);
 
+  if (isTaskInitPending(event->TaskIndex)) {
+    // PLUGIN_INIT was deferred during boot.
+    // Init will schedule the first read, just like at a normal boot.
+    initPendingTask(event->TaskIndex);
+    return;
+  }
+
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("SensorSendTask"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
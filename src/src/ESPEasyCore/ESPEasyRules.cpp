@@ -64,6 +64,10 @@ void checkRuleSets() {
   Cache.rulesHelper.closeAllFiles();
 }
 
+// Shared between rulesProcessingFile() and rulesProcessingCompiled()
+// as rules may call each other via the "event" command.
+static uint8_t rulesNestingLevel = 0;
+
 /********************************************************************************************\
    Process next event from event queue
  \*********************************************************************************************/
@@ -71,9 +75,14 @@ bool processNextEvent() {
   if (Settings.UseRules)
   {
     String nextEvent;
+    TaskValueEvent taskValueEvent;
 
-    if (eventQueue.getNext(nextEvent)) {
-      rulesProcessing(nextEvent);
+    if (eventQueue.getNext(nextEvent, taskValueEvent)) {
+      if (taskValueEvent.isValid()) {
+        rulesProcessing(taskValueEvent);
+      } else {
+        rulesProcessing(nextEvent);
+      }
       return true;
     }
   }
@@ -109,8 +118,12 @@ void rulesProcessing(const String& event) {
       String filename;
       size_t pos = 0;
       if (Cache.rulesHelper.findMatchingRule(event, filename, pos)) {
+        #ifdef CACHE_RULES_IN_MEMORY
+        eventHandled = rulesProcessingCompiled(filename, event, pos);
+        #else // ifdef CACHE_RULES_IN_MEMORY
         const bool startOnMatched = true; // We already matched the event
         eventHandled = rulesProcessingFile(filename, event, pos, startOnMatched);
+        #endif // ifdef CACHE_RULES_IN_MEMORY
       }
     } else {
       for (uint8_t x = 0; x < RULESETS_MAX && !eventHandled; x++) {
@@ -137,13 +150,30 @@ void rulesProcessing(const String& event) {
 #ifndef BUILD_NO_DEBUG
 
   if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-    addLogMove(LOG_LEVEL_DEBUG, strformat(F("EVENT: %s Processing: %d ms"), event.c_str(), timePassedSince(timer)));
+    addLogFormat(LOG_LEVEL_DEBUG, F("EVENT: %s Processing: %d ms"), event, timePassedSince(timer));
   }
 #endif // ifndef BUILD_NO_DEBUG
   STOP_TIMER(RULES_PROCESSING);
   backgroundtasks();
 }
 
+void rulesProcessing(const TaskValueEvent& event) {
+  if (!Settings.UseRules) {
+    return;
+  }
+
+  if (Settings.OldRulesEngine() &&
+      Settings.EnableRulesCaching() &&
+      !loglevelActiveFor(LOG_LEVEL_INFO)) {
+    // Rules are matched on the task name first, so no need to format the task values
+    // when there is no rule for this task.
+    if (!Cache.rulesHelper.mayMatchEvent(getTaskDeviceName(event.TaskIndex))) {
+      return;
+    }
+  }
+  rulesProcessing(event.toString());
+}
+
 /********************************************************************************************\
    Rules processing
  \*********************************************************************************************/
@@ -166,13 +196,11 @@ bool rulesProcessingFile(const String& fileName,
   }
 #endif // ifndef BUILD_NO_DEBUG
 
-  static uint8_t nestingLevel = 0;
-
-  nestingLevel++;
+  rulesNestingLevel++;
 
-  if (nestingLevel > RULES_MAX_NESTING_LEVEL) {
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
     addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
-    nestingLevel--;
+    rulesNestingLevel--;
     return false;
   }
 
@@ -227,7 +255,7 @@ bool rulesProcessingFile(const String& fileName,
   }
 */
 
-  nestingLevel--;
+  rulesNestingLevel--;
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("rulesProcessingFile2"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -236,6 +264,203 @@ bool rulesProcessingFile(const String& fileName,
 }
 
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+/********************************************************************************************\
+   Apply event value substitution and parseTemplate to a compiled line (or part of it)
+ \*********************************************************************************************/
+static String prepareCompiledLine(const RulesCompiledLine& line, const String& event, uint8_t offset)
+{
+  String res = offset == 0 ? line._line : line._line.substring(offset);
+
+  if (line.hasEventValue() || (substitute_eventvalue_CallBack_ptr != nullptr)) {
+    substitute_eventvalue(res, event);
+  }
+
+  if (line.needsParseTemplate() || (parseTemplate_CallBack_ptr != nullptr)) {
+    res = parseTemplate(res);
+  }
+  return res;
+}
+
+static bool evalCompiledCondition(const RulesCompiledLine& line, const String& event, uint8_t ifBlock)
+{
+  String check = prepareCompiledLine(line, event, line.conditionOffset());
+
+  check.toLowerCase();
+  check.trim();
+  const bool res = conditionMatchExtended(check);
+
+#ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLogFormat(LOG_LEVEL_DEBUG,
+                 F("Lev.%d: [%s %s]=%s"),
+                 ifBlock,
+                 line._type == RulesCompiledLine::Type::If ? "if" : "elseif",
+                 check,
+                 boolToString(res));
+  }
+#endif // ifndef BUILD_NO_DEBUG
+  return res;
+}
+
+/********************************************************************************************\
+   Execute a matched "on ... do" block from the compiled rules lines.
+   The keywords of each line were already determined when the rules file was read,
+   so only the lines which are actually executed are parsed.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos)
+{
+  if (!Settings.UseRules) {
+    return false;
+  }
+  const RulesHelperClass::RulesLines *lines = Cache.rulesHelper.getCompiledLines(fileName);
+
+  if ((lines == nullptr) || (pos >= lines->size()) ||
+      ((*lines)[pos]._type != RulesCompiledLine::Type::On)) {
+    return false;
+  }
+
+  rulesNestingLevel++;
+
+  if (rulesNestingLevel > RULES_MAX_NESTING_LEVEL) {
+    addLog(LOG_LEVEL_ERROR, F("EVENT: Error: Nesting level exceeded!"));
+    rulesNestingLevel--;
+    return false;
+  }
+
+  bool condition[RULES_IF_MAX_NESTING_LEVEL];
+  bool ifBranche[RULES_IF_MAX_NESTING_LEVEL];
+  uint8_t ifBlock     = 0;
+  uint8_t fakeIfBlock = 0;
+
+  {
+    // The "on ... do" line, may hold an action when it is a one-liner.
+    // Use the same parsing as the non compiled rules to split the action.
+    String line = (*lines)[pos]._line;
+
+    if ((*lines)[pos].needsParseTemplate() || (parseTemplate_CallBack_ptr != nullptr)) {
+      line = parseTemplate(line);
+    }
+    String ruleEvent, action;
+
+    if (getEventFromRulesLine(line, ruleEvent, action) && (action.length() > 0)) {
+      START_TIMER
+      bool isCommand = true;
+      processMatchedRule(action, event,
+                         isCommand, condition,
+                         ifBranche, ifBlock, fakeIfBlock);
+      STOP_TIMER(RULES_PROCESS_MATCHED);
+
+      rulesNestingLevel--;
+      backgroundtasks();
+      return true;
+    }
+  }
+
+  // Cannot keep a pointer to the lines, as a command may change the rules files.
+  // Thus look up the lines again each iteration.
+  for (++pos; lines != nullptr && pos < lines->size(); ++pos) {
+    const RulesCompiledLine& line = (*lines)[pos];
+
+    if (line._type == RulesCompiledLine::Type::EndOn) {
+      break;
+    }
+
+    START_TIMER
+    const bool active = (fakeIfBlock == 0) &&
+                        ((ifBlock == 0) || (condition[ifBlock - 1] == ifBranche[ifBlock - 1]));
+
+    switch (line._type) {
+      case RulesCompiledLine::Type::ElseIf:
+
+        if (ifBlock && !fakeIfBlock) {
+          if (ifBranche[ifBlock - 1]) {
+            if (condition[ifBlock - 1]) {
+              ifBranche[ifBlock - 1] = false;
+            } else {
+              condition[ifBlock - 1] = evalCompiledCondition(line, event, ifBlock);
+            }
+          }
+        }
+        break;
+      case RulesCompiledLine::Type::If:
+
+        if (ifBlock < RULES_IF_MAX_NESTING_LEVEL) {
+          if (active) {
+            ifBlock++;
+            condition[ifBlock - 1] = evalCompiledCondition(line, event, ifBlock);
+            ifBranche[ifBlock - 1] = true;
+          } else {
+            fakeIfBlock++;
+          }
+        } else {
+          fakeIfBlock++;
+
+          if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+            addLogMove(LOG_LEVEL_ERROR, strformat(F("Lev.%d: Error: IF Nesting level exceeded!"), ifBlock));
+          }
+        }
+        break;
+      case RulesCompiledLine::Type::Else:
+
+        if (!fakeIfBlock && ifBlock) {
+          ifBranche[ifBlock - 1] = false;
+        }
+        break;
+      case RulesCompiledLine::Type::EndIf:
+
+        if (fakeIfBlock) {
+          fakeIfBlock--;
+        } else if (ifBlock) {
+          ifBlock--;
+        }
+        break;
+      case RulesCompiledLine::Type::Dynamic:
+      {
+        // Keyword only known after parsing, so use the generic parsing.
+        String action = prepareCompiledLine(line, event, 0);
+
+        if (line.startsWithPercentEvent()) {
+          action = concat(F("restrict,"), action);
+
+          if (loglevelActiveFor(LOG_LEVEL_ERROR)) {
+            addLog(LOG_LEVEL_ERROR,
+                   concat(F("Rules : Prefix command with 'restrict': "), action));
+          }
+        }
+        bool isCommand = true;
+        processMatchedRule(action, event,
+                           isCommand, condition,
+                           ifBranche, ifBlock, fakeIfBlock);
+        break;
+      }
+      case RulesCompiledLine::Type::On:
+      case RulesCompiledLine::Type::Command:
+
+        if (active) {
+          executeRulesAction(prepareCompiledLine(line, event, 0));
+        }
+        break;
+      case RulesCompiledLine::Type::EndOn:
+        break;
+    }
+    STOP_TIMER(RULES_PROCESS_MATCHED);
+
+    // Executed command may have saved a rules file, which clears the compiled lines.
+    lines = Cache.rulesHelper.getCompiledLines(fileName);
+  }
+
+  rulesNestingLevel--;
+  backgroundtasks();
+  return true;
+}
+
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
 /********************************************************************************************\
    Parse string commands
  \*********************************************************************************************/
@@ -1007,23 +1232,26 @@ void processMatchedRule(String& action, const String& event,
   // the condition matches the if or else block.
   if (isCommand) {
     substitute_eventvalue(action, event);
+    executeRulesAction(action);
+  }
+}
 
-    const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
+void executeRulesAction(const String& action) {
+  const bool executeRestricted = equals(parseString(action, 1), F("restrict"));
 
-    if (loglevelActiveFor(LOG_LEVEL_INFO)) {
-      String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
-      actionlog += action;
-      addLogMove(LOG_LEVEL_INFO, actionlog);
-    }
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    String actionlog = executeRestricted ? F("ACT  : (restricted) ") : F("ACT  : ");
+    actionlog += action;
+    addLogMove(LOG_LEVEL_INFO, actionlog);
+  }
 
-    if (executeRestricted) {
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2)});
-    } else {
-      // Use action.c_str() here as we need to preserve the action string.
-      ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
-    }
-    delay(0);
+  if (executeRestricted) {
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES_RESTRICTED, parseStringToEndKeepCase(action, 2)});
+  } else {
+    // Use action.c_str() here as we need to preserve the action string.
+    ExecuteCommand_all({EventValueSource::Enum::VALUE_SOURCE_RULES, action.c_str()});
   }
+  delay(0);
 }
 
 /********************************************************************************************\
@@ -1365,6 +1593,12 @@ void createRuleEvents(struct EventStruct *event) {
     eventString += '`';
     eventQueue.addMove(std::move(eventString));    
   } else if (Settings.CombineTaskValues_SingleEvent(event->TaskIndex)) {
+    TaskValueEvent taskValueEvent;
+
+    if (taskValueEvent.set(event, VARS_PER_TASK)) {
+      eventQueue.add(taskValueEvent);
+      return;
+    }
     String eventvalues;
     reserve_special(eventvalues, 32); // Enough for most use cases, prevent lots of memory allocations.
 
@@ -1376,8 +1610,14 @@ void createRuleEvents(struct EventStruct *event) {
     }
     eventQueue.add(event->TaskIndex, F("All"), eventvalues);
   } else {
+    TaskValueEvent taskValueEvent;
+
     for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-      eventQueue.add(event->TaskIndex, Cache.getTaskDeviceValueName(event->TaskIndex, varNr), formatUserVarNoCheck(event, varNr));
+      if (taskValueEvent.set(event, varNr)) {
+        eventQueue.add(taskValueEvent);
+      } else {
+        eventQueue.add(event->TaskIndex, Cache.getTaskDeviceValueName(event->TaskIndex, varNr), formatUserVarNoCheck(event, varNr));
+      }
     }
   }
 }
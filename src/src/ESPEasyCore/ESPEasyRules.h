@@ -7,6 +7,7 @@
 #include "../../ESPEasy_common.h"
 
 #include "../CustomBuild/ESPEasyLimits.h"
+#include "../DataStructs/TaskValueEvent.h"
 
 
 #ifdef WEBSERVER_NEW_RULES
@@ -29,6 +30,9 @@ bool   processNextEvent();
  \*********************************************************************************************/
 void   rulesProcessing(const String& event);
 
+// Only convert the event into a string when it may match a rule or must be logged.
+void   rulesProcessing(const TaskValueEvent& event);
+
 /********************************************************************************************\
    Rules processing
    Return true when event was handled.
@@ -38,6 +42,15 @@ bool rulesProcessingFile(const String& fileName,
                          size_t pos = 0,
                          bool   startOnMatched = false);
 
+/********************************************************************************************\
+   Execute matched "on ... do" block starting at line pos of the compiled rules file.
+   Only available when the rules are kept in memory.
+   Return true when event was handled.
+ \*********************************************************************************************/
+bool rulesProcessingCompiled(const String& fileName,
+                             const String& event,
+                             size_t        pos);
+
 
 
 /********************************************************************************************\
@@ -92,6 +105,9 @@ void processMatchedRule(String& action,
                         uint8_t  & ifBlock,
                         uint8_t  & fakeIfBlock);
 
+// Execute a fully parsed rules action, taking an optional "restrict" prefix into account.
+void executeRulesAction(const String& action);
+
 
 /********************************************************************************************\
    Check expression
@@ -1,6 +1,8 @@
 #include "../ESPEasyCore/ESPEasy_Log.h"
 
+#include "../DataStructs/LogSinkQueue.h"
 #include "../DataStructs/LogStruct.h"
+#include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_Console.h"
@@ -19,6 +21,11 @@
 
 #define UPDATE_LOGLEVEL_ACTIVE_CACHE_INTERVAL 5000
 
+// Max. length of multiple log lines combined into a single syslog message
+#ifndef LOG_SINK_SYSLOG_MAX_BATCH_SIZE
+#define LOG_SINK_SYSLOG_MAX_BATCH_SIZE 900
+#endif
+
 /********************************************************************************************\
   Init critical variables for logging (important during initial factory reset stuff )
   \*********************************************************************************************/
@@ -293,8 +300,8 @@ void addToSerialLog(uint8_t logLevel, const String& string)
 
 void addToSysLog(uint8_t logLevel, const String& string)
 {
-  if (loglevelActiveFor(LOG_TO_SYSLOG, logLevel)) {
-    sendSyslog(logLevel, string);
+  if (loglevelActiveFor(LOG_TO_SYSLOG, logLevel) && (Settings.Syslog_IP[0] != 0)) {
+    SyslogSinkQueue.add(logLevel, string);
   }
 }
 
@@ -302,20 +309,94 @@ void addToSDLog(uint8_t logLevel, const String& string)
 {
 #if FEATURE_SD
   if (!string.isEmpty() && loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
-    String   logName = patch_fname(F("log.txt"));
-    fs::File logFile = SD.open(logName, "a+");
-    if (logFile) {
-      const size_t stringLength = string.length();
-      for (size_t i = 0; i < stringLength; ++i) {
-        logFile.print(string[i]);
+    SDLogSinkQueue.add(logLevel, string);
+  }
+#endif
+}
+
+// Send queued log lines of the same loglevel as a single syslog message.
+// Return true when a message was sent.
+bool process_syslogSink()
+{
+  if (SyslogSinkQueue.isEmpty()) {
+    return false;
+  }
+  if (Settings.Syslog_IP[0] == 0) {
+    // Syslog server has been removed from the settings
+    SyslogSinkQueue.clear();
+    return false;
+  }
+  if (!NetworkConnected()) {
+    // Keep the lines queued until the network is available
+    return false;
+  }
+  const uint8_t logLevel = SyslogSinkQueue.frontLoglevel();
+  String message;
+
+  while (!SyslogSinkQueue.isEmpty()) {
+    if (SyslogSinkQueue.frontLoglevel() != logLevel) {
+      break;
+    }
+    // Deferred log lines are formatted here
+    const String line = SyslogSinkQueue.frontMessage();
+
+    if (message.isEmpty()) {
+      message = line;
+    } else {
+      if ((message.length() + line.length() + 1) > LOG_SINK_SYSLOG_MAX_BATCH_SIZE) {
+        break;
       }
-      logFile.println();
+      message += '\n';
+      message += line;
+    }
+    SyslogSinkQueue.pop();
+  }
+  sendSyslog(logLevel, message);
+  return true;
+}
+
+// Append all queued log lines to the log file on the SD card.
+void process_SDLogSink()
+{
+#if FEATURE_SD
+  if (SDLogSinkQueue.isEmpty()) {
+    return;
+  }
+  String   logName = patch_fname(F("log.txt"));
+  fs::File logFile = SD.open(logName, "a+");
+  if (!logFile) {
+    SDLogSinkQueue.clear();
+    return;
+  }
+  while (!SDLogSinkQueue.isEmpty()) {
+    const String string = SDLogSinkQueue.frontMessage();
+    const size_t stringLength = string.length();
+    for (size_t i = 0; i < stringLength; ++i) {
+      logFile.print(string[i]);
     }
-    logFile.close();
+    logFile.println();
+    SDLogSinkQueue.pop();
   }
+  logFile.close();
 #endif
 }
 
+void process_logSinks()
+{
+  process_syslogSink();
+  process_SDLogSink();
+}
+
+void flush_logSinks()
+{
+  unsigned int maxLoops = LOG_SINK_QUEUE_MAX_LINES;
+
+  while (maxLoops > 0 && process_syslogSink()) {
+    --maxLoops;
+  }
+  process_SDLogSink();
+}
+
 
 void addLog(uint8_t logLevel, const String& string)
 {
@@ -355,10 +436,29 @@ void addToLogMove(uint8_t logLevel, String&& string)
   addToSysLog(logLevel, string);
   addToSDLog(logLevel, string);
 
-  // May clear the string, so call as last one.
   if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
-    Logging.add(logLevel, std::move(string));
+    Logging.add(logLevel, string);
   }
   // Make sure the string may no longer keep up memory
   free_string(string);
 }
+
+void addToLog(uint8_t logLevel, const DeferredLogLine& line)
+{
+  if (loglevelActiveFor(LOG_TO_SERIAL, logLevel)) {
+    addToSerialLog(logLevel, line.toString());
+  }
+
+  if (loglevelActiveFor(LOG_TO_SYSLOG, logLevel) && (Settings.Syslog_IP[0] != 0)) {
+    SyslogSinkQueue.add(logLevel, line);
+  }
+#if FEATURE_SD
+  if (loglevelActiveFor(LOG_TO_SDCARD, logLevel)) {
+    SDLogSinkQueue.add(logLevel, line);
+  }
+#endif
+
+  if (loglevelActiveFor(LOG_TO_WEBLOG, logLevel)) {
+    Logging.add(logLevel, line);
+  }
+}
@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/DeferredLogLine.h"
+
 #define LOG_LEVEL_NONE                      0
 #define LOG_LEVEL_ERROR                     1
 #define LOG_LEVEL_INFO                      2
@@ -55,6 +57,29 @@ void addLog(uint8_t logLevel, String&& string);
 
 void addLog(uint8_t logLevel, const String& string);
 void addToLogMove(uint8_t logLevel, String&& string);
+void addToLog(uint8_t logLevel, const DeferredLogLine& line);
+
+// Log a line using a printf-style format string in flash, e.g.
+//   addLogFormat(LOG_LEVEL_INFO, F("Task %d: %s"), taskIndex + 1, taskName);
+// Only the format string pointer and the arguments are stored for the web log, syslog and SD card.
+// The text is created when these destinations process the line.
+// Serial log is formatted right away, as the serial buffer holds text.
+template<typename ... Args>
+void addLogFormat(uint8_t logLevel, const __FlashStringHelper *format, const Args&... args)
+{
+  if (loglevelActiveFor(logLevel)) {
+    DeferredLogLine line(format);
+    line.addArgs(args ...);
+    addToLog(logLevel, line);
+  }
+}
+
+// Process log lines queued for syslog and SD card.
+// Called from backgroundtasks()
+void process_logSinks();
+
+// Process all queued log lines, e.g. right before a reboot.
+void flush_logSinks();
 
 
 #endif 
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../../ESPEasy-Globals.h"
 #include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
+#include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../ESPEasyCore/Serial.h"
 #include "../Globals/NetworkState.h"
 #include "../Globals/Services.h"
@@ -20,6 +21,7 @@
 #if FEATURE_ARDUINO_OTA
 #include "../Helpers/OTA.h"
 #endif
+#include "../WebServer/EventStream.h"
 
 
 
@@ -74,6 +76,10 @@ void backgroundtasks()
    */
 
   process_serialWriteBuffer();
+  process_logSinks();
+  #ifdef WEBSERVER_EVENTS
+  process_event_stream_clients();
+  #endif // ifdef WEBSERVER_EVENTS
 
   if (!UseRTOSMultitasking) {
     serial();
@@ -10,6 +10,7 @@
 #include "../ESPEasyCore/ESPEasy_Log.h"
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/EventQueue.h"
+#include "../Globals/Plugins.h"
 #include "../Globals/RTC.h"
 #include "../Globals/Settings.h"
 #include "../Globals/Statistics.h"
@@ -168,6 +169,10 @@ void ESPEasy_loop()
     }
   }
 
+  // Tasks with a deferred PLUGIN_INIT are initialized one per loop,
+  // unless the scheduler already did so when their first read was due.
+  processPendingTaskInit();
+
   // Calls above may have received/generated commands for the command queue, thus need to process them.
   processExecuteCommandQueue();
   backgroundtasks();
@@ -6,6 +6,7 @@
 #include "../../_Plugin_Helper.h"
 #include "../Commands/InternalCommands_decoder.h"
 #include "../CustomBuild/CompiletimeDefines.h"
+#include "../DataStructs/BootTimeline.h"
 #include "../ESPEasyCore/ESPEasyGPIO.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyRules.h"
@@ -261,6 +262,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("initLog()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Core init");
   #ifdef BOARD_HAS_PSRAM
 
   if (FoundPSRAM()) {
@@ -346,11 +348,13 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("RTC init"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("RTC init");
 
   fileSystemCheck();
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("fileSystemCheck()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("File system check");
 
   //  progMemMD5check();
   LoadSettings();
@@ -361,6 +365,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("LoadSettings()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Load settings");
 
 #ifdef ESP32
 #ifndef CORE32SOLO1
@@ -389,6 +394,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("hardwareInit()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Hardware init");
 
   node_time.restoreFromRTC();
 
@@ -480,6 +486,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("WifiScan()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("WiFi scan");
 
 
   //  setWifiMode(WIFI_STA);
@@ -487,6 +494,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("checkRuleSets()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Check rule sets");
 
 
   // if different version, eeprom settings structure has changed. Full Reset needed
@@ -507,6 +515,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("initSerial()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Init serial");
 
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
     addLogMove(LOG_LEVEL_INFO, concat(F("INIT : Free RAM:"), FreeMem()));
@@ -525,11 +534,13 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("CPluginInit()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Controller init");
   #if FEATURE_NOTIFIER
   NPluginInit();
   # ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("NPluginInit()"));
   # endif
+  MARK_BOOT_PHASE("Notification init");
   #endif // if FEATURE_NOTIFIER
 
   PluginInit();
@@ -539,6 +550,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("PluginInit()"));
   #endif
+  MARK_BOOT_PHASE("Task init");
 
   if (loglevelActiveFor(LOG_LEVEL_INFO)) {
     String log;
@@ -562,6 +574,7 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("clearAllCaches()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Clear caches");
 
   if (Settings.UseRules && isDeepSleepEnabled())
   {
@@ -611,16 +624,19 @@ void ESPEasy_setup()
   }
 
   #endif // if FEATURE_ETHERNET
+  MARK_BOOT_PHASE("Rules wake events");
 
   NetworkConnectRelaxed();
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("NetworkConnectRelaxed()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Network connect");
 
   setWebserverRunning(true);
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("setWebserverRunning()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Start webserver");
 
 
   #if FEATURE_REPORTING
@@ -649,11 +665,13 @@ void ESPEasy_setup()
     logMemUsageAfter(F("rulesProcessing(System#Boot)"));
     #endif // ifndef BUILD_NO_RAM_TRACKER
   }
+  MARK_BOOT_PHASE("Rules boot event");
 
   writeDefaultCSS();
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("writeDefaultCSS()"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Write default CSS");
 
 
   #ifdef USE_RTOS_MULTITASKING
@@ -689,4 +707,5 @@ void ESPEasy_setup()
   #ifndef BUILD_NO_RAM_TRACKER
   logMemUsageAfter(F("Scheduler.setIntervalTimerOverride"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
+  MARK_BOOT_PHASE("Start scheduler");
 }
@@ -4,9 +4,13 @@
 
 
 # include "../ControllerQueue/C016_queue_element.h"
+# include "../DataStructs/FlatMap.h"
+# include "../Helpers/ESPEasy_Storage.h"
 
 ControllerCache_struct ControllerCache;
 
+FlatMap<int, ControllerCache_FileIndex> C016_cacheFileIndices;
+
 void C016_flush() {
   ControllerCache.flush();
 }
@@ -31,6 +35,58 @@ bool C016_getTaskSample(C016_binary_element& element) {
   return ControllerCache.peek((uint8_t *)&element, sizeof(element));
 }
 
+bool C016_getCacheFileIndex(fs::File& file, int fileNr, bool islast, ControllerCache_FileIndex& index) {
+  auto it = C016_cacheFileIndices.find(fileNr);
+
+  if (it != C016_cacheFileIndices.end()) {
+    if (it->second.isValidFor(file)) {
+      index = it->second;
+      return true;
+    }
+
+    // File nr. has been used for a new file
+    C016_cacheFileIndices.erase(it);
+  }
+
+  if (!index.build(file)) {
+    return false;
+  }
+  index.complete = !islast;
+
+  if (index.complete) {
+    C016_cacheFileIndices.emplace(std::make_pair(fileNr, index));
+  }
+  return true;
+}
+
+bool C016_seekCacheSample(int& fileNr, uint32_t from, uint32_t to, taskIndex_t taskIndex, ControllerCache_FileIndex& index) {
+  bool islast = false;
+
+  while (!islast) {
+    const String fname = C016_getCacheFileName(fileNr, islast);
+
+    // Forget about files which have been deleted.
+    while (!C016_cacheFileIndices.empty() && (C016_cacheFileIndices.begin()->first < fileNr)) {
+      C016_cacheFileIndices.erase(C016_cacheFileIndices.begin());
+    }
+
+    if (!fname.isEmpty()) {
+      fs::File file = tryOpenFile(fname, F("r"));
+
+      if (file &&
+          C016_getCacheFileIndex(file, fileNr, islast, index) &&
+          index.mayContain(from, to, taskIndex)) {
+        const uint32_t offset = index.findOffset(file, from);
+        file.close();
+        ControllerCache.setPeekFilePos(fileNr, offset);
+        return true;
+      }
+    }
+    ++fileNr;
+  }
+  return false;
+}
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
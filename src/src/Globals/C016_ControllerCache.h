@@ -6,6 +6,7 @@
 #ifdef USES_C016
 
 # include "../DataStructs/ESPEasyControllerCache.h"
+# include "../DataStructs/ESPEasyControllerCache_FileIndex.h"
 # include "../DataStructs/ESPEasy_EventStruct.h"
 # include "../DataStructs/DeviceStruct.h"
 # include "../ControllerQueue/C016_queue_element.h"
@@ -28,6 +29,23 @@ bool   C016_deleteAllCacheBlocks();
 
 bool   C016_getTaskSample(C016_binary_element& element);
 
+// Get the index of a cache file.
+// The index of files no longer written to is kept, so these files only need to be read once.
+bool   C016_getCacheFileIndex(fs::File                 & file,
+                              int                        fileNr,
+                              bool                       islast,
+                              ControllerCache_FileIndex& index);
+
+// Set the peek position to the first sample which may match the time range and task,
+// starting at file fileNr.
+// Files which do not contain any matching sample are skipped.
+// Return false if there is no such file left.
+bool   C016_seekCacheSample(int                      & fileNr,
+                            uint32_t                   from,
+                            uint32_t                   to,
+                            taskIndex_t                taskIndex,
+                            ControllerCache_FileIndex& index);
+
 struct EventStruct C016_getTaskSample(
   unsigned long& timestamp,
   uint8_t      & valueCount,
@@ -1,10 +1,16 @@
 #include "../Globals/Logging.h"
 
+#include "../DataStructs/LogSinkQueue.h"
 #include "../DataStructs/LogStruct.h"
 
 
 LogStruct Logging;
 
+LogSinkQueue SyslogSinkQueue;
+#if FEATURE_SD
+LogSinkQueue SDLogSinkQueue;
+#endif
+
 uint8_t highest_active_log_level = 0;
 bool log_to_serial_disabled = false;
 
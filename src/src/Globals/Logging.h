@@ -1,6 +1,8 @@
 #ifndef GLOBALS_LOGGING_H
 #define GLOBALS_LOGGING_H
 
+#include "../../ESPEasy_common.h"
+
 #include <stdint.h>
 #include <deque>
 
@@ -10,5 +12,11 @@ extern bool log_to_serial_disabled;
 struct LogStruct;
 extern LogStruct Logging;
 
+class LogSinkQueue;
+extern LogSinkQueue SyslogSinkQueue;
+#if FEATURE_SD
+extern LogSinkQueue SDLogSinkQueue;
+#endif
+
 
 #endif // GLOBALS_LOGGING_H
\ No newline at end of file
@@ -28,6 +28,11 @@ bool MQTTclient_must_send_LWT_connected = false;
 bool MQTTclient_connected               = false;
 int  mqtt_reconnect_count               = 0;
 LongTermTimer MQTTclient_next_connect_attempt;
+
+bool mqtt_batchJSON = false;
+
+uint32_t mqtt_bytes_published        = 0;
+uint32_t mqtt_batched_messages_saved = 0;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
@@ -32,6 +32,13 @@ extern bool MQTTclient_must_send_LWT_connected;
 extern bool MQTTclient_connected;
 extern int  mqtt_reconnect_count;
 extern LongTermTimer MQTTclient_next_connect_attempt;
+
+// Publish all values of a task as a single JSON message
+extern bool mqtt_batchJSON;
+
+// Statistics on published messages
+extern uint32_t mqtt_bytes_published;
+extern uint32_t mqtt_batched_messages_saved;
 #endif // if FEATURE_MQTT
 
 #ifdef USES_P037
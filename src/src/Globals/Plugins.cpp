@@ -4,6 +4,7 @@
 
 #include "../../_Plugin_Helper.h"
 
+#include "../DataStructs/BootTimeline.h"
 #include "../DataStructs/ESPEasy_EventStruct.h"
 #include "../DataStructs/TimingStats.h"
 
@@ -35,6 +36,7 @@
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringParser.h"
 
+#include <bitset>
 #include <vector>
 
 
@@ -55,6 +57,29 @@ bool validPluginID_fullcheck(pluginID_t pluginID) {
   return getDeviceIndex_from_PluginID(pluginID) != INVALID_DEVICE_INDEX;
 }
 
+// Tasks with their PLUGIN_INIT deferred during boot
+static std::bitset<TASKS_MAX> pendingTaskInit;
+static bool taskInitInProgress = false;
+
+// Only periodically read tasks with a local data feed may be initialized after boot.
+// Event driven tasks (e.g. switches) must be ready when setup() is finished.
+static bool mayDeferTaskInit(taskIndex_t taskIndex) {
+  if (!Settings.TaskDeviceEnabled[taskIndex] ||
+      (Settings.TaskDeviceDataFeed[taskIndex] != 0) ||
+      (Settings.TaskDeviceTimer[taskIndex] == 0)) {
+    return false;
+  }
+  #if FEATURE_PLUGIN_PRIORITY
+
+  if (Settings.isPriorityTask(taskIndex)) {
+    return false;
+  }
+  #endif // if FEATURE_PLUGIN_PRIORITY
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(taskIndex);
+
+  return validDeviceIndex(DeviceIndex) && Device[DeviceIndex].TimerOption;
+}
+
 /*
    bool validUserVarIndex(userVarIndex_t index) {
    return index < USERVAR_MAX_INDEX;
@@ -310,6 +335,12 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
   HeapSelectDram ephemeral;
   #endif // ifdef USE_SECOND_HEAP
 
+  if (isTaskInitPending(taskIndex) && (Function != PLUGIN_INIT)) {
+    // Task is not initialized yet.
+    // Only a command targeted at this task will trigger its deferred PLUGIN_INIT.
+    return false;
+  }
+
   bool retval                    = false;
   const bool considerTaskEnabled = Settings.TaskDeviceEnabled[taskIndex];
 
@@ -322,6 +353,7 @@ bool PluginCallForTask(taskIndex_t taskIndex, uint8_t Function, EventStruct *Tem
 
       if (validDeviceIndex(DeviceIndex)) {
         if (Function == PLUGIN_INIT) {
+          pendingTaskInit.reset(taskIndex);
           UserVar.clear_computed(taskIndex);
           LoadTaskSettings(taskIndex);
         }
@@ -598,6 +630,11 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
 
       for (taskIndex_t task = firstTask; task < lastTask; task++)
       {
+        if (1 == (lastTask - firstTask)) {
+          // Command is explicitly targeted at this task via [<TaskName>]. prefix
+          initPendingTask(task);
+        }
+
         bool retval = PluginCallForTask(task, Function, &TempEvent, command);
 
         if (!retval) {
@@ -664,6 +701,8 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
     case PLUGIN_CLOCK_IN:
     case PLUGIN_TIME_CHANGE:
     {
+      const bool lazyInit = (Function == PLUGIN_INIT_ALL) && Settings.LazyTaskInit();
+
       if (Function == PLUGIN_INIT_ALL) {
         Function = PLUGIN_INIT;
       }
@@ -671,6 +710,13 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
 
       for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; taskIndex++)
       {
+        if (lazyInit && mayDeferTaskInit(taskIndex)) {
+          // Schedule the first read like PLUGIN_INIT would do.
+          // The task will be initialized before this read.
+          pendingTaskInit.set(taskIndex);
+          Scheduler.schedule_task_device_timer_at_init(taskIndex);
+          continue;
+        }
         #ifndef BUILD_NO_DEBUG
         int freemem_begin{};
 
@@ -678,10 +724,20 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
           freemem_begin = ESP.getFreeHeap();
         }
         #endif // ifndef BUILD_NO_DEBUG
+        #if FEATURE_TIMING_STATS
+        const bool     recordInit = (Function == PLUGIN_INIT) && Settings.TaskDeviceEnabled[taskIndex];
+        const uint64_t initStart  = recordInit ? getMicros64() : 0;
+        #endif // if FEATURE_TIMING_STATS
 
         bool retval = PluginCallForTask(taskIndex, Function, &TempEvent, str, event);
 
         if (Function == PLUGIN_INIT) {
+          #if FEATURE_TIMING_STATS
+
+          if (recordInit) {
+            bootTimeline.setTaskInit(taskIndex, usecPassedSince(initStart), false);
+          }
+          #endif // if FEATURE_TIMING_STATS
           UserVar.clear_computed(taskIndex);
 
           if (!retval && (Settings.TaskDeviceDataFeed[taskIndex] == 0)) {
@@ -778,6 +834,18 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
         return false;
       }
 
+      if (isTaskInitPending(event->TaskIndex)) {
+        if ((Function == PLUGIN_INIT) || (Function == PLUGIN_EXIT)) {
+          // No longer wait for the deferred PLUGIN_INIT
+          pendingTaskInit.reset(event->TaskIndex);
+        } else if ((Function == PLUGIN_READ) ||
+                   (Function == PLUGIN_GET_PACKED_RAW_DATA) ||
+                   (Function == PLUGIN_TASKTIMER_IN) ||
+                   (Function == PLUGIN_PROCESS_CONTROLLER_DATA)) {
+          initPendingTask(event->TaskIndex);
+        }
+      }
+
       if ((Function == PLUGIN_READ) || (Function == PLUGIN_INIT) || (Function == PLUGIN_PROCESS_CONTROLLER_DATA)) {
         if (!Settings.TaskDeviceEnabled[event->TaskIndex]) {
           return false;
@@ -1094,3 +1162,52 @@ bool PluginCall(uint8_t Function, struct EventStruct *event, String& str)
   } // case
   return false;
 }
+
+bool isTaskInitPending(taskIndex_t taskIndex) {
+  return validTaskIndex(taskIndex) && pendingTaskInit.test(taskIndex);
+}
+
+void initPendingTask(taskIndex_t taskIndex) {
+  if (!isTaskInitPending(taskIndex)) {
+    return;
+  }
+
+  // Clear first, as PLUGIN_INIT itself may call the task
+  pendingTaskInit.reset(taskIndex);
+
+  const bool nested = taskInitInProgress;
+  taskInitInProgress = true;
+  #if FEATURE_TIMING_STATS
+  const uint64_t initStart = getMicros64();
+  #endif // if FEATURE_TIMING_STATS
+
+  struct EventStruct TempEvent(taskIndex);
+  String dummy;
+  PluginCall(PLUGIN_INIT, &TempEvent, dummy);
+
+  #if FEATURE_TIMING_STATS
+  bootTimeline.setTaskInit(taskIndex, usecPassedSince(initStart), true);
+  #endif // if FEATURE_TIMING_STATS
+  taskInitInProgress = nested;
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLog(LOG_LEVEL_INFO, strformat(F("INIT : Lazy init task %d, [%s]"),
+                                     taskIndex + 1,
+                                     getTaskDeviceName(taskIndex).c_str()));
+  }
+}
+
+bool processPendingTaskInit() {
+  // Do not start a task init from within another one
+  if (pendingTaskInit.none() || taskInitInProgress) {
+    return false;
+  }
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    if (pendingTaskInit.test(taskIndex)) {
+      initPendingTask(taskIndex);
+      return true;
+    }
+  }
+  return false;
+}
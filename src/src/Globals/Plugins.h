@@ -109,6 +109,21 @@ void loadDefaultTaskValueNames_ifEmpty(taskIndex_t TaskIndex);
 \*********************************************************************************************/
 bool PluginCall(uint8_t Function, struct EventStruct *event, String& str);
 
+/*********************************************************************************************\
+* Lazy task init
+* With Settings.LazyTaskInit() enabled, PLUGIN_INIT of periodically read tasks is deferred
+* during boot. These tasks are initialized one at a time from the main loop,
+* or when they are needed before that (e.g. their first PLUGIN_READ is due).
+\*********************************************************************************************/
+bool isTaskInitPending(taskIndex_t taskIndex);
+
+// Call the deferred PLUGIN_INIT of the task now.
+void initPendingTask(taskIndex_t taskIndex);
+
+// Initialize at most one pending task.
+// Return true when a task was initialized.
+bool processPendingTaskInit();
+
 
 
 #endif // GLOBALS_PLUGIN_H
\ No newline at end of file
@@ -57,6 +57,19 @@ CalculateReturnCode Calculate_preProcessed(const String& preprocessd_input,
   return returnCode;
 }
 
+CalculateReturnCode Calculate_compiled(const RulesCalculate_program& program,
+                                       const ESPEASY_RULES_FLOAT_TYPE slots[],
+                                       ESPEASY_RULES_FLOAT_TYPE     & result)
+{
+  START_TIMER;
+  CalculateReturnCode returnCode = RulesCalculate.execute(
+    program,
+    slots,
+    &result);
+
+  STOP_TIMER(COMPUTE_STATS);
+  return returnCode;
+}
 
 CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result)
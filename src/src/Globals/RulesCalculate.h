@@ -22,6 +22,11 @@ int                 CalculateParam(const String& TmpStr, int errorValue = 0);
 CalculateReturnCode Calculate_preProcessed(const String& preprocessd_input,
                               ESPEASY_RULES_FLOAT_TYPE      & result);
 
+// Execute a program compiled by RulesCalculate.compile()
+CalculateReturnCode Calculate_compiled(const RulesCalculate_program& program,
+                                       const ESPEASY_RULES_FLOAT_TYPE slots[],
+                                       ESPEASY_RULES_FLOAT_TYPE     & result);
+
 CalculateReturnCode Calculate(const String& input,
                               ESPEASY_RULES_FLOAT_TYPE      & result);
 
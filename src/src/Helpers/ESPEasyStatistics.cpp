@@ -3,9 +3,13 @@
 
 #if FEATURE_TIMING_STATS
 
+#include "../DataStructs/BootTimeline.h"
 #include "../DataStructs/TimingStats.h"
 #include "../WebServer/ESPEasy_WebServer.h"
+#include "../WebServer/JSON.h"
+#include "../Globals/Plugins.h"
 #include "../Helpers/Convert.h"
+#include "../Helpers/Misc.h"
 #include "../Helpers/_Plugin_init.h"
 
 
@@ -19,6 +23,9 @@ void stream_json_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   json_number(F("min"),   ull2String(minVal));
   json_number(F("max"),   ull2String(maxVal));
   json_number(F("avg"),   toString(stats.getAvg(), 2));
+  json_number(F("p50"),   ull2String(stats.getPercentile(0.50f)));
+  json_number(F("p95"),   ull2String(stats.getPercentile(0.95f)));
+  json_number(F("p99"),   ull2String(stats.getPercentile(0.99f)));
   json_prop(F("unit"), F("usec"));
 }
 
@@ -131,6 +138,32 @@ void jsonStatistics(bool clearStats) {
 
   json_close(true);   // Close misc list
 
+  json_open(true, F("boot_phase"));
+  for (uint8_t i = 0; i < bootTimeline.getNrPhases(); ++i) {
+    const BootTimeline::Phase& phase = bootTimeline.getPhase(i);
+    json_open();
+    json_prop(F("name"), String(phase._name));
+    json_number(F("duration"), String(phase._duration_usec));
+    json_number(F("finished"), String(phase._end_msec));
+    json_close();
+  }
+  json_close(true);   // Close boot phase list
+
+  json_open(true, F("task_init"));
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    const BootTimeline::TaskInit& taskInit = bootTimeline.getTaskInit(taskIndex);
+    if (taskInit._set) {
+      json_open();
+      json_number(F("task"), String(taskIndex + 1));
+      json_prop(F("name"), getTaskDeviceName(taskIndex));
+      json_number(F("duration"), String(taskInit._duration_usec));
+      json_number(F("deferred"), jsonBool(taskInit._deferred));
+      json_number(F("finished"), String(taskInit._end_msec));
+      json_close();
+    }
+  }
+  json_close(true);   // Close task init list
+
   if (clearStats) {
     pluginStats.clear();
     controllerStats.clear();
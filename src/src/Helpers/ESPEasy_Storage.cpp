@@ -62,6 +62,12 @@
 # include <esp_partition.h>
 #endif // ifdef ESP32
 
+// Max. number of bytes written to a file at once.
+// Also used to align writes to the file system pages.
+#ifndef FILE_WRITE_CHUNK_SIZE
+# define FILE_WRITE_CHUNK_SIZE 64
+#endif // ifndef FILE_WRITE_CHUNK_SIZE
+
 #ifdef ESP32
 String patch_fname(const String& fname) {
   if (fname.startsWith(F("/"))) {
@@ -161,10 +167,7 @@ bool fileExists(const String& fname) {
   if (res || !isCacheFile(patched_fname))
   #endif // if FEATURE_RTC_CACHE_STORAGE
   {
-    Cache.fileExistsMap.emplace(
-      std::make_pair(
-        patched_fname,
-        res));
+    Cache.fileExistsMap.emplace(patched_fname, res);
   }
 
   if (Cache.fileCacheClearMoment == 0) {
@@ -186,6 +189,15 @@ fs::File tryOpenFile(const String& fname, const String& mode, FileDestination_e
     return f;
   }
 
+  #ifndef LIMIT_BUILD_SIZE
+
+  if (!equals(mode, 'r') && !mode.equals(F("r+"))) {
+    // File may be truncated or appended to.
+    // Writes using "r+" update the cached pages themselves.
+    Cache.settingsFilePages.invalidate(fname);
+  }
+  #endif // ifndef LIMIT_BUILD_SIZE
+
   bool exists = fileExists(fname);
 
   if (!exists) {
@@ -218,6 +230,10 @@ bool fileMatchesTaskSettingsType(const String& fname) {
 
 bool tryRenameFile(const String& fname_old, const String& fname_new, FileDestination_e destination) {
   clearFileCaches();
+  #ifndef LIMIT_BUILD_SIZE
+  Cache.settingsFilePages.invalidate(fname_old);
+  Cache.settingsFilePages.invalidate(fname_new);
+  #endif // ifndef LIMIT_BUILD_SIZE
 
   if (fileExists(fname_old) && !fileExists(fname_new)) {
     if (fileMatchesTaskSettingsType(fname_old)) {
@@ -256,6 +272,9 @@ bool tryDeleteFile(const String& fname, FileDestination_e destination) {
     } else {
       clearAllButTaskCaches();
     }
+    #ifndef LIMIT_BUILD_SIZE
+    Cache.settingsFilePages.invalidate(fname);
+    #endif // ifndef LIMIT_BUILD_SIZE
     bool res = false;
 
     if ((destination == FileDestination_e::ANY) || (destination == FileDestination_e::FLASH)) {
@@ -544,6 +563,9 @@ void fileSystemCheck()
 }
 
 bool FS_format() {
+  #ifndef LIMIT_BUILD_SIZE
+  Cache.settingsFilePages.clear();
+  #endif // ifndef LIMIT_BUILD_SIZE
    #ifdef USE_LITTLEFS
      # ifdef ESP32
   const bool res = ESPEASY_FS.begin(true);
@@ -1779,20 +1801,29 @@ String doSaveToFile(const char *fname, int index, const uint8_t *memAddress, int
 
   if (f) {
     clearAllButTaskCaches();
+    #ifndef LIMIT_BUILD_SIZE
+
+    // Invalidate before the first write, as SPIFFS_CHECK may return halfway.
+    Cache.settingsFilePages.invalidate(fname);
+    #endif // ifndef LIMIT_BUILD_SIZE
     SPIFFS_CHECK(f,                          fname);
     if (index > 0) {
       SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
     }
-    const uint8_t *pointerToByteToSave = memAddress;
+    int pos = index;
 
-    for (int x = 0; x < datasize; x++)
+    while (pos < (index + datasize))
     {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t byteToSave = *pointerToByteToSave;
-      SPIFFS_CHECK(f.write(&byteToSave, 1), fname);
-      pointerToByteToSave++;
-
-      if (x % 256 == 0) {
+      // Write in chunks aligned to the file system pages.
+      // Copy to a local buffer first,
+      // see https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
+      uint8_t buffer[FILE_WRITE_CHUNK_SIZE];
+      const int chunkSize = _min(FILE_WRITE_CHUNK_SIZE - (pos % FILE_WRITE_CHUNK_SIZE), index + datasize - pos);
+      memcpy(buffer, memAddress + (pos - index), chunkSize);
+      SPIFFS_CHECK(f.write(buffer, chunkSize) == static_cast<size_t>(chunkSize), fname);
+      pos += chunkSize;
+
+      if (pos % 256 == 0) {
         // one page written, do some background tasks
         timer = millis() + 50;
         delay(0);
@@ -1856,13 +1887,19 @@ String ClearInFile(const char *fname, int index, int datasize)
   fs::File f = tryOpenFile(fname, "r+");
 
   if (f) {
+    #ifndef LIMIT_BUILD_SIZE
+    Cache.settingsFilePages.invalidate(fname);
+    #endif // ifndef LIMIT_BUILD_SIZE
     SPIFFS_CHECK(f.seek(index, fs::SeekSet), fname);
 
-    for (int x = 0; x < datasize; x++)
+    const uint8_t zero_values[FILE_WRITE_CHUNK_SIZE]{};
+    int pos = index;
+
+    while (pos < (index + datasize))
     {
-      // See https://github.com/esp8266/Arduino/commit/b1da9eda467cc935307d553692fdde2e670db258#r32622483
-      uint8_t zero_value = 0;
-      SPIFFS_CHECK(f.write(&zero_value, 1), fname);
+      const int chunkSize = _min(FILE_WRITE_CHUNK_SIZE - (pos % FILE_WRITE_CHUNK_SIZE), index + datasize - pos);
+      SPIFFS_CHECK(f.write(zero_values, chunkSize) == static_cast<size_t>(chunkSize), fname);
+      pos += chunkSize;
     }
     f.close();
   } else {
@@ -1899,6 +1936,14 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
   checkRAM(F("LoadFromFile"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
 
+  #ifndef LIMIT_BUILD_SIZE
+
+  if (Cache.settingsFilePages.read(fname, offset, memAddress, datasize)) {
+    STOP_TIMER(LOADFILE_STATS);
+    return EMPTY_STRING;
+  }
+  #endif // ifndef LIMIT_BUILD_SIZE
+
   fs::File f = tryOpenFile(fname, "r");
   SPIFFS_CHECK(f, fname);
   const int fileSize = f.size();
@@ -1907,7 +1952,7 @@ String LoadFromFile(const char *fname, int offset, uint8_t *memAddress, int data
     SPIFFS_CHECK(f.seek(offset, fs::SeekSet), fname);
 
     if (fileSize < (offset + datasize)) {
-      const int newdatasize = datasize + offset - fileSize;
+      const int newdatasize = fileSize - offset;
 
       // File is smaller, make sure to set excess memory to 0.
       memset(memAddress + newdatasize, 0u, (datasize - newdatasize));
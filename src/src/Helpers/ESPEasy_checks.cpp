@@ -34,6 +34,7 @@
 #include <cstddef>
 
 #ifdef USES_C013
+#include "../DataStructs/C013_p2p_SensorDataBatchStruct.h"
 #include "../DataStructs/C013_p2p_SensorDataStruct.h"
 #include "../DataStructs/C013_p2p_SensorInfoStruct.h"
 #endif
@@ -99,17 +100,10 @@ void run_compiletime_checks() {
   #endif
 
 
-  // LogStruct is mainly dependent on the number of lines.
-  // Has to be round up to multiple of 4.
-  #if ESP_IDF_VERSION_MAJOR > 3
-  // String class has increased with 4 bytes
-  const unsigned int LogStructSize = ((13u + 24 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #else
-  const unsigned int LogStructSize = ((13u + 20 * LOG_STRUCT_MESSAGE_LINES) + 3) & ~3;
-  #endif
-  check_size<LogStruct,                             LogStructSize>(); // Is not stored
+  // Log lines are kept in a separately allocated buffer of LOG_STRUCT_BUFFER_SIZE bytes
+  check_size<LogStruct,                             20u>(); // Is not stored
   check_size<DeviceStruct,                          10u>(); // Is not stored
-  #if FEATURE_MQTT_TLS
+  #if FEATURE_MQTT_TLS || FEATURE_MQTT
   check_size<ProtocolStruct,                        6u>();
   #else
   check_size<ProtocolStruct,                        4u>();
@@ -131,6 +125,7 @@ void run_compiletime_checks() {
   #ifdef USES_C013
   check_size<C013_SensorInfoStruct,                 233u>();
   check_size<C013_SensorDataStruct,                 40u>(); 
+  check_size<C013_SensorDataBatchStruct,            6u>();
   #endif
   #ifdef USES_C016
   check_size<C016_binary_element,                   24u>();
@@ -321,6 +321,8 @@ void processMQTTdelayQueue() {
   } else
   if (!handled) {
     if (MQTTclient.publish(element->_topic.c_str(), element->_payload.c_str(), element->_retained)) {
+      mqtt_bytes_published += element->_topic.length() + element->_payload.length();
+
       if (WiFiEventData.connectionFailures > 0) {
         --WiFiEventData.connectionFailures;
       }
@@ -415,7 +417,7 @@ void logTimerStatistics() {
 #ifndef BUILD_NO_DEBUG
 //  logStatistics(loglevel, true);
   if (loglevelActiveFor(loglevel)) {
-    String queueLog = F("Scheduler stats: (called/tasks/max_length/idle%) ");
+    String queueLog = F("Scheduler stats: (called/tasks/max_length/cur_length/capacity/idle%) ");
     queueLog += Scheduler.getQueueStats();
     addLogMove(loglevel, queueLog);
   }
@@ -488,6 +490,7 @@ void prepareShutdown(IntendedRebootReason_e reason)
   runPeriodicalMQTT(); // Flush outstanding MQTT messages
 #endif // if FEATURE_MQTT
   process_serialWriteBuffer();
+  flush_logSinks();
   flushAndDisconnectAllClients();
   saveUserVarToRTC();
   setWifiMode(WIFI_OFF);
@@ -139,6 +139,14 @@ bool RulesHelperClass::findMatchingRule(const String& event, String& filename, s
   return true;
 }
 
+bool RulesHelperClass::mayMatchEvent(const String& eventName)
+{
+  if (!_eventCache.isInitialized()) {
+    init();
+  }
+  return _eventCache.mayMatch(eventName);
+}
+
 void RulesHelperClass::init()
 {
   if (_eventCache.isInitialized()) { return; }
@@ -274,12 +282,8 @@ bool RulesHelperClass::addChar(char c, String& line,   bool& firstNonSpaceRead)
 }
 
 #ifdef CACHE_RULES_IN_MEMORY
-String RulesHelperClass::readLn(const String& filename,
-                                size_t      & pos,
-                                bool        & moreAvailable,
-                                bool          searchNextOnBlock)
+const RulesHelperClass::RulesLines * RulesHelperClass::getCompiledLines(const String& filename)
 {
-  moreAvailable = false;
   auto it = _fileHandleMap.find(filename);
 
   if (it == _fileHandleMap.end()) {
@@ -291,13 +295,9 @@ String RulesHelperClass::readLn(const String& filename,
       String     tmpStr;
       bool firstNonSpaceRead = false;
 
-      // Keep track of which line we're reading for the event cache.
-      size_t readPos = 0;
-
       while (f.available()) {
         if (addChar(char(f.read()), tmpStr, firstNonSpaceRead)) {
-          lines.push_back(tmpStr);
-          ++readPos;
+          lines.emplace_back(std::move(tmpStr));
 
           firstNonSpaceRead = false;
           tmpStr.clear();
@@ -307,16 +307,16 @@ String RulesHelperClass::readLn(const String& filename,
       if (tmpStr.length() > 0) {
         rules_strip_trailing_comments(tmpStr);
         check_rules_line_user_errors(tmpStr);
-        lines.push_back(tmpStr);
+        lines.emplace_back(std::move(tmpStr));
         tmpStr.clear();
       }
 # ifndef BUILD_NO_DEBUG
 
       if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
-        addLogMove(LOG_LEVEL_DEBUG, strformat(
+        addLogFormat(LOG_LEVEL_DEBUG,
                      F("Rules : Read %u  lines from %s"),
                      lines.size(),
-                     filename.c_str()));
+                     filename);
       }
 # endif // ifndef BUILD_NO_DEBUG
       _fileHandleMap.emplace(std::make_pair(filename, std::move(lines)));
@@ -324,14 +324,30 @@ String RulesHelperClass::readLn(const String& filename,
     }
   }
 
-  if (it != _fileHandleMap.end()) {
-    while (pos < it->second.size()) {
+  if (it == _fileHandleMap.end()) {
+    return nullptr;
+  }
+  return &(it->second);
+}
+
+String RulesHelperClass::readLn(const String& filename,
+                                size_t      & pos,
+                                bool        & moreAvailable,
+                                bool          searchNextOnBlock)
+{
+  moreAvailable = false;
+  const RulesLines *lines = getCompiledLines(filename);
+
+  if (lines != nullptr) {
+    while (pos < lines->size()) {
       ++pos;
-      moreAvailable = pos < it->second.size();
+      moreAvailable = pos < lines->size();
+
+      const RulesCompiledLine& line = (*lines)[pos - 1];
 
       if (!searchNextOnBlock ||
-          it->second[pos - 1].substring(0, 3).equalsIgnoreCase(F("on "))) {
-        return it->second[pos - 1];
+          (line._type == RulesCompiledLine::Type::On)) {
+        return line._line;
       }
     }
   }
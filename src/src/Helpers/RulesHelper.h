@@ -3,6 +3,7 @@
 
 #include "../../ESPEasy_common.h"
 
+#include "../DataStructs/RulesCompiledLine.h"
 #include "../DataStructs/RulesEventCache.h"
 
 #include <FS.h>
@@ -28,6 +29,13 @@
 class RulesHelperClass {
 public:
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+  // Cache the entire rules file contents in memory, with each line classified
+  // so a matched block can be executed without parsing the keywords again.
+  typedef std::vector<RulesCompiledLine> RulesLines;
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
   RulesHelperClass();
 
   ~RulesHelperClass();
@@ -40,6 +48,14 @@ public:
                         String      & filename,
                         size_t      & pos);
 
+  // Return false when no rule can match an event with this name.
+  bool mayMatchEvent(const String& eventName);
+
+  // Access to the event cache for statistics
+  RulesEventCache& getEventCache() {
+    return _eventCache;
+  }
+
 private:
 
 #ifndef CACHE_RULES_IN_MEMORY
@@ -61,12 +77,16 @@ public:
                 bool        & moreAvailable,
                 bool          searchNextOnBlock);
 
+#ifdef CACHE_RULES_IN_MEMORY
+
+  // Return the compiled lines of a rules file, or nullptr when the file cannot be read.
+  // N.B. the returned pointer is invalidated by closeAllFiles()
+  const RulesLines* getCompiledLines(const String& filename);
+#endif // ifdef CACHE_RULES_IN_MEMORY
+
 private:
 
 #ifdef CACHE_RULES_IN_MEMORY
-
-  // Cache the entire rules file contents in memory
-  typedef std::vector<String>         RulesLines;
   typedef std::map<String, RulesLines>FileHandleMap;
 #else // ifdef CACHE_RULES_IN_MEMORY
 
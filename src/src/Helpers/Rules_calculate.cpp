@@ -29,11 +29,28 @@ bool RulesCalculate_t::is_number(char oc, char c, char pc)
     (c == '.')   ||                                // A decimal point of a floating point number.
     ((oc == '0') && ((c == 'x') || (c == 'b'))) || // HEX (0x) or BIN (0b) prefixes.
     isxdigit(c)  ||                                // HEX digit also includes normal decimal numbers
+    is_slot(c)   ||                                // Placeholder for a bound value in a compiled program.
     ((is_operator(oc) || ('\0' == oc)) && (c == '-') 
-        && (isdigit(pc) || ('\0' == pc))) // Beginning of a negative number after an operator or 'separator' and before a digit or end-of-digit.
+        && (isdigit(pc) || is_slot(pc) || ('\0' == pc))) // Beginning of a negative number after an operator or 'separator' and before a digit or end-of-digit.
   ;
 }
 
+bool RulesCalculate_t::is_slot(char c)
+{
+  return c == RULES_CALCULATE_SLOT_VALUE || c == RULES_CALCULATE_SLOT_PVALUE;
+}
+
+void RulesCalculate_t::record(RulesCalculate_program::OpType type, char op, ESPEASY_RULES_FLOAT_TYPE value)
+{
+  if (_program != nullptr) {
+    RulesCalculate_program::Op newOp;
+    newOp.value = value;
+    newOp.type  = type;
+    newOp.op    = op;
+    _program->ops.push_back(newOp);
+  }
+}
+
 bool RulesCalculate_t::is_operator(char c)
 {
   return c == '+' || c == '-' || c == '*' || c == '/' || c == '^' || c == '%';
@@ -88,6 +105,11 @@ CalculateReturnCode RulesCalculate_t::push(ESPEASY_RULES_FLOAT_TYPE value)
     *(++sp) = value;
     return CalculateReturnCode::OK;
   }
+
+  if (_program != nullptr) {
+    // Some code paths ignore this error, so it cannot be reproduced by a compiled program.
+    _program->isCompiled = false;
+  }
   return CalculateReturnCode::ERROR_STACK_OVERFLOW;
 }
 
@@ -315,6 +337,7 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
     ret = push(apply_operator(token[0], first, second));
+    record(RulesCalculate_program::OpType::Operator, token[0]);
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate operator %c: 1: %.2f 2: %.2f"), token[0], first, second));
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
@@ -324,6 +347,7 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first = pop();
 
     ret = push(apply_unary_operator(token[0], first));
+    record(RulesCalculate_program::OpType::Unary, token[0]);
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate unary %d: 1: %.2f"), token[0], first));
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
@@ -337,8 +361,22 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     ESPEASY_RULES_FLOAT_TYPE first  = pop();
 
     ret = push(apply_quinary_operator(token[0], first, second, third, fourth, fifth));
+    record(RulesCalculate_program::OpType::Quinary, token[0]);
     // addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate quinary %d: 1: %.2f 2: %.2f 3: %.2f 4: %.2f 5: %.2f"), token[0], first, second, third, fourth, fifth));
 
+  } else if (is_slot(token[0]) || ((token[0] == '-') && is_slot(token[1]))) {
+    // Placeholder for a value bound when executing a compiled program.
+    const bool negated = token[0] == '-';
+    const char slot    = negated ? token[1] : token[0];
+
+    if ((_program != nullptr) && (negated ? token[2] : token[1]) != 0) {
+      // Placeholder mixed with other characters, e.g. "%value%0"
+      _program->isCompiled = false;
+    }
+    ret = push(0);
+    record(
+      negated ? RulesCalculate_program::OpType::SlotNegated : RulesCalculate_program::OpType::Slot,
+      slot - RULES_CALCULATE_SLOT_VALUE);
   } else {
     // Fetch next if there is any
     ESPEASY_RULES_FLOAT_TYPE value{};
@@ -349,6 +387,7 @@ CalculateReturnCode RulesCalculate_t::RPNCalculate(char *token)
     //   addLog(LOG_LEVEL_INFO, strformat(F("RPNCalculate unknown token: %s"), token));
     }
     ret = push(value); // If it is a value, push to the stack
+    record(RulesCalculate_program::OpType::Value, 0, value);
 
 // FIXME TD-er: Regardless whether it is an error, all code paths return ret;
 //    if (isError(ret)) { return ret; }
@@ -543,6 +582,7 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
             ESPEASY_RULES_FLOAT_TYPE first = pop(); // Get last value from stack
             error = push(first); // push back
             error = push(first); // Push as a result of ()
+            record(RulesCalculate_program::OpType::Duplicate);
             // addLog(LOG_LEVEL_INFO, strformat(F("doCalculate pop&push 2x last value: %.2f sl: %u"), first, sl));
           } else {
             error = RPNCalculate(token);
@@ -642,6 +682,104 @@ CalculateReturnCode RulesCalculate_t::doCalculate(const char *input, ESPEASY_RUL
   return CalculateReturnCode::OK;
 }
 
+CalculateReturnCode RulesCalculate_t::compile(const String& preprocessed_input, RulesCalculate_program& program)
+{
+  program.clear();
+  program.isCompiled = true;
+  _program           = &program;
+
+  ESPEASY_RULES_FLOAT_TYPE result{};
+  const CalculateReturnCode returnCode = doCalculate(preprocessed_input.c_str(), &result);
+
+  _program = nullptr;
+
+  if (isError(returnCode) || !program.isCompiled || (sp == (globalstack - 1))) {
+    // Only keep programs which leave a result on the stack
+    program.clear();
+  }
+  return returnCode;
+}
+
+CalculateReturnCode RulesCalculate_t::execute(const RulesCalculate_program& program,
+                                              const ESPEASY_RULES_FLOAT_TYPE slots[],
+                                              ESPEASY_RULES_FLOAT_TYPE     *result)
+{
+  if (!program.isCompiled) {
+    *result = 0;
+    return CalculateReturnCode::ERROR_UNKNOWN_TOKEN;
+  }
+  sp = globalstack - 1;
+
+  // Stack depth is the same as when compiled, so no overflow can occur.
+  for (auto it = program.ops.begin(); it != program.ops.end(); ++it) {
+    switch (it->type) {
+      case RulesCalculate_program::OpType::Value:
+        push(it->value);
+        break;
+      case RulesCalculate_program::OpType::Slot:
+        push(slots[static_cast<uint8_t>(it->op)]);
+        break;
+      case RulesCalculate_program::OpType::SlotNegated:
+        push(-1 * slots[static_cast<uint8_t>(it->op)]);
+        break;
+      case RulesCalculate_program::OpType::Operator:
+      {
+        const ESPEASY_RULES_FLOAT_TYPE second = pop();
+        const ESPEASY_RULES_FLOAT_TYPE first  = pop();
+        push(apply_operator(it->op, first, second));
+        break;
+      }
+      case RulesCalculate_program::OpType::Unary:
+        push(apply_unary_operator(it->op, pop()));
+        break;
+      case RulesCalculate_program::OpType::Quinary:
+      {
+        const ESPEASY_RULES_FLOAT_TYPE fifth  = pop();
+        const ESPEASY_RULES_FLOAT_TYPE fourth = pop();
+        const ESPEASY_RULES_FLOAT_TYPE third  = pop();
+        const ESPEASY_RULES_FLOAT_TYPE second = pop();
+        const ESPEASY_RULES_FLOAT_TYPE first  = pop();
+        push(apply_quinary_operator(it->op, first, second, third, fourth, fifth));
+        break;
+      }
+      case RulesCalculate_program::OpType::Duplicate:
+      {
+        const ESPEASY_RULES_FLOAT_TYPE first = pop();
+        push(first);
+        push(first);
+        break;
+      }
+    }
+  }
+  *result = *sp;
+  return CalculateReturnCode::OK;
+}
+
+bool RulesCalculate_t::bindSlotValue(const String& value, ESPEASY_RULES_FLOAT_TYPE& slotValue)
+{
+  const size_t length = value.length();
+
+  // Must fit in a token, including an optional '-' in front of the placeholder
+  if ((length == 0) || ((length + 1) >= (TOKEN_LENGTH - 1))) {
+    return false;
+  }
+
+  // Only plain non-negative decimals are tokenized the same as a placeholder.
+  bool hasDecimalPoint = false;
+
+  for (size_t i = 0; i < length; ++i) {
+    const char c = value[i];
+
+    if (c == '.') {
+      if (hasDecimalPoint) { return false; }
+      hasDecimalPoint = true;
+    } else if (!isdigit(c)) {
+      return false;
+    }
+  }
+  return validDoubleFromString(value, slotValue);
+}
+
 void preProcessReplace(String& input, UnaryOperator op) {
   String find = toString(op);
 
@@ -4,6 +4,8 @@
 
 #include "../../ESPEasy_common.h"
 
+#include <vector>
+
 /********************************************************************************************\
    Calculate function for simple expressions
  \*********************************************************************************************/
@@ -17,6 +19,12 @@
 #endif
 #define OPERATOR_STACK_SIZE 32
 
+// Placeholders for values bound when executing a compiled program,
+// e.g. %value% and %pvalue% in task value formulas.
+#define RULES_CALCULATE_SLOT_VALUE   '\x01'
+#define RULES_CALCULATE_SLOT_PVALUE  '\x02'
+#define RULES_CALCULATE_NR_SLOTS     2
+
 enum class CalculateReturnCode : uint8_t{
   OK                           = 0u,
   ERROR_STACK_OVERFLOW         = 1u,
@@ -63,6 +71,37 @@ void   preProcessReplace(String      & input,
 bool   angleDegree(UnaryOperator op);
 const __FlashStringHelper* toString(UnaryOperator op);
 
+/********************************************************************************************\
+   Compiled expression, as recorded while parsing the infix notation.
+   Executing it performs the exact same stack operations as doCalculate()
+   without tokenizing the input again.
+ \*********************************************************************************************/
+struct RulesCalculate_program {
+  enum class OpType : uint8_t {
+    Value,
+    Slot,
+    SlotNegated,
+    Operator,
+    Unary,
+    Quinary,
+    Duplicate
+  };
+
+  struct Op {
+    ESPEASY_RULES_FLOAT_TYPE value{};
+    OpType                   type{};
+    char                     op{}; // Operator, or slot nr.
+  };
+
+  void clear() {
+    ops.clear();
+    isCompiled = false;
+  }
+
+  std::vector<Op>ops;
+  bool isCompiled = false;
+};
+
 class RulesCalculate_t {
 private:
 
@@ -83,6 +122,12 @@ private:
 
   bool                is_quinary_operator(char c);
 
+  static bool         is_slot(char c);
+
+  void                record(RulesCalculate_program::OpType type,
+                             char                           op    = 0,
+                             ESPEASY_RULES_FLOAT_TYPE       value = 0);
+
   CalculateReturnCode push(ESPEASY_RULES_FLOAT_TYPE value);
 
   ESPEASY_RULES_FLOAT_TYPE              pop();
@@ -117,6 +162,9 @@ private:
 
   // unused: unsigned int op_arg_count(const char c);
 
+  // Program being recorded by compile()
+  RulesCalculate_program *_program = nullptr;
+
 public:
 
   RulesCalculate_t();
@@ -124,6 +172,22 @@ public:
   CalculateReturnCode doCalculate(const char *input,
                                   ESPEASY_RULES_FLOAT_TYPE     *result);
 
+  // Parse the preprocessed input once into a program, which can be executed repeatedly.
+  // The input may contain RULES_CALCULATE_SLOT_xxx placeholders for values bound on execute.
+  // program.isCompiled is only set when executing will yield the same result as doCalculate()
+  CalculateReturnCode compile(const String          & preprocessed_input,
+                              RulesCalculate_program& program);
+
+  CalculateReturnCode execute(const RulesCalculate_program& program,
+                              const ESPEASY_RULES_FLOAT_TYPE slots[],
+                              ESPEASY_RULES_FLOAT_TYPE     *result);
+
+  // Convert a value to be bound to a slot of a compiled program.
+  // Return false when the value must be substituted as text in the formula
+  // to get the same result as doCalculate(), e.g. negative values or NaN.
+  static bool         bindSlotValue(const String            & value,
+                                    ESPEASY_RULES_FLOAT_TYPE& slotValue);
+
   // Try to replace multi byte operators with single character ones.
   // For example log, sin, cos, tan.
   static String preProces(const String& input);
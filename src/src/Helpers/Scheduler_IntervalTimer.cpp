@@ -10,6 +10,7 @@
 #include "../Globals/Settings.h"
 
 #include "../Helpers/ESPEasy_time_calc.h"
+#include "../Helpers/_CPlugin_C013_helper.h"
 #include "../Helpers/Networking.h"
 #include "../Helpers/PeriodicalActions.h"
 
@@ -242,11 +243,9 @@ void ESPEasy_Scheduler::process_interval_timer(SchedulerTimerID timerID, unsigne
       break;
 
     case SchedulerIntervalTimer_e::TIMER_C013_DELAY_QUEUE:
-      /*
-       #ifdef USES_C013
-            process_c013_delay_queue();
-       #endif
-       */
+  #ifdef USES_C013
+      C013_flushSensorData();
+  #endif // ifdef USES_C013
       break;
 
     case SchedulerIntervalTimer_e::TIMER_C014_DELAY_QUEUE:
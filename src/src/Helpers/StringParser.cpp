@@ -20,6 +20,7 @@
 #include "../Helpers/Numerical.h"
 #include "../Helpers/StringConverter.h"
 #include "../Helpers/StringGenerator_GPIO.h"
+#include "../Helpers/SystemVariables.h"
 
 
 
@@ -58,18 +59,216 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize)
   return parseTemplate_padded(tmpString, minimal_lineSize, false);
 }
 
-String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool useURLencode)
+// Handle a [deviceName#valueName#format] found in a template.
+// deviceName and valueName must be lower case.
+static void parseTemplate_devValRef(
+  String      & newString,
+  uint8_t       minimal_lineSize,
+  const String& deviceName,
+  const String& valueName,
+  String      & format,
+  const String& tmpString)
 {
-  #ifndef BUILD_NO_RAM_TRACKER
-  checkRAM(F("parseTemplate_padded"));
-  #endif // ifndef BUILD_NO_RAM_TRACKER
-  START_TIMER;
+  // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
+  const bool devNameEqInt = equals(deviceName, F("int"));
+  if (devNameEqInt || equals(deviceName, F("var")))
+  {
+    // Address an internal variable either as float or as int
+    // For example: Let,10,[VAR#9]
+    uint32_t varNum;
+
+    if (validUIntFromString(valueName, varNum)) {
+      const ESPEASY_RULES_FLOAT_TYPE floatvalue = getCustomFloatVar(varNum);
+      unsigned char nr_decimals = maxNrDecimals_fpType(floatvalue);
+      bool trimTrailingZeros    = true;
+
+      if (devNameEqInt) {
+        nr_decimals = 0;
+      } else if (!format.isEmpty())
+      {
+        // There is some formatting here, so do not throw away decimals
+        trimTrailingZeros = false;
+      }
+      #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
+      String value = doubleToString(floatvalue, nr_decimals, trimTrailingZeros);
+      #else
+      String value = floatToString(floatvalue, nr_decimals, trimTrailingZeros);
+      #endif
+      transformValue(
+        newString, 
+        minimal_lineSize, 
+        std::move(value), 
+        format, 
+        tmpString);
+    }
+  }
+  else if (equals(deviceName, F("plugin")))
+  {
+    // Handle a plugin request.
+    // For example: "[Plugin#GPIO#Pinstate#N]"
+    // The command is stored in valueName & format
+    String command = strformat(F("%s#%s"), valueName.c_str(), format.c_str());
+    command.replace('#', ',');
+
+    if (getGPIOPinStateValues(command)) {
+      newString += command;
+    }
+  /* @giig1967g
+    if (PluginCall(PLUGIN_REQUEST, 0, command))
+    {
+      // Do not call transformValue here.
+      // The "format" is not empty so must not call the formatter function.
+      newString += command;
+    }
+  */
+  }
+  else
+  {
+    // Address a value from a plugin.
+    // For example: "[bme#temp]"
+    // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
+    // For example: "[<taskname>#getLevel]"
+    taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
+
+    if (validTaskIndex(taskIndex)) {
+      bool isHandled = false;
+      if (Settings.TaskDeviceEnabled[taskIndex]) {
+        uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
+
+        if (valueNr != VARS_PER_TASK) {
+          // here we know the task and value, so find the uservar
+          // Try to format and transform the values
+          bool   isvalid;
+          String value = formatUserVar(taskIndex, valueNr, isvalid);
+
+          if (isvalid) {
+            transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+            isHandled = true;
+          }
+        } else {
+          // try if this is a get config request
+          struct EventStruct TempEvent(taskIndex);
+          String tmpName = valueName;
 
-  // Keep current loaded taskSettings to restore at the end.
-  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
-  String newString;
-  newString.reserve(minimal_lineSize); // Our best guess of the new size.
+          if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
+          {
+            transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
+            isHandled = true;
+          }
+        }
+      }
+      if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
+        String value;
+        if (valueName.endsWith(F(".enabled"))) {           // Task state
+          value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
+        } else if (valueName.endsWith(F(".interval"))) {   // Task interval
+          value = Settings.TaskDeviceTimer[taskIndex];
+        } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
+          value = getValueCountForTask(taskIndex);
+        } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
+          String ctrl = valueName.substring(19, 20);
+          int32_t ctrlNr = 0;
+          if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
+              Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
+            if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
+              value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
+            } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
+              protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
+
+              if (validProtocolIndex(ProtocolIndex) && 
+                  getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
+                value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
+              }
+            }
+          }
+        }
+        if (!value.isEmpty()) {
+          transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
+          // isHandled = true;
+        }
+      }
+    }
+  }
+}
+
+#ifndef LIMIT_BUILD_SIZE
+
+// Render a template which was split into tokens earlier.
+// Return false when a system variable has a value which would be processed
+// any further by the text based parsing, newString is then left empty.
+static bool parseTemplate_parsed(
+  const ParsedTemplate& parsed,
+  String              & newString,
+  uint8_t               minimal_lineSize,
+  bool                  useURLencode)
+{
+  std::vector<String> sysvars;
+  sysvars.reserve(parsed.nrSystemVariables());
+  size_t expectedLength = parsed.literalLength();
+
+  for (const ParsedTemplate::Token& token : parsed._tokens) {
+    if (token._type == ParsedTemplate::TokenType::SystemVariable) {
+      String value = SystemVariables::getSystemVariable(token._sysvar);
+
+      if (useURLencode) {
+        value = URLEncode(value);
+      }
 
+      if ((value.indexOf('%') != -1) ||
+          (value.indexOf('[') != -1) ||
+          (value.indexOf(']') != -1) ||
+          (value.indexOf('#') != -1) ||
+          (value.indexOf('\\') != -1)) {
+        return false;
+      }
+      expectedLength += value.length();
+      sysvars.emplace_back(std::move(value));
+    } else if (token._type == ParsedTemplate::TokenType::DevValRef) {
+      // Just a guess for the length of a task value
+      expectedLength += 8;
+    }
+  }
+  newString.reserve(std::max(expectedLength, static_cast<size_t>(minimal_lineSize)));
+
+  auto sysvar_it = sysvars.begin();
+
+  for (const ParsedTemplate::Token& token : parsed._tokens) {
+    switch (token._type) {
+      case ParsedTemplate::TokenType::Literal:
+        newString += token._text;
+        break;
+      case ParsedTemplate::TokenType::SystemVariable:
+        newString += *sysvar_it;
+        ++sysvar_it;
+        break;
+      case ParsedTemplate::TokenType::DevValRef:
+      {
+        // transformValue() may alter the format.
+        String format(token._format);
+
+        // Templates with right aligned formatting are not parsed,
+        // so the string passed as tmpString is not used.
+        parseTemplate_devValRef(newString, minimal_lineSize, token._text, token._valueName, format, EMPTY_STRING);
+
+        // This may have taken some time, so call delay()
+        delay(0);
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+#endif // ifndef LIMIT_BUILD_SIZE
+
+// Text based parsing of a template.
+// N.B. tmpString will be altered.
+static void parseTemplate_text(
+  String& tmpString,
+  String& newString,
+  uint8_t minimal_lineSize,
+  bool    useURLencode)
+{
   if (parseTemplate_CallBack_ptr != nullptr) {
     parseTemplate_CallBack_ptr(tmpString, useURLencode);
   }
@@ -98,126 +297,7 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
       // First copy all upto the start of the [...#...] part to be replaced.
       newString += tmpString.substring(lastStartpos, startpos);
 
-      // deviceName is lower case, so we can compare literal string (no need for equalsIgnoreCase)
-      const bool devNameEqInt = equals(deviceName, F("int"));
-      if (devNameEqInt || equals(deviceName, F("var")))
-      {
-        // Address an internal variable either as float or as int
-        // For example: Let,10,[VAR#9]
-        uint32_t varNum;
-
-        if (validUIntFromString(valueName, varNum)) {
-          const ESPEASY_RULES_FLOAT_TYPE floatvalue = getCustomFloatVar(varNum);
-          unsigned char nr_decimals = maxNrDecimals_fpType(floatvalue);
-          bool trimTrailingZeros    = true;
-
-          if (devNameEqInt) {
-            nr_decimals = 0;
-          } else if (!format.isEmpty())
-          {
-            // There is some formatting here, so do not throw away decimals
-            trimTrailingZeros = false;
-          }
-          #if FEATURE_USE_DOUBLE_AS_ESPEASY_RULES_FLOAT_TYPE
-          String value = doubleToString(floatvalue, nr_decimals, trimTrailingZeros);
-          #else
-          String value = floatToString(floatvalue, nr_decimals, trimTrailingZeros);
-          #endif
-          transformValue(
-            newString, 
-            minimal_lineSize, 
-            std::move(value), 
-            format, 
-            tmpString);
-        }
-      }
-      else if (equals(deviceName, F("plugin")))
-      {
-        // Handle a plugin request.
-        // For example: "[Plugin#GPIO#Pinstate#N]"
-        // The command is stored in valueName & format
-        String command = strformat(F("%s#%s"), valueName.c_str(), format.c_str());
-        command.replace('#', ',');
-
-        if (getGPIOPinStateValues(command)) {
-          newString += command;
-        }
-  /* @giig1967g
-        if (PluginCall(PLUGIN_REQUEST, 0, command))
-        {
-          // Do not call transformValue here.
-          // The "format" is not empty so must not call the formatter function.
-          newString += command;
-        }
-  */
-      }
-      else
-      {
-        // Address a value from a plugin.
-        // For example: "[bme#temp]"
-        // If value name is unknown, run a PLUGIN_GET_CONFIG_VALUE command.
-        // For example: "[<taskname>#getLevel]"
-        taskIndex_t taskIndex = findTaskIndexByName(deviceName, true); // Check for enabled/disabled is done separately
-
-        if (validTaskIndex(taskIndex)) {
-          bool isHandled = false;
-          if (Settings.TaskDeviceEnabled[taskIndex]) {
-            uint8_t valueNr = findDeviceValueIndexByName(valueName, taskIndex);
-
-            if (valueNr != VARS_PER_TASK) {
-              // here we know the task and value, so find the uservar
-              // Try to format and transform the values
-              bool   isvalid;
-              String value = formatUserVar(taskIndex, valueNr, isvalid);
-
-              if (isvalid) {
-                transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-                isHandled = true;
-              }
-            } else {
-              // try if this is a get config request
-              struct EventStruct TempEvent(taskIndex);
-              String tmpName = valueName;
-
-              if (PluginCall(PLUGIN_GET_CONFIG_VALUE, &TempEvent, tmpName))
-              {
-                transformValue(newString, minimal_lineSize, std::move(tmpName), format, tmpString);
-                isHandled = true;
-              }
-            }
-          }
-          if (!isHandled && valueName.startsWith(F("settings."))) {  // Task settings values
-            String value;
-            if (valueName.endsWith(F(".enabled"))) {           // Task state
-              value = Settings.TaskDeviceEnabled[taskIndex] ? '1' : '0';
-            } else if (valueName.endsWith(F(".interval"))) {   // Task interval
-              value = Settings.TaskDeviceTimer[taskIndex];
-            } else if (valueName.endsWith(F(".valuecount"))) { // Task value count
-              value = getValueCountForTask(taskIndex);
-            } else if ((valueName.indexOf(F(".controller")) == 8) && valueName.length() >= 20) { // Task controller values
-              String ctrl = valueName.substring(19, 20);
-              int32_t ctrlNr = 0;
-              if (validIntFromString(ctrl, ctrlNr) && (ctrlNr >= 1) && (ctrlNr <= CONTROLLER_MAX) && 
-                  Settings.ControllerEnabled[ctrlNr - 1]) { // Controller nr. valid and enabled
-                if (valueName.endsWith(F(".enabled"))) {    // Task-controller enabled
-                  value = Settings.TaskDeviceSendData[ctrlNr - 1][taskIndex];
-                } else if (valueName.endsWith(F(".idx"))) { // Task-controller idx value
-                  protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(ctrlNr - 1);
-
-                  if (validProtocolIndex(ProtocolIndex) && 
-                      getProtocolStruct(ProtocolIndex).usesID && (Settings.Protocol[ctrlNr - 1] != 0)) {
-                    value = Settings.TaskDeviceID[ctrlNr - 1][taskIndex];
-                  }
-                }
-              }
-            }
-            if (!value.isEmpty()) {
-              transformValue(newString, minimal_lineSize, std::move(value), format, tmpString);
-              // isHandled = true;
-            }
-          }
-        }
-      }
+      parseTemplate_devValRef(newString, minimal_lineSize, deviceName, valueName, format, tmpString);
 
 
       // Conversion is done (or impossible) for the found "[...#...]"
@@ -232,10 +312,6 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
 
   // Copy the rest of the string (or all if no replacements were done)
   newString += tmpString.substring(lastStartpos);
-  #ifndef BUILD_NO_RAM_TRACKER
-  checkRAM(F("parseTemplate2"));
-  #endif // ifndef BUILD_NO_RAM_TRACKER
-
   if (mustReplaceEscapedSquareBracket) {
     // We now have to check if we did mask some escaped square bracket and unmask them.
     // Let's hope we don't mess up any Unicode here.
@@ -244,6 +320,39 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
     MaskEscapedBracket = static_cast<char>(0x06); // ASCII 0x06 = Acknowledge ACK
     newString.replace(MaskEscapedBracket, F("\\]"));
   }
+}
+
+String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool useURLencode)
+{
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("parseTemplate_padded"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
+  START_TIMER;
+
+  // Keep current loaded taskSettings to restore at the end.
+  const taskIndex_t currentTaskIndex = ExtraTaskSettings.TaskIndex;
+  String newString;
+  bool   isParsedTemplate = false;
+
+  #ifndef LIMIT_BUILD_SIZE
+
+  if ((parseTemplate_CallBack_ptr == nullptr) &&
+      ((tmpString.indexOf('%') != -1) || (tmpString.indexOf('[') != -1))) {
+    const std::shared_ptr<const ParsedTemplate> parsed = Cache.parsedTemplates.get(tmpString);
+
+    if ((parsed != nullptr) && parsed->isValid()) {
+      isParsedTemplate = parseTemplate_parsed(*parsed, newString, minimal_lineSize, useURLencode);
+    }
+  }
+  #endif // ifndef LIMIT_BUILD_SIZE
+
+  if (!isParsedTemplate) {
+    newString.reserve(minimal_lineSize); // Our best guess of the new size.
+    parseTemplate_text(tmpString, newString, minimal_lineSize, useURLencode);
+  }
+  #ifndef BUILD_NO_RAM_TRACKER
+  checkRAM(F("parseTemplate2"));
+  #endif // ifndef BUILD_NO_RAM_TRACKER
 
   // Restore previous loaded taskSettings
   if (validTaskIndex(currentTaskIndex))
@@ -261,7 +370,11 @@ String parseTemplate_padded(String& tmpString, uint8_t minimal_lineSize, bool us
     newString += ' ';
   }
 
-  STOP_TIMER(PARSE_TEMPLATE_PADDED);
+  if (isParsedTemplate) {
+    STOP_TIMER(PARSE_TEMPLATE_PADDED_CACHED);
+  } else {
+    STOP_TIMER(PARSE_TEMPLATE_PADDED);
+  }
   #ifndef BUILD_NO_RAM_TRACKER
   checkRAM(F("parseTemplate3"));
   #endif // ifndef BUILD_NO_RAM_TRACKER
@@ -644,10 +757,10 @@ void transformValue(
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
-taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled)
+taskIndex_t findTaskIndexByName(const String& deviceName, bool allowDisabled)
 {
-  deviceName.toLowerCase();
   // cache this, since LoadTaskSettings does take some time.
+  // The cache is case insensitive, so no need to convert deviceName to lower case.
   auto result = Cache.taskIndexName.find(deviceName);
 
   if (result != Cache.taskIndexName.end()) {
@@ -664,10 +777,7 @@ taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled)
         // Use entered taskDeviceName can have any case, so compare case insensitive.
         if (deviceName.equalsIgnoreCase(taskDeviceName))
         {
-          Cache.taskIndexName.emplace(
-            std::make_pair(
-              std::move(deviceName), 
-              taskIndex));
+          Cache.taskIndexName.emplace(std::move(taskDeviceName), taskIndex);
           return taskIndex;
         }
       }
@@ -690,15 +800,10 @@ uint8_t findDeviceValueIndexByName(const String& valueName, taskIndex_t taskInde
 
 
   // cache this, since LoadTaskSettings does take some time.
-  // We need to use a cache search key including the taskIndex,
+  // The taskIndex is used as group in the cache,
   // to allow several tasks to have the same value names.
-  String cache_valueName = strformat(
-    F("%s#%d"),                   // The '#' cannot exist in a value name, use it in the cache key.
-    valueName.c_str(),
-    static_cast<int>(taskIndex));
-  cache_valueName.toLowerCase();  // No need to store multiple versions of the same entry with only different case.
-  
-  auto result = Cache.taskIndexValueName.find(cache_valueName);
+  // The cache is case insensitive, so no need to convert valueName to lower case.
+  auto result = Cache.taskIndexValueName.find(valueName, taskIndex);
 
   if (result != Cache.taskIndexValueName.end()) {
     return result->second;
@@ -710,10 +815,7 @@ uint8_t findDeviceValueIndexByName(const String& valueName, taskIndex_t taskInde
     // Check case insensitive, since the user entered value name can have any case.
     if (valueName.equalsIgnoreCase(Cache.getTaskDeviceValueName(taskIndex, valueNr)))
     {
-      Cache.taskIndexValueName.emplace(
-        std::make_pair(
-          std::move(cache_valueName), 
-          valueNr));
+      Cache.taskIndexValueName.emplace(valueName, valueNr, taskIndex);
       return valueNr;
     }
   }
@@ -45,8 +45,8 @@ void transformValue(
 
 // Find the first (enabled) task with given name
 // Return INVALID_TASK_INDEX when not found, else return taskIndex
-// deviceName is deepcopy to only store lower case version in cache.
-taskIndex_t findTaskIndexByName(String deviceName, bool allowDisabled = false);
+// deviceName is matched case insensitive.
+taskIndex_t findTaskIndexByName(const String& deviceName, bool allowDisabled = false);
 
 // Find the first device value index of a taskIndex.
 // Return VARS_PER_TASK if none found.
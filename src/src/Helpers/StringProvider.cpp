@@ -19,6 +19,9 @@
 #include "../Globals/ESPEasy_Scheduler.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/EventQueue.h"
+#include "../Globals/Logging.h"
+#include "../Globals/MQTT.h"
 
 #if FEATURE_ETHERNET
 #include "../Globals/ESPEasyEthEvent.h"
@@ -142,6 +145,7 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
 #if FEATURE_TARSTREAM_SUPPORT
     case LabelType::DISABLE_SAVE_CONFIG_AS_TAR:  return F("Disable Save Config as .tar");
 #endif // if FEATURE_TARSTREAM_SUPPORT
+    case LabelType::LAZY_TASK_INIT:         return F("Lazy Task Init");
 
     case LabelType::BOOT_TYPE:              return F("Last Boot Cause");
     case LabelType::BOOT_COUNT:             return F("Boot Count");
@@ -226,12 +230,28 @@ const __FlashStringHelper * getLabel(LabelType::Enum label) {
     case LabelType::I2C_BUS_STATE:          return F("I2C Bus State");
     case LabelType::I2C_BUS_CLEARED_COUNT:  return F("I2C bus cleared count");
 
+    case LabelType::EVENT_QUEUE_PEAK_SIZE:  return F("Event Queue Peak Size");
+    case LabelType::EVENT_QUEUE_DROPPED:    return F("Event Queue Dropped");
+    case LabelType::EVENT_QUEUE_COALESCED:  return F("Event Queue Coalesced");
+#if FEATURE_MQTT
+    case LabelType::MQTT_BYTES_PUBLISHED:        return F("MQTT Bytes Published");
+    case LabelType::MQTT_BATCHED_MESSAGES_SAVED: return F("MQTT Messages Saved By Batching");
+#endif // if FEATURE_MQTT
+
     case LabelType::SYSLOG_LOG_LEVEL:       return F("Syslog Log Level");
     case LabelType::SERIAL_LOG_LEVEL:       return F("Serial Log Level");
     case LabelType::WEB_LOG_LEVEL:          return F("Web Log Level");
   #if FEATURE_SD
     case LabelType::SD_LOG_LEVEL:           return F("SD Log Level");
   #endif // if FEATURE_SD
+    case LabelType::SYSLOG_QUEUE_DROPPED:      return F("Syslog Queue Dropped");
+    case LabelType::SYSLOG_QUEUE_AVG_LATENCY:  return F("Syslog Queue Avg Latency");
+    case LabelType::SYSLOG_QUEUE_MAX_LATENCY:  return F("Syslog Queue Max Latency");
+  #if FEATURE_SD
+    case LabelType::SD_LOG_QUEUE_DROPPED:      return F("SD Log Queue Dropped");
+    case LabelType::SD_LOG_QUEUE_AVG_LATENCY:  return F("SD Log Queue Avg Latency");
+    case LabelType::SD_LOG_QUEUE_MAX_LATENCY:  return F("SD Log Queue Max Latency");
+  #endif // if FEATURE_SD
 
     case LabelType::ESP_CHIP_ID:            return F("ESP Chip ID");
     case LabelType::ESP_CHIP_FREQ:          return F("ESP Chip Frequency");
@@ -435,6 +455,7 @@ String getValue(LabelType::Enum label) {
 #if FEATURE_TARSTREAM_SUPPORT
     case LabelType::DISABLE_SAVE_CONFIG_AS_TAR: return jsonBool(Settings.DisableSaveConfigAsTar());
 #endif // if FEATURE_TARSTREAM_SUPPORT
+    case LabelType::LAZY_TASK_INIT:         return jsonBool(Settings.LazyTaskInit());
 
     case LabelType::BOOT_TYPE:              return getLastBootCauseString();
     case LabelType::BOOT_COUNT:             break;
@@ -565,12 +586,27 @@ String getValue(LabelType::Enum label) {
     #endif // ifdef CONFIGURATION_CODE
     case LabelType::I2C_BUS_STATE:          return toString(I2C_state);
     case LabelType::I2C_BUS_CLEARED_COUNT:  retval = I2C_bus_cleared_count; break;
+    case LabelType::EVENT_QUEUE_PEAK_SIZE:  retval = eventQueue.getPeakSize(); break;
+    case LabelType::EVENT_QUEUE_DROPPED:    retval = eventQueue.getNrDropped(); break;
+    case LabelType::EVENT_QUEUE_COALESCED:  retval = eventQueue.getNrCoalesced(); break;
+#if FEATURE_MQTT
+    case LabelType::MQTT_BYTES_PUBLISHED:        return String(mqtt_bytes_published);
+    case LabelType::MQTT_BATCHED_MESSAGES_SAVED: retval = mqtt_batched_messages_saved; break;
+#endif // if FEATURE_MQTT
     case LabelType::SYSLOG_LOG_LEVEL:       return getLogLevelDisplayString(Settings.SyslogLevel);
     case LabelType::SERIAL_LOG_LEVEL:       return getLogLevelDisplayString(getSerialLogLevel());
     case LabelType::WEB_LOG_LEVEL:          return getLogLevelDisplayString(getWebLogLevel());
   #if FEATURE_SD
     case LabelType::SD_LOG_LEVEL:           return getLogLevelDisplayString(Settings.SDLogLevel);
   #endif // if FEATURE_SD
+    case LabelType::SYSLOG_QUEUE_DROPPED:      return String(SyslogSinkQueue.getNrDropped());
+    case LabelType::SYSLOG_QUEUE_AVG_LATENCY:  return String(SyslogSinkQueue.getAvgLatency());
+    case LabelType::SYSLOG_QUEUE_MAX_LATENCY:  return String(SyslogSinkQueue.getMaxLatency());
+  #if FEATURE_SD
+    case LabelType::SD_LOG_QUEUE_DROPPED:      return String(SDLogSinkQueue.getNrDropped());
+    case LabelType::SD_LOG_QUEUE_AVG_LATENCY:  return String(SDLogSinkQueue.getAvgLatency());
+    case LabelType::SD_LOG_QUEUE_MAX_LATENCY:  return String(SDLogSinkQueue.getMaxLatency());
+  #endif // if FEATURE_SD
 
     case LabelType::ESP_CHIP_ID:            return formatToHex(getChipId(), 6);
     case LabelType::ESP_CHIP_FREQ:          retval = ESP.getCpuFreqMHz(); break;
@@ -770,6 +806,14 @@ String getFormUnit(LabelType::Enum label)
     case LabelType::TIME_WANDER:
       flash_str = F("ppm");
       break;
+    case LabelType::SYSLOG_QUEUE_AVG_LATENCY:
+    case LabelType::SYSLOG_QUEUE_MAX_LATENCY:
+#if FEATURE_SD
+    case LabelType::SD_LOG_QUEUE_AVG_LATENCY:
+    case LabelType::SD_LOG_QUEUE_MAX_LATENCY:
+#endif
+      flash_str = F("ms");
+      break;
 #ifdef ESP32
     case LabelType::HEAP_SIZE:
     case LabelType::HEAP_MIN_FREE:
@@ -90,6 +90,7 @@ struct LabelType {
 #if FEATURE_TARSTREAM_SUPPORT
     DISABLE_SAVE_CONFIG_AS_TAR,
 #endif // if FEATURE_TARSTREAM_SUPPORT
+    LAZY_TASK_INIT,
 
     BOOT_TYPE,               // Cold boot
     BOOT_COUNT,              // 0
@@ -174,12 +175,29 @@ struct LabelType {
     I2C_BUS_STATE,
     I2C_BUS_CLEARED_COUNT,
 
+    EVENT_QUEUE_PEAK_SIZE,
+    EVENT_QUEUE_DROPPED,
+    EVENT_QUEUE_COALESCED,
+
+#if FEATURE_MQTT
+    MQTT_BYTES_PUBLISHED,
+    MQTT_BATCHED_MESSAGES_SAVED,
+#endif // if FEATURE_MQTT
+
     SYSLOG_LOG_LEVEL,
     SERIAL_LOG_LEVEL,
     WEB_LOG_LEVEL,
 #if FEATURE_SD
     SD_LOG_LEVEL,
 #endif // if FEATURE_SD
+    SYSLOG_QUEUE_DROPPED,
+    SYSLOG_QUEUE_AVG_LATENCY,
+    SYSLOG_QUEUE_MAX_LATENCY,
+#if FEATURE_SD
+    SD_LOG_QUEUE_DROPPED,
+    SD_LOG_QUEUE_AVG_LATENCY,
+    SD_LOG_QUEUE_MAX_LATENCY,
+#endif // if FEATURE_SD
 
     ESP_CHIP_ID,
     ESP_CHIP_FREQ,
@@ -0,0 +1,173 @@
+#include "../Helpers/_CPlugin_C013_helper.h"
+
+#ifdef USES_C013
+
+# include "../DataStructs/C013_p2p_SensorDataBatchStruct.h"
+# include "../DataStructs/TimingStats.h"
+
+# include "../ESPEasyCore/ESPEasy_Log.h"
+
+# include "../Globals/ESPEasy_Scheduler.h"
+# include "../Globals/Nodes.h"
+# include "../Globals/Settings.h"
+
+# include "../Helpers/Misc.h"
+# include "../Helpers/Network.h"
+# include "../Helpers/Networking.h"
+# include "../Helpers/StringConverter.h"
+
+# include <vector>
+
+// Socket used to send, bound to a random port.
+// Kept open as creating a socket for each message is quite costly.
+WiFiUDP C013_portUDP;
+bool    C013_portUDP_open = false;
+
+std::vector<C013_SensorDataStruct> C013_pendingSensorData;
+
+
+void C013_queueSensorData(const C013_SensorDataStruct& dataReply)
+{
+  if (!C013_acceptsSensorDataBatch(dataReply.destUnit)) {
+    C013_sendUDP(dataReply.destUnit, reinterpret_cast<const uint8_t *>(&dataReply), sizeof(C013_SensorDataStruct));
+    return;
+  }
+  C013_pendingSensorData.push_back(dataReply);
+
+  if (C013_pendingSensorData.size() >= C013_SENSOR_DATA_BATCH_MAX_RECORDS) {
+    C013_flushSensorData();
+  } else {
+    Scheduler.scheduleNextDelayQueue(
+      SchedulerIntervalTimer_e::TIMER_C013_DELAY_QUEUE,
+      millis() + C013_SENSOR_DATA_BATCH_DELAY);
+  }
+}
+
+void C013_flushSensorData()
+{
+  // Records are grouped per destination unit, keeping the order of records per unit.
+  while (!C013_pendingSensorData.empty()) {
+    const uint8_t destUnit = C013_pendingSensorData.front().destUnit;
+
+    // Enough to hold C013_SENSOR_DATA_BATCH_MAX_RECORDS
+    uint8_t buffer[UDP_PACKETSIZE_MAX];
+
+    C013_SensorDataBatchStruct batch;
+
+    batch.sourceUnit = Settings.Unit;
+    batch.destUnit   = destUnit;
+
+    size_t size = sizeof(C013_SensorDataBatchStruct);
+
+    for (auto it = C013_pendingSensorData.begin(); it != C013_pendingSensorData.end();) {
+      if (it->destUnit == destUnit) {
+        memcpy(&buffer[size], &(*it), sizeof(C013_SensorDataStruct));
+        size += sizeof(C013_SensorDataStruct);
+        ++batch.nrRecords;
+        it = C013_pendingSensorData.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    if (batch.nrRecords == 1) {
+      // No need for the batch header
+      C013_sendUDP(destUnit, &buffer[sizeof(C013_SensorDataBatchStruct)], sizeof(C013_SensorDataStruct));
+    } else {
+      memcpy(buffer, &batch, sizeof(C013_SensorDataBatchStruct));
+      C013_sendUDP(destUnit, buffer, size, batch.nrRecords);
+    }
+  }
+}
+
+bool C013_acceptsSensorDataBatch(uint8_t unit)
+{
+  if (unit != 255) {
+    const NodeStruct *node = Nodes.getNode(unit);
+    return (node != nullptr) && (node->build >= C013_SENSOR_DATA_BATCH_MIN_BUILD);
+  }
+
+  // Unknown nodes may also receive the broadcast, so at least one other node must be known.
+  bool otherNodeFound = false;
+
+  for (auto it = Nodes.begin(); it != Nodes.end(); ++it) {
+    if (it->first != Settings.Unit) {
+      if (it->second.build < C013_SENSOR_DATA_BATCH_MIN_BUILD) {
+        return false;
+      }
+      otherNodeFound = true;
+    }
+  }
+  return otherNodeFound;
+}
+
+bool C013_sendUDP(uint8_t unit, const uint8_t *data, size_t size, uint8_t nrRecords)
+{
+  START_TIMER
+
+  if (!NetworkConnected(10)) {
+    C013_closeUDP();
+    return false;
+  }
+
+  const IPAddress remoteNodeIP = getIPAddressForUnit(unit);
+
+
+# ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG_MORE)) {
+    addLogMove(LOG_LEVEL_DEBUG_MORE, strformat(
+                 F("C013 : Send UDP message to %d (%s) %d records"),
+                 unit,
+                 remoteNodeIP.toString().c_str(),
+                 nrRecords));
+  }
+# endif // ifndef BUILD_NO_DEBUG
+
+  statusLED(true);
+
+  if (!C013_portUDP_open) {
+    C013_portUDP_open = beginWiFiUDP_randomPort(C013_portUDP);
+
+    if (!C013_portUDP_open) {
+      STOP_TIMER(C013_SEND_UDP_FAIL);
+      return false;
+    }
+  }
+
+  // Nothing should be sent to this port, but make sure received packets are not kept in memory.
+  while (C013_portUDP.parsePacket() > 0) {}
+
+  FeedSW_watchdog();
+
+  if ((C013_portUDP.beginPacket(remoteNodeIP, Settings.UDPPort) == 0) ||
+      (C013_portUDP.write(data, size) != size) ||
+      (C013_portUDP.endPacket() == 0)) {
+    // Socket may no longer be usable, e.g. after a network change.
+    C013_portUDP.stop();
+    C013_portUDP_open = false;
+    STOP_TIMER(C013_SEND_UDP_FAIL);
+    return false;
+  }
+  Nodes.markP2P_sent(unit, nrRecords);
+  FeedSW_watchdog();
+  delay(0);
+  STOP_TIMER(C013_SEND_UDP);
+  return true;
+}
+
+void C013_closeUDP()
+{
+  if (NetworkConnected(10)) {
+    C013_flushSensorData();
+  } else {
+    C013_pendingSensorData.clear();
+  }
+
+  if (C013_portUDP_open) {
+    C013_portUDP.stop();
+    C013_portUDP_open = false;
+  }
+}
+
+#endif // ifdef USES_C013
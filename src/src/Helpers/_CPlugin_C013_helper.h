@@ -0,0 +1,40 @@
+#ifndef HELPERS__CPLUGIN_C013_HELPER_H
+#define HELPERS__CPLUGIN_C013_HELPER_H
+
+#include "../../ESPEasy_common.h"
+
+#ifdef USES_C013
+
+# include "../DataStructs/C013_p2p_SensorDataStruct.h"
+
+// Time in msec to collect sensor data of tasks sent shortly after each other,
+// before sending them in a single message.
+# ifndef C013_SENSOR_DATA_BATCH_DELAY
+#  define C013_SENSOR_DATA_BATCH_DELAY  5
+# endif // ifndef C013_SENSOR_DATA_BATCH_DELAY
+
+// Queue sensor data to be sent.
+// Records for the same unit are sent in a single message when the receiving node(s) support it.
+// Otherwise the record is sent immediately.
+void C013_queueSensorData(const C013_SensorDataStruct& dataReply);
+
+// Send all queued sensor data.
+void C013_flushSensorData();
+
+// Whether unit (255 = broadcast) accepts batched sensor data.
+// For broadcast all known nodes must accept it.
+bool C013_acceptsSensorDataBatch(uint8_t unit);
+
+// Send UDP message (unit 255 = broadcast)
+// The socket is kept open between calls.
+bool C013_sendUDP(uint8_t        unit,
+                  const uint8_t *data,
+                  size_t         size,
+                  uint8_t        nrRecords = 1);
+
+// Send queued data and close the socket.
+void C013_closeUDP();
+
+#endif // ifdef USES_C013
+
+#endif // ifndef HELPERS__CPLUGIN_C013_HELPER_H
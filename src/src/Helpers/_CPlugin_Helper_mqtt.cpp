@@ -3,6 +3,7 @@
 
 #if FEATURE_MQTT
 # include "../Commands/ExecuteCommand.h"
+# include "../Globals/MQTT.h"
 
 /***************************************************************************************
  * Parse MQTT topic for /cmd and /set ending to handle commands or TaskValueSet
@@ -185,9 +186,60 @@ void MQTT_execute_command(String& cmd,
   }
 }
 
+// Publish all task values as a single JSON message, e.g. {"Temperature":21.5,"Humidity":48}
+// %valname% in the topic is replaced by "All", like the combined rules event.
+static bool MQTT_protocol_send_JSON(EventStruct *event,
+                                    String     & pubname,
+                                    bool         retainFlag) {
+  const uint8_t valueCount = getValueCountForTask(event->TaskIndex);
+  uint8_t nrValues         = 0;
+  String  payload;
+
+  reserve_special(payload, 24 * valueCount);
+  payload += '{';
+
+  for (uint8_t x = 0; x < valueCount; ++x) {
+    // Skip values with empty labels, same as when publishing per value
+    const String valueName = getTaskValueName(event->TaskIndex, x);
+
+    if (valueName.isEmpty()) {
+      continue;
+    }
+
+    if (nrValues != 0) {
+      payload += ',';
+    }
+    payload += to_json_object_value(valueName, formatUserVarNoCheck(event, x));
+    ++nrValues;
+  }
+  payload += '}';
+
+  if (nrValues == 0) {
+    return false;
+  }
+  pubname.replace(F("%valname%"), F("All"));
+  parseControllerVariables(pubname, event, false);
+
+  # ifndef BUILD_NO_DEBUG
+
+  if (loglevelActiveFor(LOG_LEVEL_DEBUG)) {
+    addLog(LOG_LEVEL_DEBUG, strformat(F("MQTT C%03d : %s %s"), event->ControllerIndex, pubname.c_str(), payload.c_str()));
+  }
+  # endif // ifndef BUILD_NO_DEBUG
+
+  if (!MQTTpublish(event->ControllerIndex, event->TaskIndex, std::move(pubname), std::move(payload), retainFlag)) {
+    return false;
+  }
+  mqtt_batched_messages_saved += nrValues - 1;
+  return true;
+}
+
 bool MQTT_protocol_send(EventStruct *event,
                         String       pubname,
                         bool         retainFlag) {
+  if (mqtt_batchJSON && (event->sensorType != Sensor_VType::SENSOR_TYPE_STRING)) {
+    return MQTT_protocol_send_JSON(event, pubname, retainFlag);
+  }
   bool success                = false;
   const bool contains_valname = pubname.indexOf(F("%valname%")) != -1;
 
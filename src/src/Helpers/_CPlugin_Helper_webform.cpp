@@ -47,6 +47,7 @@ const __FlashStringHelper* toString(ControllerSettingsStruct::VarType parameterI
 #if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_UNIQUE_CLIENT_ID_RECONNECT: return F("Unique Client ID on Reconnect");
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:               return F("Publish Retain Flag");
+    case ControllerSettingsStruct::CONTROLLER_MQTT_BATCH_JSON:          return F("Publish Task Values As JSON");
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:                return F("Controller Subscribe");
     case ControllerSettingsStruct::CONTROLLER_PUBLISH:                  return F("Controller Publish");
@@ -341,6 +342,10 @@ void addControllerParameterForm(const ControllerSettingsStruct  & ControllerSett
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_retainFlag());
       break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_BATCH_JSON:
+      addFormCheckBox(displayName, internalName, ControllerSettings.mqtt_batchJSON());
+      addFormNote(F("Publish all values of a task in a single message, %valname% in the topic is replaced by 'All'"));
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       addFormTextBox(displayName, internalName, ControllerSettings.Subscribe, sizeof(ControllerSettings.Subscribe) - 1);
@@ -513,6 +518,9 @@ void saveControllerParameterForm(ControllerSettingsStruct        & ControllerSet
     case ControllerSettingsStruct::CONTROLLER_RETAINFLAG:
       ControllerSettings.mqtt_retainFlag(isFormItemChecked(internalName));
       break;
+    case ControllerSettingsStruct::CONTROLLER_MQTT_BATCH_JSON:
+      ControllerSettings.mqtt_batchJSON(isFormItemChecked(internalName));
+      break;
 #endif // if FEATURE_MQTT
     case ControllerSettingsStruct::CONTROLLER_SUBSCRIBE:
       strncpy_webserver_arg(ControllerSettings.Subscribe, internalName);
@@ -7,9 +7,11 @@
 #define MAX_SCHEDULER_WAIT_TIME 50 // Max delay used in the scheduler for passing idle time.
 
   msecTimerHandlerStruct::msecTimerHandlerStruct() : get_called(0), get_called_ret_id(0), max_queue_length(0),
-    last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true)
+    last_exec_time_usec(0), total_idle_time_usec(0),  idle_time_pct(0.0f), is_idle(false), eco_mode(true),
+    _capacity(0)
   {
     last_log_start_time = millis();
+    ensureCapacity();
   }
 
   void msecTimerHandlerStruct::setEcoMode(bool enabled) {
@@ -40,8 +42,8 @@
       }
       return 0;
     }
-    timer_id_couple item = _timer_ids.front();
-    const long passed    = timePassedSince(item._timer);
+    const timer_id_couple item = _timer_ids.front();
+    const long passed          = timePassedSince(item._timer);
 
     if (passed < 0) {
       // No timeOutReached
@@ -61,10 +63,7 @@
       return 0;
     }
     recordRunning();
-    unsigned long size = _timer_ids.size();
-
-    if (size > max_queue_length) { max_queue_length = size; }
-    _timer_ids.pop_front();
+    removeAtSlot(0);
     timer = item._timer;
     ++get_called_ret_id;
     return item._id;
@@ -72,13 +71,11 @@
 
 
   bool msecTimerHandlerStruct::getTimerForId(unsigned long id, unsigned long& timer) const {
-    for (auto it = _timer_ids.begin(); it != _timer_ids.end(); ++it) {
-      if (it->_id == id) {
-        timer = it->_timer;
-        return true;
-      }
-    }
-    return false;
+    const int32_t pos = indexFind(id);
+
+    if (pos < 0) { return false; }
+    timer = _timer_ids[_index[pos]._slot]._timer;
+    return true;
   }
 
   String msecTimerHandlerStruct::getQueueStats() {
@@ -90,6 +87,10 @@
     result           += '/';
     result           += max_queue_length;
     result           += '/';
+    result           += _timer_ids.size();
+    result           += '/';
+    result           += _capacity;
+    result           += '/';
     result           += idle_time_pct;
     get_called        = 0;
     get_called_ret_id = 0;
@@ -110,38 +111,180 @@
     return idle_time_pct;
   }
 
-  struct match_id {
-    match_id(unsigned long id) : _id(id) {}
+  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (item._id == 0) { return; }
 
-    bool operator()(const timer_id_couple& item) {
-      return _id == item._id;
+    // Make sure only one is present with the same id.
+    const int32_t pos = indexFind(item._id);
+
+    if (pos >= 0) {
+      // Reschedule an existing timer in place.
+      const uint16_t slot = _index[pos]._slot;
+      _timer_ids[slot]._timer = item._timer;
+      siftUp(slot);
+      siftDown(_index[pos]._slot);
+      return;
     }
 
-    unsigned long _id;
-  };
+    ensureCapacity();
+    const uint16_t slot = _timer_ids.size();
+    _timer_ids.push_back(item);
+    indexInsert(item._id, slot);
+    siftUp(slot);
 
-  void msecTimerHandlerStruct::insert(const timer_id_couple& item) {
+    if (_timer_ids.size() > max_queue_length) { max_queue_length = _timer_ids.size(); }
+  }
+
+  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
     if (item._id == 0) { return; }
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
-    const bool mustSort = !_timer_ids.empty();
-    _timer_ids.push_front(item);
+    const int32_t pos = indexFind(item._id);
 
-    if (mustSort) {
-      _timer_ids.sort(); // TD-er: Must check if this is an expensive operation.
+    if (pos >= 0) {
+      removeAtSlot(_index[pos]._slot);
     }
+  }
+
+  void msecTimerHandlerStruct::removeAtSlot(uint16_t slot) {
+    const int32_t pos = indexFind(_timer_ids[slot]._id);
 
-    // It should be a relative light operation, to insert into a sorted list.
-    // Perhaps it is better to use std::set ????
-    // Keep in mind: order is based on timer, uniqueness is based on id.
+    if (pos >= 0) {
+      indexErase(pos);
+    }
+    const uint16_t last = _timer_ids.size() - 1;
+
+    if (slot != last) {
+      // Move the last element into the gap and restore heap order.
+      const unsigned long movedId = _timer_ids[last]._id;
+      placeAtSlot(slot, _timer_ids[last]);
+      _timer_ids.pop_back();
+      siftUp(slot);
+      const int32_t movedPos = indexFind(movedId);
+
+      if (movedPos >= 0) {
+        siftDown(_index[movedPos]._slot);
+      }
+    } else {
+      _timer_ids.pop_back();
+    }
   }
 
-  void msecTimerHandlerStruct::remove(const timer_id_couple& item) {
-    if (item._id == 0) { return; }
+  void msecTimerHandlerStruct::siftUp(uint16_t slot) {
+    const timer_id_couple item = _timer_ids[slot];
 
-    // Make sure only one is present with the same id.
-    _timer_ids.remove_if(match_id(item._id));
+    while (slot > 0) {
+      const uint16_t parent = (slot - 1) / 2;
+
+      if (!firesBefore(item, _timer_ids[parent])) { break; }
+      placeAtSlot(slot, _timer_ids[parent]);
+      slot = parent;
+    }
+    placeAtSlot(slot, item);
+  }
+
+  void msecTimerHandlerStruct::siftDown(uint16_t slot) {
+    const timer_id_couple item = _timer_ids[slot];
+    const uint16_t size        = _timer_ids.size();
+
+    while (true) {
+      uint16_t child = 2 * slot + 1;
+
+      if (child >= size) { break; }
+
+      if (((child + 1) < size) && firesBefore(_timer_ids[child + 1], _timer_ids[child])) {
+        ++child;
+      }
+
+      if (!firesBefore(_timer_ids[child], item)) { break; }
+      placeAtSlot(slot, _timer_ids[child]);
+      slot = child;
+    }
+    placeAtSlot(slot, item);
+  }
+
+  void msecTimerHandlerStruct::placeAtSlot(uint16_t slot, const timer_id_couple& item) {
+    // Index entries keep their own copy of the id, so lookup remains valid
+    // while the heap is being reordered.
+    const int32_t pos = indexFind(item._id);
+
+    if (pos >= 0) {
+      _index[pos]._slot = slot;
+    }
+    _timer_ids[slot] = item;
+  }
+
+  bool msecTimerHandlerStruct::firesBefore(const timer_id_couple& a, const timer_id_couple& b) {
+    // timeDiff > 0, means b is set after a
+    return timeDiff(a._timer, b._timer) > 0;
+  }
+
+  uint32_t msecTimerHandlerStruct::indexHome(unsigned long id) const {
+    // Fibonacci hashing, the mixed IDs differ mainly in the lower bits.
+    return (static_cast<uint32_t>(id) * 2654435769ul) & (_index.size() - 1);
+  }
+
+  int32_t msecTimerHandlerStruct::indexFind(unsigned long id) const {
+    if (id == 0) { return -1; }
+    const uint32_t mask = _index.size() - 1;
+    uint32_t pos        = indexHome(id);
+
+    while (_index[pos]._id != 0) {
+      if (_index[pos]._id == id) { return pos; }
+      pos = (pos + 1) & mask;
+    }
+    return -1;
+  }
+
+  void msecTimerHandlerStruct::indexInsert(unsigned long id, uint16_t slot) {
+    const uint32_t mask = _index.size() - 1;
+    uint32_t pos        = indexHome(id);
+
+    while (_index[pos]._id != 0) {
+      pos = (pos + 1) & mask;
+    }
+    _index[pos]._id   = id;
+    _index[pos]._slot = slot;
+  }
+
+  void msecTimerHandlerStruct::indexErase(uint32_t pos) {
+    // Backward shift deletion, so no tombstones are needed.
+    const uint32_t mask = _index.size() - 1;
+    uint32_t hole       = pos;
+    uint32_t next       = (pos + 1) & mask;
+
+    while (_index[next]._id != 0) {
+      const uint32_t home = indexHome(_index[next]._id);
+
+      // Entry may move into the hole when the hole is within [home, next)
+      if (((next - home) & mask) >= ((next - hole) & mask)) {
+        _index[hole] = _index[next];
+        hole         = next;
+      }
+      next = (next + 1) & mask;
+    }
+    _index[hole]._id   = 0;
+    _index[hole]._slot = 0;
+  }
+
+  void msecTimerHandlerStruct::ensureCapacity() {
+    if (_timer_ids.size() < _capacity) { return; }
+    _capacity = (_capacity == 0) ? MSEC_TIMER_HANDLER_INITIAL_CAPACITY : 2 * _capacity;
+    _timer_ids.reserve(_capacity);
+    rebuildIndex();
+  }
+
+  void msecTimerHandlerStruct::rebuildIndex() {
+    uint32_t indexSize = 1;
+
+    while (indexSize < (2u * _capacity)) {
+      indexSize <<= 1;
+    }
+    _index.clear();
+    _index.resize(indexSize);
+
+    for (uint16_t slot = 0; slot < _timer_ids.size(); ++slot) {
+      indexInsert(_timer_ids[slot]._id, slot);
+    }
   }
 
   void msecTimerHandlerStruct::recordIdle() {
@@ -3,11 +3,18 @@
 
 
 #include "../../ESPEasy_common.h"
-#include <list>
+#include <vector>
 
 #include "../DataStructs/timer_id_couple.h"
 
 
+// Initial number of timers which can be scheduled without allocating memory.
+// When more timers are scheduled, the capacity is doubled.
+#ifndef MSEC_TIMER_HANDLER_INITIAL_CAPACITY
+  # define MSEC_TIMER_HANDLER_INITIAL_CAPACITY  32
+#endif // ifndef MSEC_TIMER_HANDLER_INITIAL_CAPACITY
+
+
 struct msecTimerHandlerStruct {
   msecTimerHandlerStruct();
 
@@ -27,6 +34,7 @@ struct msecTimerHandlerStruct {
   bool   getTimerForId(unsigned long  id,
                        unsigned long& timer) const;
 
+  // Format: called/tasks/max_length/cur_length/capacity/idle%
   String getQueueStats();
 
   void   updateIdleTimeStats();
@@ -35,13 +43,50 @@ struct msecTimerHandlerStruct {
 
 private:
 
-  void insert(const timer_id_couple& item);
+  // Entry in the id -> heap slot index.
+  // An entry with _id == 0 is an empty bucket, as id 0 is never scheduled.
+  struct index_entry {
+    unsigned long _id   = 0;
+    uint16_t      _slot = 0;
+  };
+
+  void     insert(const timer_id_couple& item);
+
+  void     remove(const timer_id_couple& item);
+
+  // Remove the item at given heap slot and restore the heap property.
+  void     removeAtSlot(uint16_t slot);
+
+  void     siftUp(uint16_t slot);
+
+  void     siftDown(uint16_t slot);
+
+  // Place item in the heap at given slot and update its index entry.
+  void     placeAtSlot(uint16_t               slot,
+                       const timer_id_couple& item);
 
-  void remove(const timer_id_couple& item);
+  // Returns true when a fires before b, taking millis() overflow into account.
+  static bool firesBefore(const timer_id_couple& a,
+                          const timer_id_couple& b);
 
-  void recordIdle();
+  uint32_t indexHome(unsigned long id) const;
 
-  void recordRunning();
+  // Return the position in _index of the entry for id, or -1 when not present.
+  int32_t  indexFind(unsigned long id) const;
+
+  void     indexInsert(unsigned long id,
+                       uint16_t      slot);
+
+  void     indexErase(uint32_t pos);
+
+  // Make sure there is room for at least one more timer.
+  void     ensureCapacity();
+
+  void     rebuildIndex();
+
+  void     recordIdle();
+
+  void     recordRunning();
 
   // Statistics
   unsigned long get_called;
@@ -52,12 +97,18 @@ private:
   uint64_t last_exec_time_usec;
   uint64_t total_idle_time_usec;
   uint32_t last_log_start_time;
-  float         idle_time_pct;
-  bool          is_idle;
-  bool          eco_mode;
-
-  // The list of set timers
-  std::list<timer_id_couple>_timer_ids;
+  float    idle_time_pct;
+  bool     is_idle;
+  bool     eco_mode;
+
+  // Binary min-heap of set timers, ordered on timer.
+  // Memory is reserved up front, so scheduling does not allocate.
+  std::vector<timer_id_couple>_timer_ids;
+
+  // Open addressing hash table (linear probing) mapping id -> slot in _timer_ids.
+  // Size is a power of 2 and at least twice the heap capacity.
+  std::vector<index_entry>_index;
+  uint16_t _capacity;
 };
 
 #endif // HELPERS_MSECTIMERHANDLERSTRUCT_H
@@ -6,6 +6,15 @@
 # include "../Globals/C016_ControllerCache.h"
 # include "../Globals/MQTT.h"
 
+# include <vector>
+
+# if FEATURE_HTTP_CLIENT
+#  include "../Globals/CPlugins.h"
+#  include "../Helpers/_CPlugin_Helper.h"
+
+#  include <bitset>
+# endif // if FEATURE_HTTP_CLIENT
+
 
 P146_data_struct::P146_data_struct(struct EventStruct *event)
 {
@@ -122,17 +131,32 @@ uint32_t P146_data_struct::sendBinaryInBulk(taskIndex_t P146_TaskIndex, uint32_t
   // Used an estimate of 5 here.
   const size_t data_left = (maxMessageSize - message.length() - 5);
   const size_t chunkSize = sizeof(C016_binary_element);
-  size_t nrChunks        = data_left / ((2 * chunkSize) + 1);
+  const size_t maxChunks = data_left / ((2 * chunkSize) + 1);
+
+  // The nr. of samples left in a file cannot be derived from its size when it is compressed.
+  // So first collect the samples, up to the end of the current file, and stop when peek() fails.
+  std::vector<C016_binary_element> elements;
+
+  elements.reserve(maxChunks);
+
+  while (elements.size() < maxChunks) {
+    C016_binary_element element;
+
+    if (!ControllerCache.peek(reinterpret_cast<uint8_t *>(&element), chunkSize)) {
+      break;
+    }
+    elements.push_back(element);
 
-  if (peekReadPos < peekFileSize) {
-    // Try to serve the rest of the file in 1 go.
-    const size_t chunksLeftInFile = (peekFileSize - peekReadPos) / chunkSize;
+    int curFileNr = 0;
 
-    if (chunksLeftInFile < nrChunks) {
-      nrChunks = chunksLeftInFile;
+    if (ControllerCache.getPeekFilePos(curFileNr) < 0 || curFileNr != peekFileNr) {
+      // Try to serve the rest of the file in 1 go, but not beyond.
+      break;
     }
   }
 
+  const size_t nrChunks = elements.size();
+
   message += nrChunks;
   message += ';';
   const size_t messageLength = message.length();
@@ -149,36 +173,35 @@ uint32_t P146_data_struct::sendBinaryInBulk(taskIndex_t P146_TaskIndex, uint32_t
 
   if (!MQTTclient.beginPublish(topic.c_str(), expectedMessageSize, false)) {
     // Can't start a message
+    ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
     return 0;
   }
   writeToMqtt(message, true);
 
   for (size_t chunk = 0; chunk < nrChunks; ++chunk) {
-    C016_binary_element element;
+    const C016_binary_element& element = elements[chunk];
+
+    // Test data to show layout of binary content:
+
+    /*
+          element._timestamp = 0x11223344;
+          element.TaskIndex = 0x55;
+          element.controller_idx = 0x66;
+          element.sensorType = Sensor_VType::SENSOR_TYPE_NONE; // 0x00
+          element.valueCount = 0x88;
+          element.values[0] = 0x99;
+          element.values[1] = 0xAA;
+          element.values[2] = 0xBB;
+          element.values[3] = 0xCC;
+     */
+
+    // Example of MQTT message containing a single CacheController sample:
+    // Filenr;Filepos;Sample (24 bytes -> 48 HEX digits);
+    // 17;14616;0000194300002a4300003b4300004c434433221155660088;
+
+    // val[0]   val[1]   val[2]   val[3]   timestmp taskidx PluginID SensorType ValueCount
+    // 00001943 00002a43 00003b43 00004c43 44332211 55      66       00         88
 
-    if (ControllerCache.peek(reinterpret_cast<uint8_t *>(&element), chunkSize))
-    {
-      // Test data to show layout of binary content:
-
-      /*
-            element._timestamp = 0x11223344;
-            element.TaskIndex = 0x55;
-            element.controller_idx = 0x66;
-            element.sensorType = Sensor_VType::SENSOR_TYPE_NONE; // 0x00
-            element.valueCount = 0x88;
-            element.values[0] = 0x99;
-            element.values[1] = 0xAA;
-            element.values[2] = 0xBB;
-            element.values[3] = 0xCC;
-       */
-
-      // Example of MQTT message containing a single CacheController sample:
-      // Filenr;Filepos;Sample (24 bytes -> 48 HEX digits);
-      // 17;14616;0000194300002a4300003b4300004c434433221155660088;
-
-      // val[0]   val[1]   val[2]   val[3]   timestmp taskidx PluginID SensorType ValueCount
-      // 00001943 00002a43 00003b43 00004c43 44332211 55      66       00         88
-    }
     writeToMqtt(formatToHex_array(reinterpret_cast<const uint8_t *>(&element), chunkSize), true);
     writeToMqtt(';',                                                                       true);
   }
@@ -410,6 +433,313 @@ bool P146_data_struct::sendViaOriginalTask(
   return success;
 }
 
+# if FEATURE_HTTP_CLIENT
+
+controllerIndex_t P146_data_struct::getHttpControllerIndex(taskIndex_t P146_TaskIndex)
+{
+  for (controllerIndex_t x = 0; x < CONTROLLER_MAX; ++x) {
+    // Make sure we are not sending to the cache controller.
+    if ((Settings.Protocol[x] != 16) &&
+        Settings.ControllerEnabled[x] &&
+        Settings.TaskDeviceSendData[x][P146_TaskIndex]) {
+      const protocolIndex_t ProtocolIndex = getProtocolIndex_from_ControllerIndex(x);
+
+      if (validProtocolIndex(ProtocolIndex)) {
+        const ProtocolStruct& proto = getProtocolStruct(ProtocolIndex);
+
+        if (!proto.usesMQTT && proto.usesHost) {
+          return x;
+        }
+      }
+    }
+  }
+  return INVALID_CONTROLLER_INDEX;
+}
+
+uint32_t P146_data_struct::sendHttpInBulk(taskIndex_t P146_TaskIndex, uint32_t maxSamples, uint8_t format) const
+{
+  if (!NetworkConnected()) {
+    return 0;
+  }
+  const controllerIndex_t controller_idx = getHttpControllerIndex(P146_TaskIndex);
+
+  if (!validControllerIndex(controller_idx)) {
+    return 0;
+  }
+
+  // Keep the current peek position, so we can reset it when we fail to deliver the data to the controller.
+  int peekFileNr        = 0;
+  const int peekReadPos = ControllerCache.getPeekFilePos(peekFileNr);
+
+  // Limit the nr. of samples to what fits in the largest free block of memory,
+  // and allocate the body in one go to avoid fragmenting the heap while it grows.
+  uint32_t maxFreeBlock = 0;
+  #ifdef ESP32
+  maxFreeBlock = ESP.getMaxAllocHeap();
+  #endif // ifdef ESP32
+  #ifdef ESP8266
+  maxFreeBlock = ESP.getMaxFreeBlockSize();
+  #endif // ifdef ESP8266
+
+  if (maxFreeBlock < (P146_HTTP_HEAP_MARGIN + P146_HTTP_BODY_OVERHEAD_ESTIMATE + P146_HTTP_SAMPLE_SIZE_ESTIMATE)) {
+    return 0;
+  }
+  const uint32_t samplesFit =
+    (maxFreeBlock - P146_HTTP_HEAP_MARGIN - P146_HTTP_BODY_OVERHEAD_ESTIMATE) / P146_HTTP_SAMPLE_SIZE_ESTIMATE;
+
+  if (maxSamples > samplesFit) {
+    maxSamples = samplesFit;
+  }
+
+  const bool lineProtocol = format == P146_HTTP_FORMAT_LINE_PROTOCOL;
+  String     body;
+
+  if (!body.reserve((maxSamples * P146_HTTP_SAMPLE_SIZE_ESTIMATE) + P146_HTTP_BODY_OVERHEAD_ESTIMATE)) {
+    return 0;
+  }
+
+  if (!lineProtocol) {
+    // Start position is included so the receiving end can detect duplicates.
+    body += strformat(
+      F("{\"unit\":%d,\"fileNr\":%d,\"filePos\":%d,\"samples\":["),
+      Settings.Unit,
+      peekFileNr,
+      peekReadPos);
+  }
+
+  uint32_t nrSamples = 0;
+  uint32_t nrRead    = 0;
+  std::bitset<TASKS_MAX> tasks;
+
+  while (nrRead < maxSamples) {
+    int sampleFileNr        = 0;
+    const int sampleReadPos = ControllerCache.getPeekFilePos(sampleFileNr);
+    C016_binary_element element;
+
+    if (!C016_getTaskSample(element)) {
+      break;
+    }
+    ++nrRead;
+
+    if ((nrRead % 64) == 0) {
+      // Decoding compressed files may take a while
+      delay(0);
+    }
+
+    if (validTaskIndex(element.TaskIndex)) {
+      String sample;
+
+      if (lineProtocol) {
+        appendLineProtocolSample(sample, element);
+      } else {
+        if (nrSamples != 0) {
+          sample += ',';
+        }
+        appendJsonSample(sample, element);
+      }
+
+      if (!body.concat(sample)) {
+        // Out of memory, this sample will be sent with the next request.
+        ControllerCache.setPeekFilePos(sampleFileNr, sampleReadPos);
+        --nrRead;
+        break;
+      }
+
+      if (!lineProtocol) {
+        tasks.set(element.TaskIndex);
+      }
+      ++nrSamples;
+    }
+  }
+
+  if (nrSamples == 0) {
+    // Only samples of invalid tasks were read, if any.
+    // Keep the advanced read position, so these are not read again.
+    return nrRead;
+  }
+
+  String header;
+
+  if (lineProtocol) {
+    header = F("Content-Type: text/plain");
+  } else {
+    // Only describe the tasks present in this batch
+    String taskInfo;
+    taskInfo += F("],\"tasks\":{");
+    bool first = true;
+
+    for (taskIndex_t task = 0; validTaskIndex(task); ++task) {
+      if (tasks.test(task)) {
+        if (!first) {
+          taskInfo += ',';
+        }
+        first = false;
+        taskInfo += strformat(F("\"%d\":{\"name\":"), task + 1);
+        taskInfo += wrap_String(getTaskDeviceName(task), '"');
+        taskInfo += F(",\"values\":[");
+
+        for (taskVarIndex_t rel_index = 0; rel_index < VARS_PER_TASK; ++rel_index) {
+          if (rel_index != 0) {
+            taskInfo += ',';
+          }
+          taskInfo += wrap_String(Cache.getTaskDeviceValueName(task, rel_index), '"');
+        }
+        taskInfo += F("]}");
+      }
+    }
+    taskInfo += F("}}");
+
+    if (!body.concat(taskInfo)) {
+      // Incomplete JSON, retry later starting with the same sample
+      ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+      return 0;
+    }
+    header = F("Content-Type: application/json");
+  }
+
+  bool success = false;
+  {
+    MakeControllerSettings(ControllerSettings); //-V522
+
+    if (AllocatedControllerSettings()) {
+      LoadControllerSettings(controller_idx, *ControllerSettings);
+
+      int httpCode = -1;
+      send_via_http(
+        getCPluginID_from_ControllerIndex(controller_idx),
+        *ControllerSettings,
+        controller_idx,
+        parseTemplate(_topics[P146_HttpUriIndex]),
+        F("POST"),
+        header,
+        body,
+        httpCode);
+
+      success = httpCode >= 100 && httpCode < 300;
+    }
+  }
+
+  if (loglevelActiveFor(LOG_LEVEL_INFO)) {
+    addLogMove(LOG_LEVEL_INFO, strformat(
+                 F("CacheReader : HTTP upload %d samples from %d,%d: %s"),
+                 nrSamples,
+                 peekFileNr,
+                 peekReadPos,
+                 success ? "OK" : "failed"));
+  }
+
+  if (!success) {
+    // Retry later starting with the same sample
+    ControllerCache.setPeekFilePos(peekFileNr, peekReadPos);
+    return 0;
+  }
+  return nrRead;
+}
+
+void P146_data_struct::appendJsonSample(String& body, const C016_binary_element& element)
+{
+  // [unixtime,tasknr,val1,...]
+  body += '[';
+  body += static_cast<uint32_t>(element.unixTime);
+  body += ',';
+  body += element.TaskIndex + 1;
+
+  const uint8_t valueCount = std::min(element.valueCount, static_cast<uint8_t>(VARS_PER_TASK));
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    body += ',';
+    const uint8_t nrDecimals = Cache.getTaskDeviceValueDecimals(element.TaskIndex, i);
+
+    if (isFloatOutputDataType(element.sensorType)) {
+      const float value = element.values.getFloat(i);
+
+      if (isnan(value) || isinf(value)) {
+        body += F("null");
+      } else {
+        body += toString(value, nrDecimals);
+      }
+    } else {
+      body += element.values.getAsString(i, element.sensorType, nrDecimals);
+    }
+  }
+  body += ']';
+}
+
+void P146_data_struct::appendLineProtocolSample(String& body, const C016_binary_element& element)
+{
+  // <taskname>,unit=<unit> <valuename>=<value>,... <unixtime>
+  // Spaces, commas and equal signs in names must be escaped with a backslash.
+  String taskName = getTaskDeviceName(element.TaskIndex);
+
+  taskName.replace(F(" "), F("\\ "));
+  taskName.replace(F(","), F("\\,"));
+
+  const uint8_t valueCount = std::min(element.valueCount, static_cast<uint8_t>(VARS_PER_TASK));
+  String fields;
+
+  for (uint8_t i = 0; i < valueCount; ++i) {
+    const uint8_t nrDecimals = Cache.getTaskDeviceValueDecimals(element.TaskIndex, i);
+    String value;
+
+    if (isFloatOutputDataType(element.sensorType)) {
+      const float f = element.values.getFloat(i);
+
+      // Line protocol has no representation for NaN, so leave out the field
+      if (!isnan(f) && !isinf(f)) {
+        value = toString(f, nrDecimals);
+      }
+    } else {
+      value = element.values.getAsString(i, element.sensorType, nrDecimals);
+    }
+
+    if (!value.isEmpty()) {
+      String valueName = Cache.getTaskDeviceValueName(element.TaskIndex, i);
+      valueName.replace(F(" "), F("\\ "));
+      valueName.replace(F(","), F("\\,"));
+      valueName.replace(F("="), F("\\="));
+
+      if (!fields.isEmpty()) {
+        fields += ',';
+      }
+      fields += valueName;
+      fields += '=';
+      fields += value;
+    }
+  }
+
+  if (fields.isEmpty()) {
+    return;
+  }
+  body += taskName;
+  body += F(",unit=");
+  body += Settings.Unit;
+  body += ' ';
+  body += fields;
+  body += ' ';
+  body += static_cast<uint32_t>(element.unixTime);
+  body += '\n';
+}
+
+# endif // if FEATURE_HTTP_CLIENT
+
+void P146_data_struct::storeReadPosition(struct EventStruct *event)
+{
+  int readFileNr    = 0;
+  const int readPos = ControllerCache.getPeekFilePos(readFileNr);
+
+  if (P146_GET_ERASE_BINFILES) {
+    // Check whether we must delete the oldest file
+    const int filenr = P146_TASKVALUE_FILENR;
+
+    if ((filenr != 0) && (filenr  < readFileNr)) {
+      ControllerCache.deleteCacheBlock(filenr);
+    }
+  }
+
+  P146_SET_TASKVALUE_FILENR(readFileNr);
+  P146_SET_TASKVALUE_FILEPOS(readPos);
+}
+
 bool P146_data_struct::setPeekFilePos(int peekFileNr, int peekReadPos)
 {
   {
@@ -5,13 +5,15 @@
 #ifdef USES_P146
 
 
+# include "../ControllerQueue/C016_queue_element.h"
 # include "../DataStructs/ESPEasyControllerCache_CSV_dumper.h"
 # include <list>
 
-# define P146_Nlines                            2
+# define P146_Nlines                            3
 # define P146_Nchars                            128
 # define P146_TaskInfoTopicIndex                0
 # define P146_PublishTopicIndex                 1
+# define P146_HttpUriIndex                      2
 
 
 # define P146_TASKVALUE_FILENR  UserVar.getFloat(event->TaskIndex, 0)
@@ -41,13 +43,40 @@
 # define P146_GET_ERASE_BINFILES    bitRead(PCONFIG(0), 6)
 # define P146_SET_ERASE_BINFILES(X) bitWrite(PCONFIG(0), 6, X)
 
+# define P146_GET_SEND_HTTP         bitRead(PCONFIG(0), 7)
+# define P146_SET_SEND_HTTP(X)      bitWrite(PCONFIG(0), 7, X)
+
 
 # define P146_SEPARATOR_CHARACTER   PCONFIG(1)
+# define P146_HTTP_FORMAT           PCONFIG(2)
 
 
 # define P146_MINIMAL_SEND_INTERVAL             PCONFIG_LONG(0)
 # define P146_MQTT_MESSAGE_LENGTH               PCONFIG_LONG(1)
 # define P146_MQTT_SEND_TASKVALUENAMES_INTERVAL PCONFIG_LONG(2)
+# define P146_HTTP_MAX_SAMPLES                  PCONFIG_LONG(3)
+
+// Body formats used to upload samples in bulk via a HTTP controller
+# define P146_HTTP_FORMAT_JSON                  0
+# define P146_HTTP_FORMAT_LINE_PROTOCOL         1
+
+// Delay before retrying a failed HTTP bulk upload
+# define P146_HTTP_RETRY_INTERVAL               10000
+
+// Estimated size of a single sample in the HTTP request body, used to reserve the body up front
+# define P146_HTTP_SAMPLE_SIZE_ESTIMATE         80
+
+// Estimated size of the JSON header and task info in the HTTP request body
+# define P146_HTTP_BODY_OVERHEAD_ESTIMATE       512
+
+// Free memory to keep available for the HTTP client when sending the request
+# define P146_HTTP_HEAP_MARGIN                  6144
+
+# ifdef ESP8266
+#  define P146_HTTP_DEFAULT_MAX_SAMPLES         50
+# else // ifdef ESP8266
+#  define P146_HTTP_DEFAULT_MAX_SAMPLES         500
+# endif // ifdef ESP8266
 
 
 struct P146_data_struct : public PluginTaskData_base {
@@ -75,6 +104,24 @@ public:
   static bool sendViaOriginalTask(taskIndex_t P146_TaskIndex,
                                   bool        sendTimestamp);
 
+# if FEATURE_HTTP_CLIENT
+
+  // Send up to maxSamples samples in a single POST request to the first enabled
+  // HTTP controller linked to this task.
+  // The read position is restored when the upload fails, so it will be retried later.
+  // Samples of an invalid task are skipped, but do count towards maxSamples.
+  // @retval Nr. of samples read from the cache, including skipped samples. 0 when nothing was read or the upload failed.
+  uint32_t sendHttpInBulk(taskIndex_t P146_TaskIndex,
+                          uint32_t    maxSamples,
+                          uint8_t     format) const;
+
+  static controllerIndex_t getHttpControllerIndex(taskIndex_t P146_TaskIndex);
+# endif // if FEATURE_HTTP_CLIENT
+
+  // Store the current read position in the task values and delete
+  // the previous cache file when it has been sent completely.
+  static void storeReadPosition(struct EventStruct *event);
+
   static bool setPeekFilePos(int peekFileNr,
                              int peekReadPos);
 
@@ -89,6 +136,14 @@ private:
   String getTopic(int         index,
                   taskIndex_t P146_TaskIndex) const;
 
+# if FEATURE_HTTP_CLIENT
+  static void appendJsonSample(String                   & body,
+                               const C016_binary_element& element);
+
+  static void appendLineProtocolSample(String                   & body,
+                                       const C016_binary_element& element);
+# endif // if FEATURE_HTTP_CLIENT
+
   String _topics[P146_Nlines];
 
   ESPEasyControllerCache_CSV_dumper *dumper = nullptr;
@@ -167,6 +167,7 @@ void handle_advanced() {
 #if FEATURE_TARSTREAM_SUPPORT
     Settings.DisableSaveConfigAsTar(isFormItemChecked(LabelType::DISABLE_SAVE_CONFIG_AS_TAR));
 #endif // if FEATURE_TARSTREAM_SUPPORT
+    Settings.LazyTaskInit(isFormItemChecked(LabelType::LAZY_TASK_INIT));
 
     addHtmlError(SaveSettings());
 
@@ -351,6 +352,8 @@ void handle_advanced() {
   #if FEATURE_TARSTREAM_SUPPORT
   addFormCheckBox(LabelType::DISABLE_SAVE_CONFIG_AS_TAR, Settings.DisableSaveConfigAsTar());
   #endif // if FEATURE_TARSTREAM_SUPPORT
+  addFormCheckBox(LabelType::LAZY_TASK_INIT, Settings.LazyTaskInit());
+  addFormNote(F("Initialize periodically read tasks after boot. Requires reboot to activate"));
 
   #ifdef ESP8266
   addFormCheckBox(LabelType::DEEP_SLEEP_ALTERNATIVE_CALL, Settings.UseAlternativeDeepSleep());
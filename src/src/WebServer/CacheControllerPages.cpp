@@ -18,6 +18,7 @@
 # include "../Helpers/ESPEasy_Storage.h"
 # include "../Helpers/ESPEasy_time_calc.h"
 # include "../Helpers/Misc.h"
+# include "../Helpers/Numerical.h"
 
 
 // ********************************************************************************
@@ -53,6 +54,28 @@ void handle_dumpcache() {
     onlySetTasks = true;
   }
 
+  // Optional filter on time range (UNIX timestamp, inclusive) and task number.
+  const bool  useFilter  = hasArg(F("from")) || hasArg(F("to")) || hasArg(F("task"));
+  uint32_t    filterFrom = 0;
+  uint32_t    filterTo   = 0xFFFFFFFF;
+  taskIndex_t filterTask = INVALID_TASK_INDEX;
+
+  if (useFilter) {
+    uint32_t value = 0;
+
+    if (validUIntFromString(webArg(F("from")), value)) {
+      filterFrom = value;
+    }
+
+    if (validUIntFromString(webArg(F("to")), value)) {
+      filterTo = value;
+    }
+
+    if (validUIntFromString(webArg(F("task")), value) && (value > 0) && validTaskIndex(value - 1)) {
+      filterTask = value - 1;
+    }
+  }
+
   {
     // Send HTTP headers to directly save the dump as a CSV file
     String str =  F("attachment; filename=cachedump_");
@@ -78,6 +101,10 @@ void handle_dumpcache() {
     separator, 
     ESPEasyControllerCache_CSV_dumper::Target::CSV_file);
 
+  if (useFilter) {
+    dumper.setFilter(filterFrom, filterTo, filterTask);
+  }
+
   dumper.generateCSVHeader(true);
 
   while (dumper.createCSVLine()) {
@@ -152,7 +179,8 @@ void handle_cache_json() {
 }
 
 void handle_cache_csv() {
-  if (!isLoggedIn()) { return; }
+  // Same export as /dumpcache, typically used with the from, to and task arguments.
+  handle_dumpcache();
 }
 
 #endif // ifdef USES_C016
@@ -9,6 +9,8 @@
 // URLs needed for C016_CacheController
 // to help dump the content of the binary log files
 // ********************************************************************************
+// Optional arguments from and to (UNIX timestamp) and task (task nr)
+// to only export a part of the cache.
 void handle_dumpcache();
 
 void handle_cache_json();
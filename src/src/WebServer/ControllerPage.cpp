@@ -435,6 +435,10 @@ void handle_controllers_ControllerSettingsPage(controllerIndex_t controllerindex
             addHtml(getMQTTclientID(*ControllerSettings));
             addFormNote(F("Updated on load of this page"));
             addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_RETAINFLAG);
+
+            if (proto.allowsBatchJSON) {
+              addControllerParameterForm(*ControllerSettings, controllerindex, ControllerSettingsStruct::CONTROLLER_MQTT_BATCH_JSON);
+            }
           }
           # endif // if FEATURE_MQTT
 
@@ -12,6 +12,7 @@
 #include "../WebServer/CustomPage.h"
 #include "../WebServer/DevicesPage.h"
 #include "../WebServer/DownloadPage.h"
+#include "../WebServer/EventStream.h"
 #include "../WebServer/FactoryResetPage.h"
 #include "../WebServer/FileList.h"
 #include "../WebServer/HTML_wrappers.h"
@@ -293,6 +294,9 @@ void WebServerInit()
 #ifdef WEBSERVER_METRICS
   web_server.on(F("/metrics"),     handle_metrics);
 #endif // ifdef WEBSERVER_METRICS
+#ifdef WEBSERVER_EVENTS
+  web_server.on(F("/events"),      handle_events);
+#endif // ifdef WEBSERVER_EVENTS
 #ifdef WEBSERVER_SYSVARS
   web_server.on(F("/sysvars"),     handle_sysvars);
 #endif // WEBSERVER_SYSVARS
@@ -0,0 +1,198 @@
+#include "../WebServer/EventStream.h"
+
+#ifdef WEBSERVER_EVENTS
+
+# include "../WebServer/ESPEasy_WebServer.h"
+
+# include "../Globals/Cache.h"
+# include "../Globals/Plugins.h"
+# include "../Globals/Settings.h"
+
+# include "../Helpers/ESPEasy_time_calc.h"
+# include "../Helpers/StringConverter.h"
+
+# include "../../_Plugin_Helper.h"
+
+# include <bitset>
+# include <list>
+
+# ifdef ESP32
+#  include <lwip/sockets.h>
+# endif // ifdef ESP32
+
+struct EventStreamClient {
+  WiFiClient             client;
+  std::bitset<TASKS_MAX> pendingTasks;
+  taskIndex_t            taskFilter = INVALID_TASK_INDEX;
+  uint32_t               lastSend   = 0;
+};
+
+static std::list<EventStreamClient> eventStreamClients;
+
+
+// ********************************************************************************
+// Append a single Server-Sent Event with the current values of a task
+// ********************************************************************************
+static void append_task_values_event(String& message, taskIndex_t TaskIndex)
+{
+  const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(TaskIndex);
+
+  if (!validDeviceIndex(DeviceIndex) || !Settings.TaskDeviceEnabled[TaskIndex]) {
+    return;
+  }
+  const uint8_t valueCount = getValueCountForTask(TaskIndex);
+
+  if (valueCount == 0) {
+    return;
+  }
+  struct EventStruct TempEvent(TaskIndex);
+
+  message += F("event: taskvalues\ndata: {");
+  message += to_json_object_value(F("TaskNumber"), TaskIndex + 1);
+  message += ',';
+  message += to_json_object_value(F("TaskName"), getTaskDeviceName(TaskIndex), true);
+  message += F(",\"Values\":{");
+
+  for (uint8_t x = 0; x < valueCount; x++) {
+    if (x != 0) {
+      message += ',';
+    }
+    message += to_json_object_value(
+      Cache.getTaskDeviceValueName(TaskIndex, x),
+      formatUserVarNoCheck(&TempEvent, x));
+  }
+  message += F("}}\n\n");
+}
+
+// Write without blocking.
+// Return false when the client cannot accept all data at once.
+static bool write_event_stream(WiFiClient& client, const char *data, size_t length)
+{
+  # ifdef ESP32
+
+  // WiFiClient::write() waits until all data is sent and availableForWrite() is not implemented,
+  // so write to the socket directly without waiting.
+  const int fd = client.fd();
+
+  if (fd < 0) {
+    return false;
+  }
+  const ssize_t res = send(fd, data, length, MSG_DONTWAIT);
+  return (res >= 0) && (static_cast<size_t>(res) == length);
+  # else // ifdef ESP32
+  return client.write(data, length) == length;
+  # endif // ifdef ESP32
+}
+
+// Return false when the client should be disconnected.
+static bool send_pending_task_values(EventStreamClient& streamClient)
+{
+  String message;
+
+  for (taskIndex_t TaskIndex = 0; validTaskIndex(TaskIndex); ++TaskIndex) {
+    if (streamClient.pendingTasks.test(TaskIndex) &&
+        (!validTaskIndex(streamClient.taskFilter) || (streamClient.taskFilter == TaskIndex))) {
+      append_task_values_event(message, TaskIndex);
+    }
+  }
+
+  if (!message.isEmpty()) {
+    # ifdef ESP8266
+
+    if (static_cast<size_t>(streamClient.client.availableForWrite()) < message.length()) {
+      // Client cannot keep up, try again later with the values present at that moment.
+      return true;
+    }
+    # endif // ifdef ESP8266
+
+    // On ESP32 a client with a full send buffer is dropped, it will reconnect.
+    if (!write_event_stream(streamClient.client, message.c_str(), message.length())) {
+      return false;
+    }
+    streamClient.lastSend = millis();
+  }
+  streamClient.pendingTasks.reset();
+  return true;
+}
+
+// ********************************************************************************
+// Web Interface Server-Sent Events stream of task values
+// ********************************************************************************
+void handle_events()
+{
+  if (eventStreamClients.size() >= EVENT_STREAM_MAX_CLIENTS) {
+    web_server.send(503, F("text/plain"), String(F("Max. number of event stream clients reached")));
+    return;
+  }
+
+  // Headers are written directly, as the web server would use chunked encoding
+  // and close the connection after the handler has returned.
+  WiFiClient& client = web_server.client();
+
+  # ifdef ESP32
+  client.setSSE(true);
+  # endif // ifdef ESP32
+  client.setNoDelay(true);
+  client.print(F("HTTP/1.1 200 OK\r\n"
+                 "Content-Type: text/event-stream\r\n"
+                 "Cache-Control: no-cache\r\n"
+                 "Connection: close\r\n"
+                 "Access-Control-Allow-Origin: *\r\n"
+                 "\r\n"
+                 "retry: 2000\n\n"));
+
+  EventStreamClient streamClient;
+
+  // Keep a copy of the client, so the connection stays open after the request has been handled.
+  streamClient.client = client;
+
+  const int taskNr = getFormItemInt(F("tasknr"), 0);
+
+  if (validTaskIndex(taskNr - 1)) {
+    streamClient.taskFilter = taskNr - 1;
+  }
+
+  // Start with the current values of all tasks
+  streamClient.pendingTasks.set();
+  streamClient.lastSend = millis();
+
+  eventStreamClients.push_back(std::move(streamClient));
+}
+
+void events_task_values_updated(taskIndex_t TaskIndex)
+{
+  if (!validTaskIndex(TaskIndex)) {
+    return;
+  }
+
+  for (auto it = eventStreamClients.begin(); it != eventStreamClients.end(); ++it) {
+    it->pendingTasks.set(TaskIndex);
+  }
+}
+
+void process_event_stream_clients()
+{
+  auto it = eventStreamClients.begin();
+
+  while (it != eventStreamClients.end()) {
+    bool keep = it->client.connected();
+
+    if (keep && (timePassedSince(it->lastSend) >= EVENT_STREAM_MIN_INTERVAL)) {
+      if (it->pendingTasks.any()) {
+        keep = send_pending_task_values(*it);
+      } else if (timePassedSince(it->lastSend) >= EVENT_STREAM_KEEPALIVE_INTERVAL) {
+        keep         = write_event_stream(it->client, ":\n\n", 3);
+        it->lastSend = millis();
+      }
+    }
+
+    if (keep) {
+      ++it;
+    } else {
+      it->client.stop();
+      it = eventStreamClients.erase(it);
+    }
+  }
+}
+
+#endif // ifdef WEBSERVER_EVENTS
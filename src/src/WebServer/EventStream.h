@@ -0,0 +1,44 @@
+#ifndef WEBSERVER_WEBSERVER_EVENTSTREAM_H
+#define WEBSERVER_WEBSERVER_EVENTSTREAM_H
+
+#include "../WebServer/common.h"
+
+#ifdef WEBSERVER_EVENTS
+
+# include "../DataTypes/TaskIndex.h"
+
+// Max. number of simultaneous clients connected to /events
+# ifndef EVENT_STREAM_MAX_CLIENTS
+#  ifdef ESP32
+#   define EVENT_STREAM_MAX_CLIENTS  4
+#  else // ifdef ESP32
+#   define EVENT_STREAM_MAX_CLIENTS  2
+#  endif // ifdef ESP32
+# endif // ifndef EVENT_STREAM_MAX_CLIENTS
+
+// Min. time in msec between updates sent to a client.
+// Updates of the same task within this interval are merged.
+# ifndef EVENT_STREAM_MIN_INTERVAL
+#  define EVENT_STREAM_MIN_INTERVAL  100
+# endif // ifndef EVENT_STREAM_MIN_INTERVAL
+
+// Send a comment line when nothing was sent for this long, to detect disconnected clients.
+# ifndef EVENT_STREAM_KEEPALIVE_INTERVAL
+#  define EVENT_STREAM_KEEPALIVE_INTERVAL  15000
+# endif // ifndef EVENT_STREAM_KEEPALIVE_INTERVAL
+
+// ********************************************************************************
+// Web Interface Server-Sent Events stream of task values (no password!)
+// Optional argument tasknr to only receive updates of a single task.
+// ********************************************************************************
+void handle_events();
+
+// Called when new task values have been published.
+void events_task_values_updated(taskIndex_t TaskIndex);
+
+// Send pending updates to connected clients and remove disconnected clients.
+void process_event_stream_clients();
+
+#endif // ifdef WEBSERVER_EVENTS
+
+#endif // ifndef WEBSERVER_WEBSERVER_EVENTSTREAM_H
@@ -397,36 +397,45 @@ void addHtml(String&& html) {
   TXBuffer += html;
 }
 
+void addHtml(const char *buffer, size_t length) {
+  TXBuffer.addBuffer(buffer, length);
+}
+
 void addHtmlInt(int8_t int_val) {
-  addHtml(String(int_val));
+  addHtmlInt(static_cast<int32_t>(int_val));
 }
 
 void addHtmlInt(uint8_t int_val) {
-  addHtml(String(int_val));
+  addHtmlInt(static_cast<uint32_t>(int_val));
 }
 
 void addHtmlInt(int16_t int_val) {
-  addHtml(String(int_val));
+  addHtmlInt(static_cast<int32_t>(int_val));
 }
 
 #if ESP_IDF_VERSION_MAJOR >= 5
 #ifndef __riscv
 void addHtmlInt(int int_val) {
-  addHtml(String(int_val));
+  addHtmlInt(static_cast<int32_t>(int_val));
 }
 
 void addHtmlInt(unsigned int int_val) {
-  addHtml(String(int_val));
+  addHtmlInt(static_cast<uint32_t>(int_val));
 }
 #endif
 #endif
 
+// Format on the stack, to not allocate a String per number
 void addHtmlInt(int32_t int_val) {
-  addHtml(String(int_val));
+  char buf[12];
+  ltoa(int_val, buf, 10);
+  addHtml(buf, strlen(buf));
 }
 
 void addHtmlInt(uint32_t int_val) {
-  addHtml(String(int_val));
+  char buf[11];
+  ultoa(int_val, buf, 10);
+  addHtml(buf, strlen(buf));
 }
 
 void addHtmlInt(int64_t int_val) {
@@ -122,6 +122,7 @@ void addHtml(const char& char1, const char& char2);
 void addHtml(const __FlashStringHelper * html);
 void addHtml(const String& html);
 void addHtml(String&& html);
+void addHtml(const char *buffer, size_t length);
 void addHtmlInt(int8_t int_val);
 void addHtmlInt(int16_t int_val);
 void addHtmlInt(uint8_t int_val);
@@ -13,8 +13,10 @@
 #include "../Globals/Device.h"
 #include "../Globals/Plugins.h"
 #include "../Globals/NPlugins.h"
+#include "../Globals/RuntimeData.h"
 
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/CRC_functions.h"
 #include "../Helpers/ESPEasyStatistics.h"
 #include "../Helpers/ESPEasy_Storage.h"
 #include "../Helpers/Numerical.h"
@@ -29,12 +31,72 @@ void stream_comma_newline() {
   addHtml(',', '\n');
 }
 
+// ********************************************************************************
+// ETag for replies which only show task values
+// Computed over the task values and the task settings shown with them.
+// ********************************************************************************
+uint32_t compute_task_values_ETag(taskIndex_t firstTaskIndex, taskIndex_t lastTaskIndex)
+{
+  struct {
+    uint32_t          crc;
+    uint32_t          taskCacheVersion;
+    TaskValues_Data_t values;
+    unsigned long     taskInterval;
+    uint8_t           pluginID;
+    bool              enabled;
+  } taskState;
+
+  uint32_t crc = 0;
+
+  for (taskIndex_t TaskIndex = firstTaskIndex; TaskIndex <= lastTaskIndex && validTaskIndex(TaskIndex); ++TaskIndex) {
+    // Clear padding bytes, as these are included in the checksum
+    memset(&taskState, 0, sizeof(taskState));
+    taskState.crc              = crc;
+    taskState.taskCacheVersion = Cache.taskCacheVersion;
+
+    const TaskValues_Data_t *values = UserVar.getRawTaskValues_Data(TaskIndex);
+
+    if (values != nullptr) {
+      memcpy(&taskState.values, values, sizeof(TaskValues_Data_t));
+    }
+    taskState.taskInterval = Settings.TaskDeviceTimer[TaskIndex];
+    taskState.pluginID     = Settings.getPluginID_for_task(TaskIndex).value;
+    taskState.enabled      = Settings.TaskDeviceEnabled[TaskIndex];
+
+    crc = calc_CRC32(reinterpret_cast<const uint8_t *>(&taskState), sizeof(taskState));
+  }
+  return crc;
+}
+
+// Send the ETag header, or reply with 304 Not Modified when the client already has this version.
+// Return true when the reply has been sent.
+bool reply_304_task_values(uint32_t etag_num)
+{
+  const String etag = strformat(F("\"%x\""), etag_num);
+
+  sendHeader(F("ETag"), etag);
+
+  if (!etag.equals(web_server.header(F("If-None-Match")))) {
+    return false;
+  }
+  sendHeader(F("Access-Control-Allow-Origin"), F("*"));
+  web_server.send(304, F("application/json"), EMPTY_STRING);
+  return true;
+}
+
 
 // ********************************************************************************
 // Web Interface get CSV value from task
 // ********************************************************************************
 void handle_csvval()
 {
+  const taskIndex_t taskNr    = getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
+  const bool taskValid = validTaskIndex(taskNr);
+
+  if (taskValid && reply_304_task_values(compute_task_values_ETag(taskNr, taskNr))) {
+    return;
+  }
+
   TXBuffer.startJsonStream();
   const int printHeader = getFormItemInt(F("header"), 1);
   bool printHeaderValid = true;
@@ -44,8 +106,6 @@ void handle_csvval()
     printHeaderValid = false;
   }
 
-  const taskIndex_t taskNr    = getFormItemInt(F("tasknr"), INVALID_TASK_INDEX);
-  const bool taskValid = validTaskIndex(taskNr);
   if (!taskValid)
   {
     addHtml(F("ERROR: TaskNr not valid!\n"));
@@ -141,6 +201,21 @@ void handle_json()
     #if FEATURE_PLUGIN_STATS
     showPluginStats     = hasArg(F("showpluginstats"));
     #endif
+
+    // Only task values are shown, so pollers can be answered with 304 Not Modified
+    // when no task value has changed.
+    #if FEATURE_PLUGIN_STATS
+    if (!showPluginStats)
+    #endif
+    {
+      const taskIndex_t firstTask = showSpecificTask ? taskNr - 1 : 0;
+      const taskIndex_t lastTask  = showSpecificTask ? taskNr - 1 : TASKS_MAX - 1;
+
+      if (reply_304_task_values(compute_task_values_ETag(firstTask, lastTask))) {
+        STOP_TIMER(HANDLE_SERVING_WEBPAGE_JSON);
+        return;
+      }
+    }
   }
 
   TXBuffer.startJsonStream();
@@ -375,6 +450,16 @@ void handle_json()
               stream_next_json_object_value(F("webport"), it->second.webgui_portnumber);
             }
           }
+          {
+            P2P_Node_statistics_t *p2pStats = Nodes.getP2P_statistics(it->first);
+
+            if (p2pStats != nullptr) {
+              stream_next_json_object_value(F("p2p_sent"),          p2pStats->sentMessages);
+              stream_next_json_object_value(F("p2p_received"),      p2pStats->receivedMessages);
+              stream_next_json_object_value(F("p2p_sent_rate"),     toString(p2pStats->getSentPerMinute(), 1));
+              stream_next_json_object_value(F("p2p_received_rate"), toString(p2pStats->getReceivedPerMinute(), 1));
+            }
+          }
           stream_next_json_object_value(F("ip"), formatIP(it->second.IP()));
 #if FEATURE_USE_IPV6
           if (it->second.hasIPv6_mac_based_link_local) {
@@ -69,6 +69,7 @@ void handle_log_JSON() {
   addHtml(F("\"Entries\": ["));
   bool logLinesAvailable       = true;
   int  nrEntries               = 0;
+  long nrBytes                 = 0;
   unsigned long firstTimeStamp = 0;
   unsigned long lastTimeStamp  = 0;
 
@@ -76,6 +77,9 @@ void handle_log_JSON() {
     String message;
     uint8_t loglevel;
     if (Logging.getNext(logLinesAvailable, lastTimeStamp, message, loglevel)) {
+      if (nrEntries != 0) {
+        nrBytes += LogStruct::entrySize(message.length());
+      }
       addHtml('{');
       stream_next_json_object_value(F("timestamp"), lastTimeStamp);
       stream_next_json_object_value(F("text"),  std::move(message));
@@ -96,11 +100,11 @@ void handle_log_JSON() {
   long refreshSuggestion = 1000;
   long newOptimum        = 1000;
 
-  if ((nrEntries > 2) && (logTimeSpan > 1)) {
+  if ((nrEntries > 2) && (logTimeSpan > 1) && (nrBytes > 0)) {
     // May need to lower the TTL for refresh when time needed
-    // to fill half the log is lower than current TTL
-    newOptimum = logTimeSpan * (LOG_STRUCT_MESSAGE_LINES / 2);
-    newOptimum = newOptimum / (nrEntries - 1);
+    // to fill half the log buffer is lower than current TTL
+    newOptimum = logTimeSpan * (LOG_STRUCT_BUFFER_SIZE / 2);
+    newOptimum = newOptimum / nrBytes;
   }
 
   if (newOptimum < refreshSuggestion) { refreshSuggestion = newOptimum; }
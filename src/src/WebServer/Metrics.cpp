@@ -2,10 +2,21 @@
 #include "../WebServer/ESPEasy_WebServer.h"
 #include "../../ESPEasy-Globals.h"
 #include "../Commands/Diagnostic.h"
+#include "../ControllerQueue/DelayQueueElements.h"
+#include "../DataStructs/TimingStats.h"
 #include "../ESPEasyCore/ESPEasyNetwork.h"
 #include "../ESPEasyCore/ESPEasyWifi.h"
+#include "../Globals/Cache.h"
+#include "../Globals/CPlugins.h"
+#include "../Globals/ESPEasyEthEvent.h"
+#include "../Globals/ESPEasyWiFiEvent.h"
+#include "../Globals/ESPEasy_Scheduler.h"
+#include "../Globals/NetworkState.h"
+#include "../Globals/RuntimeData.h"
 #include "../../_Plugin_Helper.h"
 #include "../Helpers/ESPEasyStatistics.h"
+#include "../Helpers/Memory.h"
+#include "../Helpers/Misc.h"
 #include "../Static/WebStaticData.h"
 
 #ifdef WEBSERVER_METRICS
@@ -14,80 +25,234 @@
 #  include <esp_partition.h>
 # endif // ifdef ESP32
 
+# include <algorithm>
+# include <cmath>
+
+// ********************************************************************************
+// Prometheus text format, streamed directly into TXBuffer.
+// Numbers are formatted on the stack, so no String is allocated per value.
+// ********************************************************************************
+void stream_metric_header(const __FlashStringHelper *name,
+                          const __FlashStringHelper *help,
+                          const __FlashStringHelper *type)
+{
+  addHtml(F("# HELP espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(help);
+  addHtml(F("\n# TYPE espeasy_"));
+  addHtml(name);
+  addHtml(' ');
+  addHtml(type);
+  addHtml('\n');
+}
+
+void stream_metric_name(const __FlashStringHelper *name)
+{
+  addHtml(F("espeasy_"));
+  addHtml(name);
+}
+
+void stream_metric_label(const __FlashStringHelper *label, const char *value, bool first)
+{
+  addHtml(first ? '{' : ',');
+  addHtml(label);
+  addHtml('=', '"');
+
+  for (; value != nullptr && *value != '\0'; ++value) {
+    const char c = *value;
+
+    switch (c) {
+      case '\\': addHtml('\\', '\\'); break;
+      case '"':  addHtml('\\', '"'); break;
+      case '\n': addHtml('\\', 'n'); break;
+      default:   addHtml(c); break;
+    }
+  }
+  addHtml('"');
+}
+
+void stream_metric_label(const __FlashStringHelper *label, const String& value, bool first)
+{
+  stream_metric_label(label, value.c_str(), first);
+}
+
+void stream_metric_label(const __FlashStringHelper *label, int value, bool first)
+{
+  addHtml(first ? '{' : ',');
+  addHtml(label);
+  addHtml('=', '"');
+  addHtmlInt(value);
+  addHtml('"');
+}
+
+void stream_metric_labels_end()
+{
+  addHtml('}');
+}
+
+void stream_metric_value(int32_t value)
+{
+  addHtml(' ');
+  addHtmlInt(value);
+  addHtml('\n');
+}
+
+void stream_metric_value(uint32_t value)
+{
+  addHtml(' ');
+  addHtmlInt(value);
+  addHtml('\n');
+}
+
+void stream_metric_value(double value, uint8_t nrDecimals)
+{
+  addHtml(' ');
+
+  if (isnan(value)) {
+    addHtml(F("NaN"));
+  } else if (isinf(value)) {
+    addHtml(value > 0 ? F("+Inf") : F("-Inf"));
+  } else {
+    char buf[32];
+    int  length;
+
+    if (std::abs(value) < 1e15) {
+      length = snprintf(buf, sizeof(buf), "%.*f", nrDecimals > 8 ? 8 : nrDecimals, value);
+    } else {
+      length = snprintf(buf, sizeof(buf), "%g", value);
+    }
+
+    if (length > 0) {
+      addHtml(buf, std::min(static_cast<size_t>(length), sizeof(buf) - 1));
+    }
+  }
+  addHtml('\n');
+}
+
+void stream_metric(const __FlashStringHelper *name,
+                   const __FlashStringHelper *help,
+                   const __FlashStringHelper *type,
+                   uint32_t                   value)
+{
+  stream_metric_header(name, help, type);
+  stream_metric_name(name);
+  stream_metric_value(value);
+}
+
 void handle_metrics() {
   TXBuffer.startStream(F("text/plain"), F("*"));
-  const __FlashStringHelper *prefixHELP = F("# HELP espeasy_");
-  const __FlashStringHelper *prefixTYPE = F("# TYPE espeasy_");
 
   // uptime
-  addHtml(prefixHELP);
-  addHtml(F("uptime current device uptime in minutes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("uptime counter\n"));
-  addHtml(F("espeasy_uptime "));
-  addHtml(getValue(LabelType::UPTIME));
-  addHtml('\n');
+  stream_metric(F("uptime"), F("current device uptime in minutes"), F("counter"), static_cast<uint32_t>(getUptimeMinutes()));
 
   // load
-  addHtml(prefixHELP);
-  addHtml(F("load device percentage load\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("load gauge\n"));
-  addHtml(F("espeasy_load "));
-  addHtml(getValue(LabelType::LOAD_PCT));
-  addHtml('\n');
+  stream_metric_header(F("load"), F("device percentage load"), F("gauge"));
+  stream_metric_name(F("load"));
+  stream_metric_value(getCPUload(), 2);
 
-  // Free RAM
-  addHtml(prefixHELP);
-  addHtml(F("free_ram device amount of RAM free in Bytes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("free_ram gauge\n"));
-  addHtml(F("espeasy_free_ram "));
-  addHtml(getValue(LabelType::FREE_MEM));
-  addHtml('\n');
+  stream_metric(F("loop_count"), F("Number of main loop runs per second"), F("gauge"), static_cast<uint32_t>(getLoopCountPerSec()));
+
+  stream_metric_header(F("scheduler_idle"), F("Percentage of time the scheduler was idle"), F("gauge"));
+  stream_metric_name(F("scheduler_idle"));
+  stream_metric_value(Scheduler.getIdleTimePct(), 2);
 
   // Free RAM
-  addHtml(prefixHELP);
-  addHtml(F("free_stack device amount of Stack free in Bytes\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("free_stack gauge\n"));
-  addHtml(F("espeasy_free_stack "));
-  addHtml(getValue(LabelType::FREE_STACK));
-  addHtml('\n');
+  stream_metric(F("free_ram"),       F("device amount of RAM free in Bytes"),   F("gauge"), static_cast<uint32_t>(FreeMem()));
+  stream_metric(F("free_stack"),     F("device amount of Stack free in Bytes"), F("gauge"), getCurrentFreeStack());
+  stream_metric(F("heap_max_block"), F("Largest free block of RAM in Bytes"),   F("gauge"), static_cast<uint32_t>(getMaxFreeBlock()));
+  # if defined(CORE_POST_2_5_0)
+  stream_metric(F("heap_fragmentation"), F("Heap fragmentation in percent"), F("gauge"), static_cast<uint32_t>(ESP.getHeapFragmentation()));
+  # endif // if defined(CORE_POST_2_5_0)
+  # ifdef ESP32
+  stream_metric(F("heap_min_free"), F("Lowest amount of RAM free since boot in Bytes"), F("gauge"), ESP.getMinFreeHeap());
+  # endif // ifdef ESP32
 
   // Wifi strength
-  addHtml(prefixHELP);
-  addHtml(F("wifi_rssi Wifi connection Strength\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_rssi gauge\n"));
-  addHtml(F("espeasy_wifi_rssi "));
-  addHtml(getValue(LabelType::WIFI_RSSI));
-  addHtml('\n');
+  stream_metric_header(F("wifi_rssi"), F("Wifi connection Strength"), F("gauge"));
+  stream_metric_name(F("wifi_rssi"));
+  stream_metric_value(static_cast<int32_t>(WiFi.RSSI()));
 
   // Wifi uptime
-  addHtml(prefixHELP);
-  addHtml(F("wifi_connected Time wifi has been connected in milliseconds\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_connected counter\n"));
-  addHtml(F("espeasy_wifi_connected "));
-  addHtml(getValue(LabelType::CONNECTED_MSEC));
-  addHtml('\n');
+  {
+    // Use only the nr of seconds, like the "Connected msec" label.
+    uint32_t connected_sec = static_cast<uint32_t>(WiFiEventData.lastConnectMoment.millisPassedSince() / 1000ll);
+    # if FEATURE_ETHERNET
+
+    if (active_network_medium == NetworkMedium_t::Ethernet) {
+      connected_sec = static_cast<uint32_t>(EthEventData.lastConnectMoment.millisPassedSince() / 1000ll);
+    }
+    # endif // if FEATURE_ETHERNET
+    stream_metric_header(F("wifi_connected"), F("Time wifi has been connected in milliseconds"), F("counter"));
+    stream_metric_name(F("wifi_connected"));
+    addHtml(' ');
+    addHtmlInt(connected_sec);
+    addHtml(F("000\n"));
+  }
 
   // Wifi reconnects
-  addHtml(prefixHELP);
-  addHtml(F("wifi_reconnects Number of times Wifi has reconnected since boot\n"));
-  addHtml(prefixTYPE);
-  addHtml(F("wifi_reconnects counter\n"));
-  addHtml(F("espeasy_wifi_reconnects "));
-  addHtml(getValue(LabelType::NUMBER_RECONNECTS));
-  addHtml('\n');
+  stream_metric(F("wifi_reconnects"), F("Number of times Wifi has reconnected since boot"), F("counter"),
+                static_cast<uint32_t>(WiFiEventData.wifi_reconnects));
+
+  handle_metrics_controllers();
 
   // devices
   handle_metrics_devices();
+  handle_metrics_task_values();
+
+  # if FEATURE_TIMING_STATS
+  handle_metrics_timing_stats();
+  # endif // if FEATURE_TIMING_STATS
 
   TXBuffer.endStream();
 }
 
+void handle_metrics_controllers() {
+  stream_metric_header(F("controller_queue_depth"), F("Number of messages in the controller queue"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    const ControllerDelayHandlerStruct *handler = getControllerDelayHandler(x);
+
+    if (handler != nullptr) {
+      stream_metric_name(F("controller_queue_depth"));
+      stream_metric_label(F("controller"), x + 1, true);
+      stream_metric_label(F("protocol"),   get_formatted_Controller_number(getCPluginID_from_ControllerIndex(x)), false);
+      stream_metric_labels_end();
+      stream_metric_value(static_cast<uint32_t>(handler->sendQueue.size()));
+    }
+  }
+
+  stream_metric_header(F("controller_queue_bytes"), F("Memory used by the controller queue in Bytes"), F("gauge"));
+
+  for (controllerIndex_t x = 0; validControllerIndex(x); x++) {
+    const ControllerDelayHandlerStruct *handler = getControllerDelayHandler(x);
+
+    if (handler != nullptr) {
+      stream_metric_name(F("controller_queue_bytes"));
+      stream_metric_label(F("controller"), x + 1, true);
+      stream_metric_label(F("protocol"),   get_formatted_Controller_number(getCPluginID_from_ControllerIndex(x)), false);
+      stream_metric_labels_end();
+      stream_metric_value(static_cast<uint32_t>(handler->getQueueMemorySize()));
+    }
+  }
+}
+
+// Return false when the value cannot be represented as a number.
+bool stream_task_value(struct EventStruct& TempEvent, taskVarIndex_t varNr)
+{
+  const Sensor_VType sensorType = TempEvent.getSensorType();
+
+  if (sensorType == Sensor_VType::SENSOR_TYPE_STRING) {
+    return false;
+  }
+  const uint8_t nrDecimals = isFloatOutputDataType(sensorType)
+                               ? Cache.getTaskDeviceValueDecimals(TempEvent.TaskIndex, varNr)
+                               : 0;
+
+  stream_metric_value(static_cast<double>(UserVar.getAsDouble(TempEvent.TaskIndex, varNr, sensorType)), nrDecimals);
+  return true;
+}
+
 void handle_metrics_devices() {
   for (taskIndex_t x = 0; validTaskIndex(x); x++) {
     const deviceIndex_t DeviceIndex = getDeviceIndex_from_TaskIndex(x);
@@ -109,24 +274,17 @@ void handle_metrics_devices() {
         addHtml(F(" gauge\n"));
 
         if (validDeviceIndex(DeviceIndex)) {
-          String customValuesString;
-
-          // const bool customValues = PluginCall(PLUGIN_WEBFORM_SHOW_VALUES, &TempEvent, customValuesString);
-          const bool customValues = 0; // TODO: handle custom values
-
-          if (!customValues) {
-            const uint8_t valueCount = getValueCountForTask(x);
-            struct EventStruct TempEvent(x);
+          const uint8_t valueCount = getValueCountForTask(x);
+          struct EventStruct TempEvent(x);
 
-            for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
-              if (validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
+          for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
+            if (validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
+              if (TempEvent.getSensorType() != Sensor_VType::SENSOR_TYPE_STRING) {
                 addHtml(F("espeasy_device_"));
                 addHtml(deviceName);
-                addHtml(F("{valueName=\""));
-                addHtml(Cache.getTaskDeviceValueName(x, varNr));
-                addHtml(F("\"} "));
-                addHtml(formatUserVarNoCheck(&TempEvent, varNr));
-                addHtml('\n');
+                stream_metric_label(F("valueName"), Cache.getTaskDeviceValueName_cstr(x, varNr), true);
+                stream_metric_labels_end();
+                stream_task_value(TempEvent, varNr);
               }
             }
           }
@@ -136,4 +294,116 @@ void handle_metrics_devices() {
   }
 }
 
+void handle_metrics_task_values() {
+  stream_metric_header(F("task_value"), F("Values of all enabled tasks"), F("gauge"));
+
+  for (taskIndex_t x = 0; validTaskIndex(x); x++) {
+    if (!Settings.TaskDeviceEnabled[x] ||
+        !validDeviceIndex(getDeviceIndex_from_TaskIndex(x)) ||
+        !validPluginID_fullcheck(Settings.getPluginID_for_task(x))) {
+      continue;
+    }
+    struct EventStruct TempEvent(x);
+
+    if (TempEvent.getSensorType() == Sensor_VType::SENSOR_TYPE_STRING) {
+      continue;
+    }
+    const String  taskName   = getTaskDeviceName(x);
+    const String  pluginName = Settings.getPluginID_for_task(x).toDisplayString();
+    const uint8_t valueCount = getValueCountForTask(x);
+
+    for (uint8_t varNr = 0; varNr < valueCount; varNr++) {
+      stream_metric_name(F("task_value"));
+      stream_metric_label(F("tasknr"),   x + 1, true);
+      stream_metric_label(F("task"),     taskName, false);
+      stream_metric_label(F("valuenr"),  varNr + 1, false);
+      stream_metric_label(F("value"),    Cache.getTaskDeviceValueName_cstr(x, varNr), false);
+      stream_metric_label(F("plugin"),   pluginName, false);
+      stream_metric_labels_end();
+      stream_task_value(TempEvent, varNr);
+    }
+  }
+}
+
+# if FEATURE_TIMING_STATS
+
+enum class TimingMetric {
+  Calls,
+  Avg,
+  P50,
+  P95,
+  P99,
+  Max
+};
+
+void stream_timing_metric(const TimingStats& stats, TimingMetric metric)
+{
+  uint64_t minVal, maxVal;
+  const uint32_t count = stats.getMinMax(minVal, maxVal);
+
+  switch (metric) {
+    case TimingMetric::Calls: stream_metric_value(count); break;
+    case TimingMetric::Avg:   stream_metric_value(static_cast<double>(stats.getAvg()), 1); break;
+    case TimingMetric::P50:   stream_metric_value(static_cast<uint32_t>(stats.getPercentile(0.50f))); break;
+    case TimingMetric::P95:   stream_metric_value(static_cast<uint32_t>(stats.getPercentile(0.95f))); break;
+    case TimingMetric::P99:   stream_metric_value(static_cast<uint32_t>(stats.getPercentile(0.99f))); break;
+    case TimingMetric::Max:   stream_metric_value(static_cast<uint32_t>(maxVal)); break;
+  }
+}
+
+void stream_timing_metrics(const __FlashStringHelper *name, TimingMetric metric)
+{
+  for (auto it = pluginStats.begin(); it != pluginStats.end(); ++it) {
+    const deviceIndex_t deviceIndex = deviceIndex_t::toDeviceIndex(it->first >> 8);
+
+    if (!it->second.isEmpty() && validDeviceIndex(deviceIndex)) {
+      stream_metric_name(name);
+      stream_metric_label(F("type"),     F("plugin"), true);
+      stream_metric_label(F("name"),     getPluginID_from_DeviceIndex(deviceIndex).toDisplayString(), false);
+      stream_metric_label(F("function"), getPluginFunctionName(it->first % 256), false);
+      stream_metric_labels_end();
+      stream_timing_metric(it->second, metric);
+    }
+  }
+
+  for (auto it = controllerStats.begin(); it != controllerStats.end(); ++it) {
+    if (!it->second.isEmpty()) {
+      stream_metric_name(name);
+      stream_metric_label(F("type"),     F("controller"), true);
+      stream_metric_label(F("name"),     get_formatted_Controller_number(getCPluginID_from_ProtocolIndex(it->first >> 8)), false);
+      stream_metric_label(F("function"), getCPluginCFunctionName(static_cast<CPlugin::Function>(it->first % 256)), false);
+      stream_metric_labels_end();
+      stream_timing_metric(it->second, metric);
+    }
+  }
+
+  for (auto it = miscStats.begin(); it != miscStats.end(); ++it) {
+    if (!it->second.isEmpty()) {
+      stream_metric_name(name);
+      stream_metric_label(F("type"), F("misc"), true);
+      stream_metric_label(F("name"), getMiscStatsName(it->first), false);
+      stream_metric_labels_end();
+      stream_timing_metric(it->second, metric);
+    }
+  }
+}
+
+void handle_metrics_timing_stats() {
+  // Timing stats are not cleared here, but may be cleared by viewing the timing stats page.
+  stream_metric_header(F("timing_calls"), F("Number of calls since the timing stats were cleared"), F("counter"));
+  stream_timing_metrics(F("timing_calls"), TimingMetric::Calls);
+  stream_metric_header(F("timing_avg_usec"), F("Average duration in usec"), F("gauge"));
+  stream_timing_metrics(F("timing_avg_usec"), TimingMetric::Avg);
+  stream_metric_header(F("timing_p50_usec"), F("Estimated median duration in usec"), F("gauge"));
+  stream_timing_metrics(F("timing_p50_usec"), TimingMetric::P50);
+  stream_metric_header(F("timing_p95_usec"), F("Estimated 95th percentile duration in usec"), F("gauge"));
+  stream_timing_metrics(F("timing_p95_usec"), TimingMetric::P95);
+  stream_metric_header(F("timing_p99_usec"), F("Estimated 99th percentile duration in usec"), F("gauge"));
+  stream_timing_metrics(F("timing_p99_usec"), TimingMetric::P99);
+  stream_metric_header(F("timing_max_usec"), F("Max duration in usec"), F("gauge"));
+  stream_timing_metrics(F("timing_max_usec"), TimingMetric::Max);
+}
+
+# endif // if FEATURE_TIMING_STATS
+
 #endif // WEBSERVER_METRICS
@@ -6,7 +6,13 @@
 #ifdef WEBSERVER_METRICS
 
 void handle_metrics();
+void handle_metrics_controllers();
 void handle_metrics_devices();
+void handle_metrics_task_values();
+
+# if FEATURE_TIMING_STATS
+void handle_metrics_timing_stats();
+# endif // if FEATURE_TIMING_STATS
 
 #endif    // ifdef WEBSERVER_METRICS
 
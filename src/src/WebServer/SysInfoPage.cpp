@@ -81,6 +81,21 @@ void handle_sysinfo_json() {
   json_number(F("cpu_temp"),   toString(getInternalTemperature()));
 #endif
   json_number(F("loop_count"), String(getLoopCountPerSec()));
+  json_number(F("event_queue_peak"),      getValue(LabelType::EVENT_QUEUE_PEAK_SIZE));
+  json_number(F("event_queue_dropped"),   getValue(LabelType::EVENT_QUEUE_DROPPED));
+  json_number(F("event_queue_coalesced"), getValue(LabelType::EVENT_QUEUE_COALESCED));
+#if FEATURE_MQTT
+  json_number(F("mqtt_bytes_published"),        getValue(LabelType::MQTT_BYTES_PUBLISHED));
+  json_number(F("mqtt_batched_messages_saved"), getValue(LabelType::MQTT_BATCHED_MESSAGES_SAVED));
+#endif // if FEATURE_MQTT
+  json_number(F("syslog_queue_dropped"),     getValue(LabelType::SYSLOG_QUEUE_DROPPED));
+  json_number(F("syslog_queue_avg_latency"), getValue(LabelType::SYSLOG_QUEUE_AVG_LATENCY));
+  json_number(F("syslog_queue_max_latency"), getValue(LabelType::SYSLOG_QUEUE_MAX_LATENCY));
+#if FEATURE_SD
+  json_number(F("sd_log_queue_dropped"),     getValue(LabelType::SD_LOG_QUEUE_DROPPED));
+  json_number(F("sd_log_queue_avg_latency"), getValue(LabelType::SD_LOG_QUEUE_AVG_LATENCY));
+  json_number(F("sd_log_queue_max_latency"), getValue(LabelType::SD_LOG_QUEUE_MAX_LATENCY));
+#endif // if FEATURE_SD
   json_close();
 
   int freeMem = ESP.getFreeHeap();
@@ -613,6 +628,14 @@ void handle_sysinfo_SystemStatus() {
 # if FEATURE_SD
     LabelType::SD_LOG_LEVEL,
 # endif // if FEATURE_SD
+    LabelType::SYSLOG_QUEUE_DROPPED,
+    LabelType::SYSLOG_QUEUE_AVG_LATENCY,
+    LabelType::SYSLOG_QUEUE_MAX_LATENCY,
+# if FEATURE_SD
+    LabelType::SD_LOG_QUEUE_DROPPED,
+    LabelType::SD_LOG_QUEUE_AVG_LATENCY,
+    LabelType::SD_LOG_QUEUE_MAX_LATENCY,
+# endif // if FEATURE_SD
 
     LabelType::ENABLE_SERIAL_PORT_CONSOLE,
     LabelType::CONSOLE_SERIAL_PORT,
@@ -620,6 +643,13 @@ void handle_sysinfo_SystemStatus() {
     LabelType::CONSOLE_FALLBACK_TO_SERIAL0,
     LabelType::CONSOLE_FALLBACK_PORT,
 #endif
+    LabelType::EVENT_QUEUE_PEAK_SIZE,
+    LabelType::EVENT_QUEUE_DROPPED,
+    LabelType::EVENT_QUEUE_COALESCED,
+#if FEATURE_MQTT
+    LabelType::MQTT_BYTES_PUBLISHED,
+    LabelType::MQTT_BATCHED_MESSAGES_SAVED,
+#endif // if FEATURE_MQTT
     LabelType::MAX_LABEL
   };
 
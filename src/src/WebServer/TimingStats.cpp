@@ -7,14 +7,18 @@
 #include "../WebServer/Markup.h"
 #include "../WebServer/Markup_Forms.h"
 
+#include "../DataStructs/BootTimeline.h"
 #include "../DataTypes/ESPEasy_plugin_functions.h"
 
+#include "../Globals/Cache.h"
 #include "../Globals/ESPEasy_time.h"
 #include "../Globals/RamTracker.h"
 
 #include "../Globals/Device.h"
+#include "../Globals/Plugins.h"
 
 #include "../Helpers/_Plugin_init.h"
+#include "../Helpers/Misc.h"
 
 
 #define TIMING_STATS_THRESHOLD 100000
@@ -37,6 +41,9 @@ void handle_timingstats() {
       F("duty (%)"),
       F("min (ms)"),
       F("Avg (ms)"),
+      F("p50 (ms)"),
+      F("p95 (ms)"),
+      F("p99 (ms)"),
       F("max (ms)")};
     for (unsigned int i = 0; i < NR_ELEMENTS(headers); ++i) {
       html_table_header(headers[i]);
@@ -57,10 +64,30 @@ void handle_timingstats() {
   addRowLabel(F("Time span"));
   addHtmlFloat(timespan);
   addHtml(F(" sec"));
+
+  if (Settings.UseRules && Settings.EnableRulesCaching()) {
+    RulesEventCache& eventCache = Cache.rulesHelper.getEventCache();
+    addRowLabel(F("Rules Event Cache Hit/Miss"));
+    addHtmlInt(eventCache.getNrHits());
+    addHtml('/');
+    addHtmlInt(eventCache.getNrMisses());
+    addRowLabel(F("Rules Event Cache Avg Candidates"));
+    addHtmlFloat(eventCache.getAvgCandidatesTested(), 2);
+    eventCache.resetStats();
+  }
+  #ifndef LIMIT_BUILD_SIZE
+  addRowLabel(F("Parsed Template Hit/Miss"));
+  addHtmlInt(Cache.parsedTemplates.getNrHits());
+  addHtml('/');
+  addHtmlInt(Cache.parsedTemplates.getNrMisses());
+  Cache.parsedTemplates.resetStats();
+  #endif // ifndef LIMIT_BUILD_SIZE
   addRowLabel(F("*"));
   addHtml(F("Duty cycle based on average < 1 msec is highly unreliable"));
   html_end_table();
 
+  stream_boot_timeline();
+
   sendHeadandTail_stdtemplate(_TAIL);
   TXBuffer.endStream();
 }
@@ -109,6 +136,12 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
   html_TD();
   format_using_threshhold(avg);
   html_TD();
+  format_using_threshhold(stats.getPercentile(0.50f));
+  html_TD();
+  format_using_threshhold(stats.getPercentile(0.95f));
+  html_TD();
+  format_using_threshhold(stats.getPercentile(0.99f));
+  html_TD();
   format_using_threshhold(maxVal);
 }
 
@@ -180,4 +213,67 @@ long stream_timing_statistics(bool clearStats) {
   return timeSinceLastReset;
 }
 
+// ********************************************************************************
+// HTML table formatted boot timeline
+// ********************************************************************************
+void stream_boot_timeline() {
+  html_table_class_multirow();
+  html_TR();
+  {
+    const __FlashStringHelper * headers[] = {
+      F("Boot Phase"),
+      F("Duration (ms)"),
+      F("Finished (ms)")};
+    for (unsigned int i = 0; i < NR_ELEMENTS(headers); ++i) {
+      html_table_header(headers[i]);
+    }
+  }
+
+  for (uint8_t i = 0; i < bootTimeline.getNrPhases(); ++i) {
+    const BootTimeline::Phase& phase = bootTimeline.getPhase(i);
+
+    html_TR_TD();
+    addHtml(phase._name);
+    html_TD();
+    format_using_threshhold(phase._duration_usec);
+    html_TD();
+    addHtmlInt(phase._end_msec);
+  }
+  html_end_table();
+
+  html_table_class_multirow();
+  html_TR();
+  {
+    const __FlashStringHelper * headers[] = {
+      F("Task"),
+      F("Device"),
+      F("Init (ms)"),
+      F("Deferred"),
+      F("Finished (ms)")};
+    for (unsigned int i = 0; i < NR_ELEMENTS(headers); ++i) {
+      html_table_header(headers[i]);
+    }
+  }
+
+  for (taskIndex_t taskIndex = 0; taskIndex < TASKS_MAX; ++taskIndex) {
+    const BootTimeline::TaskInit& taskInit = bootTimeline.getTaskInit(taskIndex);
+
+    if (taskInit._set) {
+      html_TR_TD();
+      addHtmlInt(taskIndex + 1);
+      addHtml(' ');
+      addHtml(getTaskDeviceName(taskIndex));
+      html_TD();
+      addHtml(getPluginNameFromDeviceIndex(getDeviceIndex_from_TaskIndex(taskIndex)));
+      html_TD();
+      format_using_threshhold(taskInit._duration_usec);
+      html_TD();
+      addEnabled(taskInit._deferred);
+      html_TD();
+      addHtmlInt(taskInit._end_msec);
+    }
+  }
+  html_end_table();
+}
+
 #endif // WEBSERVER_TIMINGSTATS
@@ -18,6 +18,11 @@ void stream_html_timing_stats(const TimingStats& stats, long timeSinceLastReset)
 
 long stream_timing_statistics(bool clearStats);
 
+// ********************************************************************************
+// HTML table formatted boot timeline
+// ********************************************************************************
+void stream_boot_timeline();
+
 #endif 
 
 